@@ -125,6 +125,19 @@ void TreeItem::deleteChildren()
     qDeleteAll(copy);
 }
 
+void TreeItem::deleteChildren(int first)
+{
+    if (first < 0 || first >= childItems.size())
+        return;
+
+    QModelIndex index = model_->indexForItem(this, 0);
+    model_->beginRemoveRows(index, first, childItems.size()-1);
+    QVector<TreeItem*> removed = childItems.mid(first);
+    childItems.resize(first);
+    model_->endRemoveRows();
+    qDeleteAll(removed);
+}
+
 void TreeItem::clear()
 {
     if (!childItems.isEmpty() || more_)
@@ -74,6 +74,9 @@ protected: // Interface for derived classes
 
     void deleteChildren();
 
+    /** Removes the children from @p first on in one go and deletes them.  */
+    void deleteChildren(int first);
+
     /** Report change in data of this item.  */
     void reportChange();
     void reportChange(int column);
@@ -209,6 +209,17 @@ void TreeModel::clicked(const QModelIndex &index)
     item->clicked();
 }
 
+void TreeModel::fetchMoreVisible(const QModelIndex &index)
+{
+    if (!index.isValid())
+        return;
+
+    TreeItem* item = itemForIndex(index);
+    TreeItem* parent = item ? item->parent() : nullptr;
+    if (parent && parent->hasMore() && parent->ellipsis_ == item)
+        parent->fetchMoreChildren();
+}
+
 bool TreeModel::setData(const QModelIndex& index, const QVariant& value,
                         int role)
 {
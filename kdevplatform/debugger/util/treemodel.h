@@ -48,6 +48,11 @@ public:
     void collapsed(const QModelIndex &index);
     void clicked(const QModelIndex &index);
 
+    /** Called for items shown by the view. If @p index is the "..."
+        item of a partially fetched parent, the next page of children
+        is requested from it.  */
+    void fetchMoreVisible(const QModelIndex &index);
+
     void setEditable(bool);
     TreeItem* root() const;
 
@@ -26,14 +26,28 @@
 #include <QApplication>
 #include <QDesktopWidget>
 #include <QScreen>
+#include <QScrollBar>
 #include <QSortFilterProxyModel>
+#include <QTimer>
 
 using namespace KDevelop;
 
 AsyncTreeView::AsyncTreeView(TreeModel* model, QSortFilterProxyModel *proxy, QWidget *parent = nullptr)
     : QTreeView(parent)
     , m_proxy(proxy)
+    , m_fetchVisibleTimer(new QTimer(this))
 {
+    // Children of huge containers are fetched page by page while the
+    // user scrolls, coalescing bursts of scroll and insert events.
+    m_fetchVisibleTimer->setSingleShot(true);
+    m_fetchVisibleTimer->setInterval(50);
+    connect(m_fetchVisibleTimer, &QTimer::timeout,
+            this, &AsyncTreeView::fetchVisibleItems);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged,
+            m_fetchVisibleTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(model, &TreeModel::rowsInserted,
+            m_fetchVisibleTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+
     connect (this, &AsyncTreeView::expanded,
              this, &AsyncTreeView::slotExpanded);
     connect (this, &AsyncTreeView::collapsed,
@@ -85,5 +99,19 @@ void AsyncTreeView::resizeColumns()
 void AsyncTreeView::slotExpandedDataReady()
 {
     resizeColumns();
+    m_fetchVisibleTimer->start();
+}
+
+void AsyncTreeView::fetchVisibleItems()
+{
+    if (!isVisible())
+        return;
+
+    const QRect visible = viewport()->rect();
+    for (QModelIndex index = indexAt(visible.topLeft()); index.isValid(); index = indexBelow(index)) {
+        if (visualRect(index).top() > visible.bottom())
+            break;
+        static_cast<TreeModel*>(model())->fetchMoreVisible(m_proxy->mapToSource(index));
+    }
 }
 
@@ -27,6 +27,7 @@
 #include <debugger/debuggerexport.h>
 
 class QSortFilterProxyModel;
+class QTimer;
 namespace KDevelop
 {
 class TreeModel;
@@ -48,9 +49,11 @@ class TreeModel;
         void slotCollapsed(const QModelIndex &index);
         void slotClicked(const QModelIndex &index);
         void slotExpandedDataReady();
+        void fetchVisibleItems();
 
     private:
         QSortFilterProxyModel *m_proxy;
+        QTimer *m_fetchVisibleTimer;
     };
 
 }
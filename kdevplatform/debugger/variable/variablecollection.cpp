@@ -95,6 +95,9 @@ bool Variable::inScope() const
 
 void Variable::setValue(const QString& v)
 {
+    // -var-update reports whole subtrees; don't repaint values that stayed
+    if (itemData[VariableCollection::ValueColumn].toString() == v)
+        return;
     itemData[VariableCollection::ValueColumn] = v;
     reportChange();
 }
@@ -106,6 +109,8 @@ QString Variable::value() const
 
 void Variable::setType(const QString& type)
 {
+    if (itemData[VariableCollection::TypeColumn].toString() == type)
+        return;
     itemData[VariableCollection::TypeColumn] = type;
     reportChange();
 }
@@ -156,6 +161,9 @@ void Variable::die()
 
 void Variable::setChanged(bool c)
 {
+    // resetChanged() walks every fetched child on each step
+    if (m_changed == c)
+        return;
     m_changed=c;
     reportChange();
 }
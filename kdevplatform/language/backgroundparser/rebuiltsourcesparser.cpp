@@ -0,0 +1,227 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License version 2 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "rebuiltsourcesparser.h"
+
+#include <debug.h>
+
+#include <interfaces/icore.h>
+#include <interfaces/ilanguagecontroller.h>
+#include <language/backgroundparser/backgroundparser.h>
+#include <language/duchain/duchain.h>
+#include <language/duchain/duchainlock.h>
+#include <util/path.h>
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QtConcurrentRun>
+
+namespace KDevelop {
+
+namespace {
+
+///Splits a command line of the compilation database, which quotes like a POSIX shell
+QStringList splitCommand(const QString& command)
+{
+    QStringList arguments;
+    QString argument;
+    bool inArgument = false;
+    QChar quote;
+    for (int i = 0; i < command.size(); ++i) {
+        const QChar c = command.at(i);
+        if (c == QLatin1Char('\\') && quote != QLatin1Char('\'') && i + 1 < command.size()) {
+            argument += command.at(++i);
+            inArgument = true;
+        } else if (!quote.isNull()) {
+            if (c == quote) {
+                quote = QChar();
+            } else {
+                argument += c;
+            }
+        } else if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+            quote = c;
+            inArgument = true;
+        } else if (c.isSpace()) {
+            if (inArgument) {
+                arguments.append(argument);
+                argument.clear();
+                inArgument = false;
+            }
+        } else {
+            argument += c;
+            inArgument = true;
+        }
+    }
+    if (inArgument) {
+        arguments.append(argument);
+    }
+    return arguments;
+}
+
+///@return the object file the entry of the compilation database writes, as given in its command
+QString outputOf(const QJsonObject& entry)
+{
+    const QString output = entry.value(QLatin1String("output")).toString();
+    if (!output.isEmpty()) {
+        return output;
+    }
+
+    QStringList arguments;
+    const QJsonArray argumentsArray = entry.value(QLatin1String("arguments")).toArray();
+    if (!argumentsArray.isEmpty()) {
+        arguments.reserve(argumentsArray.size());
+        for (const auto& argument : argumentsArray) {
+            arguments.append(argument.toString());
+        }
+    } else {
+        arguments = splitCommand(entry.value(QLatin1String("command")).toString());
+    }
+
+    for (int i = 0; i < arguments.size(); ++i) {
+        const QString& argument = arguments.at(i);
+        if (argument == QLatin1String("-o") && i + 1 < arguments.size()) {
+            return arguments.at(i + 1);
+        }
+        if (argument.startsWith(QLatin1String("-o"))) {
+            return argument.mid(2);
+        }
+        // cl.exe and clang-cl
+        if (argument.startsWith(QLatin1String("/Fo")) || argument.startsWith(QLatin1String("-Fo"))) {
+            return argument.mid(3);
+        }
+    }
+    return QString();
+}
+
+QString absoluteFilePath(const QString& directory, const QString& filePath)
+{
+    return QDir::cleanPath(QDir(directory).absoluteFilePath(filePath));
+}
+
+QVector<IndexedString> findSources(const QString& buildDirectory, const QSet<QString>& objectFiles)
+{
+    QVector<IndexedString> sources;
+    if (objectFiles.isEmpty()) {
+        return sources;
+    }
+
+    QFile file(QDir(buildDirectory).filePath(QStringLiteral("compile_commands.json")));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCDebug(LANGUAGE) << "no compilation database to find the rebuilt sources in" << buildDirectory;
+        return sources;
+    }
+
+    const QJsonArray entries = QJsonDocument::fromJson(file.readAll()).array();
+    for (const auto& value : entries) {
+        const QJsonObject entry = value.toObject();
+        const QString output = outputOf(entry);
+        if (output.isEmpty()) {
+            continue;
+        }
+
+        const QString directory = entry.value(QLatin1String("directory")).toString();
+        if (objectFiles.contains(absoluteFilePath(directory, output))) {
+            sources.append(IndexedString(absoluteFilePath(directory, entry.value(QLatin1String("file")).toString())));
+        }
+    }
+    return sources;
+}
+
+}
+
+class RebuiltSourcesParserPrivate
+{
+public:
+    QString buildDirectory;
+    QSet<QString> objectFiles;
+};
+
+RebuiltSourcesParser::RebuiltSourcesParser(const Path& buildDirectory)
+    : d_ptr(new RebuiltSourcesParserPrivate)
+{
+    Q_D(RebuiltSourcesParser);
+
+    d->buildDirectory = buildDirectory.toLocalFile();
+}
+
+RebuiltSourcesParser::~RebuiltSourcesParser()
+{
+}
+
+void RebuiltSourcesParser::addObjectFile(const QString& objectFile)
+{
+    Q_D(RebuiltSourcesParser);
+
+    d->objectFiles.insert(absoluteFilePath(d->buildDirectory, objectFile));
+}
+
+bool RebuiltSourcesParser::isEmpty() const
+{
+    Q_D(const RebuiltSourcesParser);
+
+    return d->objectFiles.isEmpty();
+}
+
+QVector<IndexedString> RebuiltSourcesParser::sources() const
+{
+    Q_D(const RebuiltSourcesParser);
+
+    return findSources(d->buildDirectory, d->objectFiles);
+}
+
+QFuture<int> RebuiltSourcesParser::parse() const
+{
+    Q_D(const RebuiltSourcesParser);
+
+    // the compilation database of a large project takes a while to read
+    const QString buildDirectory = d->buildDirectory;
+    const QSet<QString> objectFiles = d->objectFiles;
+    return QtConcurrent::run([buildDirectory, objectFiles]() {
+        if (ICore::self()->shuttingDown()) {
+            return 0;
+        }
+
+        const QVector<IndexedString> rebuiltSources = findSources(buildDirectory, objectFiles);
+
+        QVector<IndexedString> parsedSources;
+        {
+            DUChainReadLocker lock;
+            for (const IndexedString& source : rebuiltSources) {
+                if (!DUChain::self()->allEnvironmentFiles(source).isEmpty()) {
+                    parsedSources.append(source);
+                }
+            }
+        }
+
+        // addDocument() may be called from any thread
+        auto* backgroundParser = ICore::self()->languageController()->backgroundParser();
+        for (const IndexedString& source : qAsConst(parsedSources)) {
+            backgroundParser->addDocument(source, TopDUContext::VisibleDeclarationsAndContexts,
+                                          BackgroundParser::InitialParsePriority);
+        }
+
+        qCDebug(LANGUAGE) << "parsing" << parsedSources.size() << "of" << rebuiltSources.size() << "rebuilt sources";
+        return parsedSources.size();
+    });
+}
+
+}
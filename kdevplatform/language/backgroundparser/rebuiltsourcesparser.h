@@ -0,0 +1,68 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License version 2 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_REBUILTSOURCESPARSER_H
+#define KDEVPLATFORM_REBUILTSOURCESPARSER_H
+
+#include <language/languageexport.h>
+#include <serialization/indexedstring.h>
+
+#include <QFuture>
+#include <QScopedPointer>
+#include <QVector>
+
+namespace KDevelop {
+class Path;
+class RebuiltSourcesParserPrivate;
+
+///Parses the sources again which a build compiled, once it is done.
+///
+///Builders pass the object files they saw being written. Their sources
+///are looked up in the compilation database (compile_commands.json) of
+///the build directory, so nothing has to be scanned. Only sources which
+///were parsed before are scheduled, the background parser then decides
+///by their modification revisions whether they really need an update.
+class KDEVPLATFORMLANGUAGE_EXPORT RebuiltSourcesParser
+{
+public:
+    ///@param buildDirectory the directory of compile_commands.json, relative object files are resolved against it
+    explicit RebuiltSourcesParser(const Path& buildDirectory);
+    ~RebuiltSourcesParser();
+
+    ///Adds an object file which the build wrote
+    void addObjectFile(const QString& objectFile);
+
+    ///@return whether no object file was added
+    bool isEmpty() const;
+
+    ///@return the sources of the added object files, as far as the compilation database knows them
+    ///@note This reads the whole compilation database, so better call it off the main thread
+    QVector<IndexedString> sources() const;
+
+    ///Schedules the sources which are in the duchain already for parsing.
+    ///The compilation database is read on the thread pool, the parser may be destroyed meanwhile.
+    ///@return the number of scheduled sources, once they are scheduled
+    QFuture<int> parse() const;
+
+private:
+    const QScopedPointer<class RebuiltSourcesParserPrivate> d_ptr;
+    Q_DECLARE_PRIVATE(RebuiltSourcesParser)
+};
+}
+
+#endif // KDEVPLATFORM_REBUILTSOURCESPARSER_H
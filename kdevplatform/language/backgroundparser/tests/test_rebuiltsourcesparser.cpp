@@ -0,0 +1,118 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License version 2 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public License
+ * along with this library; see the file COPYING.LIB.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <language/backgroundparser/rebuiltsourcesparser.h>
+
+#include <tests/autotestshell.h>
+#include <tests/testcore.h>
+#include <util/path.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace KDevelop;
+
+class TestRebuiltSourcesParser : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testSources();
+    void testNoDatabase();
+};
+
+void TestRebuiltSourcesParser::initTestCase()
+{
+    AutoTestShell::init();
+    TestCore::initialize(Core::NoUi);
+}
+
+void TestRebuiltSourcesParser::cleanupTestCase()
+{
+    TestCore::shutdown();
+}
+
+void TestRebuiltSourcesParser::testSources()
+{
+    QTemporaryDir buildDir;
+    QVERIFY(buildDir.isValid());
+
+    // entries as written by CMake for ninja and for makefiles, where the directory is the one of the target
+    QFile database(buildDir.filePath(QStringLiteral("compile_commands.json")));
+    QVERIFY(database.open(QIODevice::WriteOnly));
+    database.write(QStringLiteral(R"([
+{
+  "directory": "%1",
+  "command": "/usr/bin/c++ -DFOO -o CMakeFiles/app.dir/main.cpp.o -c /src/main.cpp",
+  "file": "/src/main.cpp"
+},
+{
+  "directory": "%1/lib",
+  "arguments": ["/usr/bin/c++", "-I\"/src/with space\"", "-oCMakeFiles/lib.dir/lib.cpp.o", "-c", "/src/lib/lib.cpp"],
+  "file": "/src/lib/lib.cpp"
+},
+{
+  "directory": "%1",
+  "command": "/usr/bin/c++ -o \"CMakeFiles/app.dir/other file.cpp.o\" -c \"/src/other file.cpp\"",
+  "file": "/src/other file.cpp"
+},
+{
+  "directory": "%1",
+  "command": "/usr/bin/c++ -o CMakeFiles/app.dir/unchanged.cpp.o -c unchanged.cpp",
+  "file": "unchanged.cpp"
+}
+])").arg(buildDir.path()).toUtf8());
+    database.close();
+
+    RebuiltSourcesParser parser(Path(buildDir.path()));
+    QVERIFY(parser.isEmpty());
+    QVERIFY(parser.sources().isEmpty());
+
+    parser.addObjectFile(QStringLiteral("CMakeFiles/app.dir/main.cpp.o"));
+    parser.addObjectFile(buildDir.filePath(QStringLiteral("lib/CMakeFiles/lib.dir/lib.cpp.o")));
+    parser.addObjectFile(QStringLiteral("./CMakeFiles/app.dir/other file.cpp.o"));
+    // outputs the database does not know, like libraries, are ignored
+    parser.addObjectFile(QStringLiteral("lib/liblib.a"));
+    QVERIFY(!parser.isEmpty());
+
+    const QVector<IndexedString> expected = {
+        IndexedString(QStringLiteral("/src/main.cpp")),
+        IndexedString(QStringLiteral("/src/lib/lib.cpp")),
+        IndexedString(QStringLiteral("/src/other file.cpp")),
+    };
+    QCOMPARE(parser.sources(), expected);
+}
+
+void TestRebuiltSourcesParser::testNoDatabase()
+{
+    QTemporaryDir buildDir;
+    QVERIFY(buildDir.isValid());
+
+    RebuiltSourcesParser parser(Path(buildDir.path()));
+    parser.addObjectFile(QStringLiteral("main.o"));
+    QVERIFY(parser.sources().isEmpty());
+    QCOMPARE(parser.parse().result(), 0);
+}
+
+QTEST_MAIN(TestRebuiltSourcesParser)
+
+#include "test_rebuiltsourcesparser.moc"
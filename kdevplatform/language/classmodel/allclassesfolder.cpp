@@ -78,13 +78,8 @@ void AllClassesFolder::projectClosing(KDevelop::IProject* project)
 
 void AllClassesFolder::projectOpened(KDevelop::IProject* project)
 {
-    // Run over all the files in the project.
-    const auto files = project->fileSet();
-    for (const IndexedString& file : files) {
-        parseDocument(file);
-    }
-
-    recursiveSort();
+    // Parse all the files in the project, in the background.
+    parseDocuments(project->fileSet());
 }
 
 //////////////////////////////////////////////////////////////////////////////
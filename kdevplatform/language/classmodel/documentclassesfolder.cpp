@@ -29,6 +29,7 @@
 
 #include <QIcon>
 #include <QTimer>
+#include <QtConcurrentRun>
 
 #include <boost/foreach.hpp>
 
@@ -85,30 +86,94 @@ DocumentClassesFolder::OpenedFileClassItem::OpenedFileClassItem(const KDevelop::
 DocumentClassesFolder::DocumentClassesFolder(const QString& a_displayName, NodesModelInterface* a_model)
     : DynamicFolderNode(a_displayName, a_model)
     , m_updateTimer(new QTimer(this))
+    , m_readWatcher(new QFutureWatcher<ReadDocuments>(this))
 {
     // this is the required delay.
     m_updateTimer->setInterval(2000);
     connect(m_updateTimer, &QTimer::timeout, this, &DocumentClassesFolder::updateChangedFiles);
+    connect(m_readWatcher, &QFutureWatcher<ReadDocuments>::finished, this, &DocumentClassesFolder::documentsRead);
+    connect(DUChain::self(), &DUChain::updateReady, this, &DocumentClassesFolder::documentUpdated);
 }
 
-void DocumentClassesFolder::updateChangedFiles()
+DocumentClassesFolder::~DocumentClassesFolder()
+{
+    m_readWatcher->waitForFinished();
+}
+
+void DocumentClassesFolder::documentUpdated(const IndexedString& a_file)
 {
-    bool hadChanges = false;
+    // Make sure it's one of the monitored files.
+    if (m_openFiles.contains(a_file))
+        m_updatedFiles.insert(a_file);
+}
 
-    // re-parse changed documents.
-    // TODO: m_updatedFiles seems no longer set, check again and remove if
+void DocumentClassesFolder::updateChangedFiles()
+{
+    // re-parse changed documents, the nodes of the other documents are kept.
     for (const IndexedString& file : qAsConst(m_updatedFiles)) {
-        // Make sure it's one of the monitored files.
         if (m_openFiles.contains(file))
-            hadChanges |= updateDocument(file);
+            m_documentsToRead.append(file);
     }
 
     // Processed all files.
     m_updatedFiles.clear();
 
-    // Sort if had changes.
-    if (hadChanges)
-        recursiveSort();
+    readNextDocuments();
+}
+
+void DocumentClassesFolder::readNextDocuments()
+{
+    if (m_reading || m_documentsToRead.isEmpty())
+        return;
+
+    const QVector<IndexedString> files = m_documentsToRead;
+    m_documentsToRead.clear();
+
+    m_reading = true;
+    m_readWatcher->setFuture(QtConcurrent::run([files]() {
+        ReadDocuments read;
+        read.reserve(files.size());
+        for (const IndexedString& file : files) {
+            read.append(qMakePair(file, readDocument(file)));
+        }
+
+        return read;
+    }));
+}
+
+void DocumentClassesFolder::documentsRead()
+{
+    if (!m_reading || !m_readWatcher->isFinished())
+        return;
+
+    m_reading = false;
+
+    if (m_discardRead) {
+        m_discardRead = false;
+    } else {
+        bool hadChanges = false;
+
+        const ReadDocuments read = m_readWatcher->result();
+        for (const auto& document : read) {
+            // The document may have been closed meanwhile.
+            if (m_openFiles.contains(document.first))
+                hadChanges |= updateDocument(document.first, document.second);
+        }
+
+        // Sort if had changes.
+        if (hadChanges)
+            recursiveSort();
+    }
+
+    readNextDocuments();
+}
+
+void DocumentClassesFolder::finishReadingDocuments()
+{
+    while (m_reading) {
+        m_readWatcher->waitForFinished();
+        documentsRead();
+    }
 }
 
 void DocumentClassesFolder::nodeCleared()
@@ -120,6 +185,11 @@ void DocumentClassesFolder::nodeCleared()
     m_openFiles.clear();
     m_openFilesClasses.clear();
 
+    // Forget about the documents being read.
+    m_documentsToRead.clear();
+    m_updatedFiles.clear();
+    m_discardRead = m_reading;
+
     // Stop the update timer.
     m_updateTimer->stop();
 }
@@ -140,6 +210,7 @@ ClassNode* DocumentClassesFolder::findClassNode(const IndexedQualifiedIdentifier
     // Make sure that the classes node is populated, otherwise
     // the lookup will not work.
     performPopulateNode();
+    finishReadingDocuments();
 
     ClassIdentifierIterator iter = m_openFilesClasses.get<ClassIdentifierIndex>().find(a_id);
     if (iter == m_openFilesClasses.get<ClassIdentifierIndex>().end())
@@ -200,8 +271,31 @@ void DocumentClassesFolder::closeDocument(const IndexedString& a_file)
     m_openFiles.remove(a_file);
 }
 
-bool DocumentClassesFolder::updateDocument(const KDevelop::IndexedString& a_file)
+namespace {
+/// Whether the first valid declaration of @p a_identifier is a namespace.
+/// @note DU CHAIN MUST BE LOCKED FOR READ
+bool isNamespace(const QualifiedIdentifier& a_identifier)
 {
+    uint declsCount = 0;
+    const IndexedDeclaration* decls;
+    PersistentSymbolTable::self().declarations(a_identifier, declsCount, decls);
+
+    for (uint i = 0; i < declsCount; ++i) {
+        if (Declaration* decl = decls[i].declaration())
+            return decl->kind() == Declaration::Namespace;
+    }
+
+    return false;
+}
+}
+
+DocumentClassesFolder::DocumentClasses DocumentClassesFolder::readDocument(const IndexedString& a_file)
+{
+    DocumentClasses result;
+
+    // The code model is changed while the duchain is locked for writing.
+    DUChainReadLocker lock;
+
     uint codeModelItemCount = 0;
     const CodeModelItem* codeModelItems;
     CodeModel::self().items(a_file, codeModelItemCount, codeModelItems);
@@ -209,20 +303,6 @@ bool DocumentClassesFolder::updateDocument(const KDevelop::IndexedString& a_file
     // List of declared namespaces in this file.
     QSet<QualifiedIdentifier> declaredNamespaces;
 
-    // List of removed classes - it initially contains all the known classes, we'll eliminate them
-    // one by one later on when we encounter them in the document.
-    QMap<IndexedQualifiedIdentifier, FileIterator> removedClasses;
-    {
-        std::pair<FileIterator, FileIterator> range = m_openFilesClasses.get<FileIndex>().equal_range(a_file);
-        for (FileIterator iter = range.first;
-             iter != range.second;
-             ++iter) {
-            removedClasses.insert(iter->classIdentifier, iter);
-        }
-    }
-
-    bool documentChanged = false;
-
     for (uint codeModelItemIndex = 0; codeModelItemIndex < codeModelItemCount; ++codeModelItemIndex) {
         const CodeModelItem& item = codeModelItems[codeModelItemIndex];
 
@@ -236,105 +316,134 @@ bool DocumentClassesFolder::updateDocument(const KDevelop::IndexedString& a_file
         if (id.count() == 0)
             continue;
 
-        // If it's a namespace, create it in the list.
         if (item.kind & CodeModelItem::Namespace) {
-            // This should create the namespace folder and add it to the cache.
-            namespaceFolder(id);
-
-            // Add to the locally created namespaces.
+            result.namespaces.append(id);
             declaredNamespaces.insert(id);
         } else if (item.kind & CodeModelItem::Class) {
             // Ignore empty unnamed classes.
             if (id.last().toString().isEmpty())
                 continue;
 
-            // See if it matches our filter?
-            if (isClassFiltered(id))
-                continue;
+            DocumentClass documentClass;
+            documentClass.id = item.id;
 
-            // Is this a new class or an existing class?
-            const auto classIt = removedClasses.find(id);
-            if (classIt != removedClasses.end()) {
-                // It already exist - remove it from the known classes and continue.
-                removedClasses.erase(classIt);
-                continue;
+            // A class might be declared under a namespace even when the namespace isn't declared
+            // in the document, so if it isn't, perform a more thorough search. If the parent isn't
+            // a namespace it's a class, and when the parent class gets expanded it will show it.
+            if (id.count() > 1) {
+                const QualifiedIdentifier parentIdentifier(id.left(-1));
+                documentClass.inNamespace = declaredNamespaces.contains(parentIdentifier)
+                                            || isNamespace(parentIdentifier);
             }
 
-            // Where should we put this class?
-            Node* parentNode = nullptr;
-
-            // Check if it's namespaced and add it to the proper namespace.
-            if (id.count() > 1) {
-                QualifiedIdentifier parentIdentifier(id.left(-1));
-
-                // Look up the namespace in the cache.
-                // If we fail to find it we assume that the parent context is a class
-                // and in that case, when the parent class gets expanded, it will show it.
-                NamespacesMap::iterator iter = m_namespaces.find(parentIdentifier);
-                if (iter != m_namespaces.end()) {
-                    // Add to the namespace node.
-                    parentNode = iter.value();
-                } else
-                {
-                    // Reaching here means we didn't encounter any namespace declaration in the document
-                    // But a class might still be declared under a namespace.
-                    // So we'll perform a more through search to see if it's under a namespace.
-
-                    DUChainReadLocker readLock(DUChain::lock());
-
-                    uint declsCount = 0;
-                    const IndexedDeclaration* decls;
-                    PersistentSymbolTable::self().declarations(parentIdentifier, declsCount, decls);
-
-                    for (uint i = 0; i < declsCount; ++i) {
-                        // Look for the first valid declaration.
-                        if (decls->declaration()) {
-                            // See if it should be namespaced.
-                            if (decls->declaration()->kind() == Declaration::Namespace) {
-                                // This should create the namespace folder and add it to the cache.
-                                parentNode = namespaceFolder(parentIdentifier);
-
-                                // Add to the locally created namespaces.
-                                declaredNamespaces.insert(parentIdentifier);
-                            }
-
-                            break;
-                        }
-                    }
+            // Find the declaration in this document.
+            uint count = 0;
+            const IndexedDeclaration* declarations;
+            PersistentSymbolTable::self().declarations(item.id, count, declarations);
+            for (uint i = 0; i < count; ++i) {
+                if (declarations[i].indexedTopContext().url() == a_file) {
+                    documentClass.declaration = declarations[i];
+                    break;
                 }
-            } else
-            {
-                // Add to the main root.
-                parentNode = this;
             }
 
-            ClassNode* newNode = nullptr;
-            if (parentNode != nullptr) {
-                // Create the new node and add it.
-                IndexedDeclaration decl;
-                uint count = 0;
-                const IndexedDeclaration* declarations;
-                DUChainReadLocker lock;
-                PersistentSymbolTable::self().declarations(item.id, count, declarations);
-                for (uint i = 0; i < count; ++i) {
-                    if (declarations[i].indexedTopContext().url() == a_file) {
-                        decl = declarations[i];
-                        break;
-                    }
-                }
+            result.classes.append(documentClass);
+        }
+    }
 
-                if (decl.isValid()) {
-                    newNode = new ClassNode(decl.declaration(), m_model);
-                    parentNode->addNode(newNode);
-                }
+    return result;
+}
+
+bool DocumentClassesFolder::updateDocument(const KDevelop::IndexedString& a_file)
+{
+    return updateDocument(a_file, readDocument(a_file));
+}
+
+bool DocumentClassesFolder::updateDocument(const KDevelop::IndexedString& a_file, const DocumentClasses& a_classes)
+{
+    // List of declared namespaces in this file.
+    QSet<QualifiedIdentifier> declaredNamespaces;
+
+    // List of removed classes - it initially contains all the known classes, we'll eliminate them
+    // one by one later on when we encounter them in the document.
+    QMap<IndexedQualifiedIdentifier, FileIterator> removedClasses;
+    {
+        std::pair<FileIterator, FileIterator> range = m_openFilesClasses.get<FileIndex>().equal_range(a_file);
+        for (FileIterator iter = range.first;
+             iter != range.second;
+             ++iter) {
+            removedClasses.insert(iter->classIdentifier, iter);
+        }
+    }
+
+    bool documentChanged = false;
+
+    for (const QualifiedIdentifier& id : a_classes.namespaces) {
+        // This should create the namespace folder and add it to the cache.
+        namespaceFolder(id);
+
+        // Add to the locally created namespaces.
+        declaredNamespaces.insert(id);
+    }
+
+    DUChainReadLocker lock;
+
+    for (const DocumentClass& documentClass : a_classes.classes) {
+        const QualifiedIdentifier id = documentClass.id.identifier();
+
+        // See if it matches our filter?
+        if (isClassFiltered(id))
+            continue;
+
+        // Is this a new class or an existing class?
+        const auto classIt = removedClasses.find(documentClass.id);
+        if (classIt != removedClasses.end()) {
+            // It already exist - remove it from the known classes and continue.
+            removedClasses.erase(classIt);
+            continue;
+        }
+
+        // Where should we put this class?
+        Node* parentNode = nullptr;
+
+        // Check if it's namespaced and add it to the proper namespace.
+        if (id.count() > 1) {
+            QualifiedIdentifier parentIdentifier(id.left(-1));
+
+            // Look up the namespace in the cache.
+            NamespacesMap::iterator iter = m_namespaces.find(parentIdentifier);
+            if (iter != m_namespaces.end()) {
+                // Add to the namespace node.
+                parentNode = iter.value();
+            } else if (documentClass.inNamespace) {
+                // This should create the namespace folder and add it to the cache.
+                parentNode = namespaceFolder(parentIdentifier);
+
+                // Add to the locally created namespaces.
+                declaredNamespaces.insert(parentIdentifier);
             }
+        } else
+        {
+            // Add to the main root.
+            parentNode = this;
+        }
 
-            // Insert it to the map - newNode can be 0 - meaning the class is hidden.
-            m_openFilesClasses.insert(OpenedFileClassItem(a_file, id, newNode));
-            documentChanged = true;
+        ClassNode* newNode = nullptr;
+        if (parentNode != nullptr) {
+            // Create the new node and add it.
+            if (Declaration* decl = documentClass.declaration.declaration()) {
+                newNode = new ClassNode(decl, m_model);
+                parentNode->addNode(newNode);
+            }
         }
+
+        // Insert it to the map - newNode can be 0 - meaning the class is hidden.
+        m_openFilesClasses.insert(OpenedFileClassItem(a_file, documentClass.id, newNode));
+        documentChanged = true;
     }
 
+    lock.unlock();
+
     // Remove empty namespaces from the list.
     // We need this because when a file gets unloaded, we unload the declared classes in it
     // and if a namespace has no class in it, it'll forever exist and no one will remove it
@@ -363,6 +472,17 @@ void DocumentClassesFolder::parseDocument(const IndexedString& a_file)
     updateDocument(a_file);
 }
 
+void DocumentClassesFolder::parseDocuments(const QSet<IndexedString>& a_files)
+{
+    // Add the documents to the list of open files - this means we monitor them.
+    for (const IndexedString& file : a_files) {
+        m_openFiles.insert(file);
+        m_documentsToRead.append(file);
+    }
+
+    readNextDocuments();
+}
+
 void DocumentClassesFolder::removeClassNode(ClassModelNodes::ClassNode* a_node)
 {
     // Get the parent namespace identifier.
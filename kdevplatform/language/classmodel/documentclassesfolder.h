@@ -23,6 +23,10 @@
 #define KDEVPLATFORM_DOCUMENTCLASSESFOLDER_H
 
 #include "classmodelnode.h"
+#include "../duchain/indexeddeclaration.h"
+#include <QFutureWatcher>
+#include <QPair>
+#include <QVector>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -39,6 +43,7 @@ class DocumentClassesFolder
 
 public:
     DocumentClassesFolder(const QString& a_displayName, NodesModelInterface* a_model);
+    ~DocumentClassesFolder() override;
 
 public: // Operations
     /// Find a class node in the lists by its id.
@@ -48,6 +53,9 @@ protected: // Documents list handling.
     /// Parse a single document for classes and add them to the list.
     void parseDocument(const KDevelop::IndexedString& a_file);
 
+    /// Parse documents for classes in the background and add them to the list once done.
+    void parseDocuments(const QSet<KDevelop::IndexedString>& a_files);
+
     /// Re-parse the given document - remove old declarations and add new declarations.
     bool updateDocument(const KDevelop::IndexedString& a_file);
 
@@ -69,6 +77,10 @@ public: // Node overrides
 private Q_SLOTS:
     // Files update.
     void updateChangedFiles();
+    void documentUpdated(const KDevelop::IndexedString& a_file);
+
+    // Background parsing.
+    void documentsRead();
 
 private: // File updates related.
     /// List of updated files we check this list when update timer expires.
@@ -77,6 +89,46 @@ private: // File updates related.
     /// Timer for batch updates.
     QTimer* m_updateTimer;
 
+private: // Background parsing related.
+    /// A class declared in a document.
+    struct DocumentClass
+    {
+        KDevelop::IndexedQualifiedIdentifier id;
+        /// The declaration of the class in the document.
+        KDevelop::IndexedDeclaration declaration;
+        /// Whether the class is declared in a namespace, and not in another class.
+        bool inNamespace = false;
+    };
+
+    /// The namespaces and classes declared in a document.
+    struct DocumentClasses
+    {
+        QVector<KDevelop::QualifiedIdentifier> namespaces;
+        QVector<DocumentClass> classes;
+    };
+    using ReadDocuments = QVector<QPair<KDevelop::IndexedString, DocumentClasses>>;
+
+    /// Collect the classes of a document from the code model, this can run in any thread.
+    static DocumentClasses readDocument(const KDevelop::IndexedString& a_file);
+
+    /// Update the nodes of a document to the classes read from it.
+    bool updateDocument(const KDevelop::IndexedString& a_file, const DocumentClasses& a_classes);
+
+    /// Start reading the documents waiting for it, unless a read is running already.
+    void readNextDocuments();
+
+    /// Wait for the documents being read and add them.
+    void finishReadingDocuments();
+
+    /// Documents waiting to be read in the background.
+    QVector<KDevelop::IndexedString> m_documentsToRead;
+
+    /// Reads documents off the UI thread.
+    QFutureWatcher<ReadDocuments>* m_readWatcher;
+    bool m_reading = false;
+    /// The documents being read were cleared meanwhile.
+    bool m_discardRead = false;
+
 private: // Opened class identifiers container definition.
     // An opened class item.
     struct OpenedFileClassItem
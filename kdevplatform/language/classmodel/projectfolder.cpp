@@ -40,12 +40,10 @@ ProjectFolder::ProjectFolder(NodesModelInterface* a_model)
 
 void ProjectFolder::populateNode()
 {
-    const auto files = m_project->fileSet();
-    for (const IndexedString& file : files) {
-        parseDocument(file);
-    }
+    DocumentClassesFolder::populateNode();
 
-    recursiveSort();
+    // Parse all the files in the project, in the background.
+    parseDocuments(m_project->fileSet());
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,8 @@
 
 // Qt
 #include <QAction>
+#include <QProgressDialog>
+#include <QtConcurrentMap>
 // KF
 #include <KParts/MainWindow>
 #include <KTextEditor/Document>
@@ -29,7 +31,9 @@
 #include <interfaces/idocument.h>
 #include <interfaces/iuicontroller.h>
 #include <interfaces/idocumentcontroller.h>
+#include <interfaces/ilanguagecontroller.h>
 #include <interfaces/contextmenuextension.h>
+#include <language/backgroundparser/backgroundparser.h>
 #include <language/duchain/duchain.h>
 #include <language/duchain/duchainlock.h>
 #include <language/duchain/duchainutils.h>
@@ -55,6 +59,13 @@ QPair<QString, QString> splitFileAtExtension(const QString& fileName)
     }
     return qMakePair(fileName.left(idx), fileName.mid(idx));
 }
+
+// The changes for the uses in one top-context
+struct UseChanges
+{
+    KDevelop::DocumentChangeSet changes;
+    KDevelop::DocumentChangeSet::ChangeResult result = KDevelop::DocumentChangeSet::ChangeResult::successfulResult();
+};
 }
 
 using namespace KDevelop;
@@ -335,23 +346,52 @@ DocumentChangeSet BasicRefactoring::renameCollectedDeclarations(KDevelop::BasicR
     DocumentChangeSet changes;
     DUChainReadLocker lock;
 
+    const auto declarations = collector->declarations();
+    const std::function<UseChanges(const IndexedTopDUContext&)> collectUseChanges =
+        [this, &declarations, &originalName, &replacementName](const IndexedTopDUContext& collected) {
+            DUChainReadLocker useLock;
+            UseChanges ret;
+            TopDUContext* top = collected.data();
+            if (!top)
+                return ret;
+            QSet<int> hadIndices;
+            for (const IndexedDeclaration decl : declarations) {
+                uint usedDeclarationIndex = top->indexForUsedDeclaration(decl.data(), false);
+                if (hadIndices.contains(usedDeclarationIndex))
+                    continue;
+                hadIndices.insert(usedDeclarationIndex);
+                ret.result = applyChanges(originalName, replacementName, ret.changes, top, usedDeclarationIndex);
+                if (!ret.result)
+                    break;
+            }
+            return ret;
+        };
+
+    // The ranges of the uses in open documents are translated through their moving ranges in this thread,
+    // the uses in all other files are collected in parallel
+    QVector<IndexedTopDUContext> openUsingContexts;
+    QVector<IndexedTopDUContext> otherUsingContexts;
     const auto allUsingContexts = collector->allUsingContexts();
     for (const KDevelop::IndexedTopDUContext collected : allUsingContexts) {
-        QSet<int> hadIndices;
-        const auto declarations = collector->declarations();
-        for (const IndexedDeclaration decl : declarations) {
-            uint usedDeclarationIndex = collected.data()->indexForUsedDeclaration(decl.data(), false);
-            if (hadIndices.contains(usedDeclarationIndex))
-                continue;
-            hadIndices.insert(usedDeclarationIndex);
-            DocumentChangeSet::ChangeResult result = applyChanges(originalName, replacementName, changes,
-                                                                  collected.data(), usedDeclarationIndex);
-            if (!result) {
-                auto* message = new Sublime::Message(i18n("Failed to apply changes: %1", result.m_failureReason), Sublime::Message::Error);
-                ICore::self()->uiController()->postMessage(message);
-                return {};
-            }
+        if (ICore::self()->languageController()->backgroundParser()->trackerForUrl(collected.url()))
+            openUsingContexts << collected;
+        else
+            otherUsingContexts << collected;
+    }
+
+    QVector<UseChanges> allUseChanges = QtConcurrent::blockingMapped<QVector<UseChanges>>(otherUsingContexts,
+                                                                                           collectUseChanges);
+    for (const KDevelop::IndexedTopDUContext collected : qAsConst(openUsingContexts)) {
+        allUseChanges << collectUseChanges(collected);
+    }
+
+    for (const UseChanges& useChanges : qAsConst(allUseChanges)) {
+        if (!useChanges.result) {
+            auto* message = new Sublime::Message(i18n("Failed to apply changes: %1", useChanges.result.m_failureReason), Sublime::Message::Error);
+            ICore::self()->uiController()->postMessage(message);
+            return {};
         }
+        changes.addChanges(useChanges.changes);
     }
 
     DocumentChangeSet::ChangeResult result = applyChangesToDeclarations(originalName, replacementName, changes,
@@ -364,13 +404,28 @@ DocumentChangeSet BasicRefactoring::renameCollectedDeclarations(KDevelop::BasicR
 
     ///We have to ignore failed changes for now, since uses of a constructor or of operator() may be created on "(" parens
     changes.setReplacementPolicy(DocumentChangeSet::IgnoreFailedChange);
+    // An identifier is replaced by an identifier, there is nothing to format
+    changes.setFormatPolicy(DocumentChangeSet::NoAutoFormat);
 
     if (!apply) {
         return changes;
     }
 
+    lock.unlock();
+
+    QProgressDialog progressDialog(i18n("Renaming \"%1\" to \"%2\"", originalName, replacementName),
+                                   i18nc("@action:button", "Cancel"), 0, 0,
+                                   ICore::self()->uiController()->activeMainWindow());
+    progressDialog.setWindowModality(Qt::WindowModal);
+    changes.setProgressHandler([&progressDialog](int written, int total) {
+        progressDialog.setMaximum(total);
+        progressDialog.setValue(written);
+        return !progressDialog.wasCanceled();
+    });
+
     result = changes.applyAllChanges();
-    if (!result) {
+    // the user knows about canceling
+    if (!result && !progressDialog.wasCanceled()) {
         auto* message = new Sublime::Message(i18n("Failed to apply changes: %1", result.m_failureReason), Sublime::Message::Error);
         ICore::self()->uiController()->postMessage(message);
     }
@@ -108,6 +108,9 @@ protected:
      * Apply the changes to the uses that can be found inside the given
      * context and its children.
      * NOTE: the DUChain must be locked.
+     * NOTE: for contexts of documents which are not open, this is called from
+     * worker threads, for several contexts at the same time. Implementations
+     * must be thread-safe and must not use any widgets.
      */
     virtual DocumentChangeSet::ChangeResult applyChanges(const QString& oldName, const QString& newName,
                                                          DocumentChangeSet& changes, DUContext* context,
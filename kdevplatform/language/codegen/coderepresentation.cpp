@@ -19,6 +19,7 @@
 #include "coderepresentation.h"
 
 #include <QFile>
+#include <QSaveFile>
 #include <KTextEditor/Document>
 
 #include <serialization/indexedstring.h>
@@ -211,11 +212,14 @@ public:
         Q_ASSERT(!onDiskChangesForbidden);
         QString localFile(m_document.toUrl().toLocalFile());
 
-        QFile file(localFile);
+        // QSaveFile syncs the new contents to disk before it replaces the file,
+        // so the file is never left half-written. Without a direct write fallback,
+        // files in directories we can't create files in can't be changed.
+        QSaveFile file(localFile);
         if (file.open(QIODevice::WriteOnly)) {
             QByteArray data = text.toLocal8Bit();
 
-            if (file.write(data) == data.size()) {
+            if (file.write(data) == data.size() && file.commit()) {
                 ModificationRevision::clearModificationCache(m_document);
                 return true;
             }
@@ -355,6 +359,11 @@ CodeRepresentation::Ptr createCodeRepresentation(const IndexedString& path)
         return CodeRepresentation::Ptr(new FileCodeRepresentation(path));
 }
 
+CodeRepresentation::Ptr createFileCodeRepresentation(const IndexedString& path)
+{
+    return CodeRepresentation::Ptr(new FileCodeRepresentation(path));
+}
+
 void CodeRepresentation::setDiskChangesForbidden(bool changesForbidden)
 {
     onDiskChangesForbidden = changesForbidden;
@@ -157,6 +157,12 @@ public:
  */
 KDEVPLATFORMLANGUAGE_EXPORT CodeRepresentation::Ptr createCodeRepresentation(const IndexedString& url);
 
+/**
+ * Creates a code-representation of the contents of the file at the given url on disk, ignoring open documents
+ * and artificial code. Unlike createCodeRepresentation(), this may be called from any thread.
+ */
+KDEVPLATFORMLANGUAGE_EXPORT CodeRepresentation::Ptr createFileCodeRepresentation(const IndexedString& url);
+
 /**
  * @return true if an artificial code representation already exists for the specified URL
  */
@@ -25,6 +25,8 @@
 
 #include <QStringList>
 #include <QMimeDatabase>
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include <KLocalizedString>
 
@@ -60,19 +62,22 @@ public:
     DocumentChangeSet::FormatPolicy formatPolicy;
     DocumentChangeSet::DUChainUpdateHandling updatePolicy;
     DocumentChangeSet::ActivationPolicy activationPolicy;
+    DocumentChangeSet::ProgressHandler progressHandler;
 
     ChangesHash changes;
     QHash<IndexedString, IndexedString> documentsRename;
 
     DocumentChangeSet::ChangeResult addChange(const DocumentChangePointer& change);
     DocumentChangeSet::ChangeResult replaceOldText(CodeRepresentation* repr, const QString& newText,
-                                                   const ChangesList& sortedChangesList);
+                                                   const ChangesList& sortedChangesList) const;
     DocumentChangeSet::ChangeResult generateNewText(const IndexedString& file,
                                                     ChangesList& sortedChanges,
                                                     const CodeRepresentation* repr,
-                                                    QString& output);
+                                                    ISourceFormatter* formatter,
+                                                    QString& output) const;
     DocumentChangeSet::ChangeResult removeDuplicates(const IndexedString& file,
-                                                     ChangesList& filteredChanges);
+                                                     ChangesList& filteredChanges) const;
+    ISourceFormatter* formatterForFile(const IndexedString& file) const;
     void formatChanges();
     void updateFiles();
 };
@@ -127,6 +132,15 @@ static QString printRange(const KTextEditor::Range& r)
                  r.start().line(), r.start().column(),
                  r.end().line(), r.end().column());
 }
+
+// The new text of a file on disk, computed in a worker thread
+struct NewFileText
+{
+    CodeRepresentation::Ptr repr;
+    ChangesList sortedChanges;
+    QString text;
+    DocumentChangeSet::ChangeResult result = DocumentChangeSet::ChangeResult::successfulResult();
+};
 }
 
 DocumentChangeSet::DocumentChangeSet()
@@ -167,6 +181,24 @@ DocumentChangeSet::ChangeResult DocumentChangeSet::addChange(const DocumentChang
     return d->addChange(change);
 }
 
+DocumentChangeSet::ChangeResult DocumentChangeSet::addChanges(const DocumentChangeSet& changes)
+{
+    Q_D(DocumentChangeSet);
+
+    // copies, in case the changes are added to themselves
+    const ChangesHash otherChanges = changes.d_ptr->changes;
+    const QHash<IndexedString, IndexedString> otherDocumentsRename = changes.d_ptr->documentsRename;
+    for (const ChangesList& fileChanges : otherChanges) {
+        for (const DocumentChangePointer& change : fileChanges) {
+            d->addChange(change);
+        }
+    }
+    for (auto it = otherDocumentsRename.constBegin(); it != otherDocumentsRename.constEnd(); ++it) {
+        d->documentsRename.insert(it.key(), it.value());
+    }
+    return DocumentChangeSet::ChangeResult::successfulResult();
+}
+
 DocumentChangeSet::ChangeResult DocumentChangeSet::addDocumentRenameChange(const IndexedString& oldFile,
                                                                            const IndexedString& newname)
 {
@@ -210,6 +242,13 @@ void DocumentChangeSet::setActivationPolicy(DocumentChangeSet::ActivationPolicy
     d->activationPolicy = policy;
 }
 
+void DocumentChangeSet::setProgressHandler(const DocumentChangeSet::ProgressHandler& handler)
+{
+    Q_D(DocumentChangeSet);
+
+    d->progressHandler = handler;
+}
+
 DocumentChangeSet::ChangeResult DocumentChangeSet::applyAllChanges()
 {
     Q_D(DocumentChangeSet);
@@ -287,7 +326,17 @@ DocumentChangeSet::ChangeResult DocumentChangeSet::applyAllChanges()
 
     const QList<IndexedString> files(d->changes.keys());
 
+    // Open documents, artificial code and formatted changes have to be handled in this thread,
+    // the new text of all other files is computed in parallel
+    QVector<IndexedString> diskFiles;
     for (const IndexedString& file : files) {
+        ISourceFormatter* formatter = d->formatterForFile(file);
+        if (!formatter && !artificialCodeRepresentationExists(file) &&
+            !ICore::self()->documentController()->documentForUrl(file.toUrl())) {
+            diskFiles << file;
+            continue;
+        }
+
         CodeRepresentation::Ptr repr = createCodeRepresentation(file);
         if (!repr) {
             return ChangeResult(QStringLiteral("Could not create a Representation for %1").arg(file.str()));
@@ -303,28 +352,93 @@ DocumentChangeSet::ChangeResult DocumentChangeSet::applyAllChanges()
         }
 
         {
-            result = d->generateNewText(file, sortedChangesList, repr.data(), newTexts[file]);
+            result = d->generateNewText(file, sortedChangesList, repr.data(), formatter, newTexts[file]);
             if (!result)
                 return result;
         }
     }
 
+    {
+        const DocumentChangeSetPrivate* const constD = d;
+        const std::function<NewFileText(const IndexedString&)> computeNewText = [constD](const IndexedString& file) {
+            NewFileText ret;
+            ret.repr = createFileCodeRepresentation(file);
+            ret.result = constD->removeDuplicates(file, ret.sortedChanges);
+            if (ret.result)
+                ret.result = constD->generateNewText(file, ret.sortedChanges, ret.repr.data(), nullptr, ret.text);
+            return ret;
+        };
+        const QVector<NewFileText> newFileTexts =
+            QtConcurrent::blockingMapped<QVector<NewFileText>>(diskFiles, computeNewText);
+        for (int i = 0; i < diskFiles.size(); ++i) {
+            const NewFileText& newFileText = newFileTexts.at(i);
+            if (!newFileText.result)
+                return newFileText.result;
+            codeRepresentations[diskFiles.at(i)] = newFileText.repr;
+            filteredSortedChanges[diskFiles.at(i)] = newFileText.sortedChanges;
+            newTexts[diskFiles.at(i)] = newFileText.text;
+        }
+    }
+
     QMap<IndexedString, QString> oldTexts;
+    auto revertChanges = [&]() {
+        for (auto it = oldTexts.constBegin(), end = oldTexts.constEnd(); it != end; ++it) {
+            const IndexedString& revertFile = it.key();
+            const QString& oldText = it.value();
+            codeRepresentations[revertFile]->setText(oldText);
+        }
+    };
 
-    //Apply the changes to the files
+    //Apply the changes to the open documents and artificial code
+    QVector<IndexedString> writtenFiles;
     for (const IndexedString& file : files) {
+        if (!dynamic_cast<DynamicCodeRepresentation*>(codeRepresentations[file].data())) {
+            writtenFiles << file;
+            continue;
+        }
+
         oldTexts[file] = codeRepresentations[file]->text();
 
         result = d->replaceOldText(codeRepresentations[file].data(), newTexts[file], filteredSortedChanges[file]);
         if (!result && d->replacePolicy == StopOnFailedChange) {
             //Revert all files
-            for (auto it = oldTexts.constBegin(), end = oldTexts.constEnd(); it != end; ++it) {
-                const IndexedString& revertFile = it.key();
-                const QString& oldText = it.value();
-                codeRepresentations[revertFile]->setText(oldText);
+            revertChanges();
+            return result;
+        }
+    }
+
+    //Write the files on disk in parallel, in batches so that the progress can be reported in between
+    const int batchSize = qMax(1, QThread::idealThreadCount()) * 8;
+    const auto& constCodeRepresentations = codeRepresentations;
+    const auto& constNewTexts = newTexts;
+    const auto& constFilteredSortedChanges = filteredSortedChanges;
+    const std::function<QString(const IndexedString&)> writeFile = [&](const IndexedString& file) {
+        const ChangeResult writeResult = d->replaceOldText(constCodeRepresentations.value(file).data(),
+                                                           constNewTexts.value(file),
+                                                           constFilteredSortedChanges.value(file));
+        return writeResult ? QString() : writeResult.m_failureReason;
+    };
+    for (int batchStart = 0; batchStart < writtenFiles.size(); batchStart += batchSize) {
+        const QVector<IndexedString> batch = writtenFiles.mid(batchStart, batchSize);
+        for (const IndexedString& file : batch) {
+            oldTexts[file] = codeRepresentations[file]->text();
+        }
+
+        const QVector<QString> failureReasons = QtConcurrent::blockingMapped<QVector<QString>>(batch, writeFile);
+        for (const QString& failureReason : failureReasons) {
+            if (failureReason.isNull())
+                continue;
+            result = ChangeResult(failureReason);
+            if (d->replacePolicy == StopOnFailedChange) {
+                //Revert all files
+                revertChanges();
+                return result;
             }
+        }
 
-            return result;
+        if (d->progressHandler && !d->progressHandler(batchStart + batch.size(), writtenFiles.size())) {
+            revertChanges();
+            return ChangeResult(i18n("Applying the changes was canceled"));
         }
     }
 
@@ -346,7 +460,7 @@ DocumentChangeSet::ChangeResult DocumentChangeSet::applyAllChanges()
 
 DocumentChangeSet::ChangeResult DocumentChangeSetPrivate::replaceOldText(CodeRepresentation* repr,
                                                                          const QString& newText,
-                                                                         const ChangesList& sortedChangesList)
+                                                                         const ChangesList& sortedChangesList) const
 {
     auto* dynamic = dynamic_cast<DynamicCodeRepresentation*>(repr);
     if (dynamic) {
@@ -391,20 +505,29 @@ DocumentChangeSet::ChangeResult DocumentChangeSetPrivate::replaceOldText(CodeRep
     return DocumentChangeSet::ChangeResult::successfulResult();
 }
 
+ISourceFormatter* DocumentChangeSetPrivate::formatterForFile(const IndexedString& file) const
+{
+    auto core = ICore::self();
+    if (!core || formatPolicy == DocumentChangeSet::NoAutoFormat) {
+        return nullptr;
+    }
+
+    const QUrl url = file.toUrl();
+    return core->sourceFormatterController()->formatterForUrl(url, QMimeDatabase().mimeTypeForUrl(url));
+}
+
 DocumentChangeSet::ChangeResult DocumentChangeSetPrivate::generateNewText(const IndexedString& file,
                                                                           ChangesList& sortedChanges,
                                                                           const CodeRepresentation* repr,
-                                                                          QString& output)
+                                                                          ISourceFormatter* formatter,
+                                                                          QString& output) const
 {
     //Create the actual new modified file
     QStringList textLines = repr->text().split(QLatin1Char('\n'));
 
     QUrl url = file.toUrl();
 
-    QMimeType mime = QMimeDatabase().mimeTypeForUrl(url);
-
-    auto core = ICore::self();
-    ISourceFormatter* formatter = core ? core->sourceFormatterController()->formatterForUrl(file.toUrl(), mime) : nullptr;
+    QMimeType mime = formatter ? QMimeDatabase().mimeTypeForUrl(url) : QMimeType();
 
     QVector<int> removedLines;
 
@@ -518,12 +641,13 @@ DocumentChangeSet::ChangeResult DocumentChangeSetPrivate::generateNewText(const
 
 //Removes all duplicate changes for a single file, and then returns (via filteredChanges) the filtered duplicates
 DocumentChangeSet::ChangeResult DocumentChangeSetPrivate::removeDuplicates(const IndexedString& file,
-                                                                           ChangesList& filteredChanges)
+                                                                           ChangesList& filteredChanges) const
 {
     using ChangesMap = QMultiMap<KTextEditor::Cursor, DocumentChangePointer>;
     ChangesMap sortedChanges;
 
-    for (const DocumentChangePointer& change : qAsConst(changes[file])) {
+    const ChangesList fileChanges = changes.value(file);
+    for (const DocumentChangePointer& change : fileChanges) {
         sortedChanges.insert(change->m_range.end(), change);
     }
 
@@ -603,7 +727,8 @@ void DocumentChangeSetPrivate::updateFiles()
             }
         }
 
-        // Eventually update _all_ affected files
+        // Eventually update _all_ affected files. Those which are not open are updated after everything else,
+        // like the files of a project that is loaded, so large changes don't hold up the open documents
         const auto files = changes.keys();
         for (const IndexedString& file : files) {
             if (!file.toUrl().isValid()) {
@@ -611,7 +736,10 @@ void DocumentChangeSetPrivate::updateFiles()
                 continue;
             }
 
-            ICore::self()->languageController()->backgroundParser()->addDocument(file);
+            const bool isOpen = ICore::self()->documentController()->documentForUrl(file.toUrl());
+            ICore::self()->languageController()->backgroundParser()->addDocument(file,
+                TopDUContext::VisibleDeclarationsAndContexts,
+                isOpen ? BackgroundParser::NormalPriority : BackgroundParser::InitialParsePriority);
         }
     }
 }
@@ -28,6 +28,8 @@
 #include <QExplicitlySharedDataPointer>
 #include <QUrl>
 
+#include <functional>
+
 namespace KDevelop {
 class DocumentChangeSetPrivate;
 
@@ -106,6 +108,9 @@ private:
     ChangeResult addChange(const DocumentChange& change);
     ChangeResult addChange(const DocumentChangePointer& change);
 
+    /// Add all changes and document renames of @p changes to this change-set.
+    ChangeResult addChanges(const DocumentChangeSet& changes);
+
     ///given a file @p oldFile, rename it to the @p newname
     ChangeResult addDocumentRenameChange(const IndexedString& oldFile, const IndexedString& newname);
 
@@ -145,7 +150,18 @@ private:
     ///@param policy Whether the affected documents should be activated when the change is applied
     void setActivationPolicy(ActivationPolicy policy);
 
+    /**
+     * Called while applyAllChanges() writes the changed files on disk, with the count of the files written so far
+     * and the count of all files to write. Returning false cancels applying the changes, all files changed so far
+     * are reverted then.
+     */
+    using ProgressHandler = std::function<bool (int written, int total)>;
+
+    ///@param handler Called with the progress of applying the changes, see ProgressHandler
+    void setProgressHandler(const ProgressHandler& handler);
+
     /// Apply all the changes registered in this changeset to the actual files
+    /// Files on disk are written in parallel, each one atomically.
     ChangeResult applyAllChanges();
 
 private:
@@ -28,10 +28,30 @@
 #include <tests/testfile.h>
 #include <QTest>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 QTEST_GUILESS_MAIN(TestDocumentchangeset)
 
 using namespace KDevelop;
 
+namespace {
+const int manyFilesCount = 200;
+
+/// Creates more files than are written in one batch, with a change renaming "abc" to "foobar" in each
+std::vector<std::unique_ptr<TestFile>> createManyFiles(DocumentChangeSet& changes)
+{
+    std::vector<std::unique_ptr<TestFile>> files;
+    for (int i = 0; i < manyFilesCount; ++i) {
+        files.emplace_back(new TestFile(QStringLiteral("int abc = %1;").arg(i), QStringLiteral("cpp")));
+        changes.addChange(DocumentChange(files.back()->url(), KTextEditor::Range(0, 4, 0, 7),
+                                         QStringLiteral("abc"), QStringLiteral("foobar")));
+    }
+    return files;
+}
+}
+
 void TestDocumentchangeset::initTestCase()
 {
     AutoTestShell::init();
@@ -72,3 +92,43 @@ void TestDocumentchangeset::testReplaceSameLine()
     QVERIFY(result);
 }
 
+
+void TestDocumentchangeset::testReplaceManyFiles()
+{
+    DocumentChangeSet changes;
+    const auto files = createManyFiles(changes);
+
+    QVector<int> progress;
+    changes.setProgressHandler([&progress](int written, int total) {
+        if (total == manyFilesCount) {
+            progress << written;
+        }
+        return true;
+    });
+
+    DocumentChangeSet::ChangeResult result = changes.applyAllChanges();
+    QVERIFY(result);
+    QVERIFY(!progress.isEmpty());
+    QVERIFY(std::is_sorted(progress.constBegin(), progress.constEnd()));
+    QCOMPARE(progress.last(), manyFilesCount);
+    for (int i = 0; i < manyFilesCount; ++i) {
+        QCOMPARE(files[i]->fileContents(), QStringLiteral("int foobar = %1;").arg(i));
+    }
+}
+
+void TestDocumentchangeset::testCancel()
+{
+    DocumentChangeSet changes;
+    const auto files = createManyFiles(changes);
+
+    changes.setProgressHandler([](int, int) {
+        return false;
+    });
+
+    DocumentChangeSet::ChangeResult result = changes.applyAllChanges();
+    QVERIFY(!result);
+    // the files which were written already are reverted
+    for (int i = 0; i < manyFilesCount; ++i) {
+        QCOMPARE(files[i]->fileContents(), QStringLiteral("int abc = %1;").arg(i));
+    }
+}
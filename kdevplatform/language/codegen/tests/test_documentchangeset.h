@@ -32,6 +32,8 @@ private Q_SLOTS:
     void cleanupTestCase();
 
     void testReplaceSameLine();
+    void testReplaceManyFiles();
+    void testCancel();
 };
 
 #endif // TESTDOCUMENTCHANGESET_H
@@ -27,6 +27,7 @@
 #include <language/duchain/duchainutils.h>
 #include <language/duchain/types/indexedtype.h>
 #include <language/duchain/classfunctiondeclaration.h>
+#include <language/duchain/uses.h>
 #include <backgroundparser/parsejob.h>
 #include <backgroundparser/backgroundparser.h>
 #include "../classmemberdeclaration.h"
@@ -38,6 +39,8 @@
 #include <sublime/message.h>
 #include <KLocalizedString>
 
+#include <QtConcurrentMap>
+
 using namespace KDevelop;
 
 ///@todo make this language-neutral
@@ -142,6 +145,18 @@ struct ImportanceChecker
     UsesCollector& m_collector;
 };
 
+///Greps a file on disk for an identifier, can be run in any thread
+struct FileGrep
+{
+    using result_type = bool;
+
+    bool operator ()(const IndexedString& url) const
+    {
+        return !createFileCodeRepresentation(url)->grep(identifier).isEmpty();
+    }
+    QString identifier;
+};
+
 void UsesCollector::startCollecting()
 {
     DUChainReadLocker lock(DUChain::lock());
@@ -261,29 +276,80 @@ void UsesCollector::startCollecting()
         if (!file)
             return;
 
+        // decl may be gone once the lock was released for the grep below
+        const IndexedString declarationUrl = decl->url();
+
         if (checker(file))
             collected.insert(file);
 
         {
-            QSet<ParsingEnvironmentFile*> filteredCollected;
-            QMap<IndexedString, bool> grepCache;
-            // Filter the collected files by performing a grep
+            // Files which are known to use one of the declarations through the uses-map need no grep,
+            // the map is only filled for contexts that were parsed with uses though.
+            QSet<IndexedString> knownUseFiles;
+            for (const IndexedDeclaration& d : qAsConst(m_declarations)) {
+                Declaration* declaration = d.data();
+                if (!declaration)
+                    continue;
+                const DeclarationId id = declaration->id();
+                const KDevVarLengthArray<IndexedTopDUContext> useContexts = DUChain::uses()->uses(id);
+                for (const IndexedTopDUContext& useContext : useContexts) {
+                    knownUseFiles.insert(useContext.url());
+                }
+                if (!id.isDirect()) {
+                    const KDevVarLengthArray<IndexedTopDUContext> directUseContexts = DUChain::uses()->uses(declaration->id(true));
+                    for (const IndexedTopDUContext& useContext : directUseContexts) {
+                        knownUseFiles.insert(useContext.url());
+                    }
+                }
+            }
+
+            // Filter the remaining collected files by performing a grep. Open documents and artificial code
+            // have to be read here, the files on disk are read and searched in parallel.
+            const QString identifier = decl->identifier().identifier().str();
+            QHash<IndexedString, bool> grepCache;
+            QVector<IndexedString> diskFiles;
             for (ParsingEnvironmentFile* file : qAsConst(collected)) {
-                IndexedString url = file->url();
-                QMap<IndexedString, bool>::iterator grepCacheIt = grepCache.find(url);
-                if (grepCacheIt == grepCache.end()) {
+                const IndexedString url = file->url();
+                if (grepCache.contains(url))
+                    continue;
+                if (knownUseFiles.contains(url)) {
+                    grepCache.insert(url, true);
+                } else if (artificialCodeRepresentationExists(url) ||
+                           ICore::self()->documentController()->documentForUrl(url.toUrl())) {
                     CodeRepresentation::Ptr repr = KDevelop::createCodeRepresentation(url);
-                    if (repr) {
-                        QVector<KTextEditor::Range> found = repr->grep(decl->identifier().identifier().str());
-                        grepCacheIt = grepCache.insert(url, !found.isEmpty());
-                    }
+                    grepCache.insert(url, repr && !repr->grep(identifier).isEmpty());
+                } else {
+                    // filled in below
+                    grepCache.insert(url, false);
+                    diskFiles << url;
                 }
-                if (grepCacheIt.value())
+            }
+
+            // Reading the files takes long, so don't block the duchain meanwhile. The collected
+            // environment files are kept alive until the results are matched with them again.
+            QVector<ParsingEnvironmentFilePointer> collectedFiles;
+            collectedFiles.reserve(collected.size());
+            for (ParsingEnvironmentFile* file : qAsConst(collected)) {
+                collectedFiles << ParsingEnvironmentFilePointer(file);
+            }
+            lock.unlock();
+
+            const QVector<bool> diskFilesFound = QtConcurrent::blockingMapped<QVector<bool>>(diskFiles,
+                                                                                             FileGrep{identifier});
+
+            lock.lock();
+            for (int i = 0; i < diskFiles.size(); ++i) {
+                grepCache.insert(diskFiles.at(i), diskFilesFound.at(i));
+            }
+
+            QSet<ParsingEnvironmentFile*> filteredCollected;
+            for (ParsingEnvironmentFile* file : qAsConst(collected)) {
+                if (grepCache.value(file->url()))
                     filteredCollected << file;
             }
 
             qCDebug(LANGUAGE) << "Collected contexts for full re-parse, before filtering: " << collected.size() <<
-                " after filtering: " << filteredCollected.size();
+                " after filtering: " << filteredCollected.size() << " known from the uses-map: " << knownUseFiles.size();
             collected = filteredCollected;
         }
 
@@ -312,7 +378,7 @@ void UsesCollector::startCollecting()
             m_staticFeaturesManipulated.insert(file->url());
         }
 
-        m_staticFeaturesManipulated.insert(decl->url());
+        m_staticFeaturesManipulated.insert(declarationUrl);
 
         const auto currentFeaturesManipulated = m_staticFeaturesManipulated;
         for (const IndexedString& file : currentFeaturesManipulated) {
@@ -460,6 +526,12 @@ void UsesCollector::updateReady(const KDevelop::IndexedString& url, KDevelop::Re
 
     const auto importedParentContexts = topContext->importedParentContexts();
     for (const DUContext::Import& imported : importedParentContexts) {
+        // Only imports that were prepared for the search can contain uses, so don't load any others.
+        // The url of an indexed top-context is available without loading it, specialization imports have none.
+        const IndexedTopDUContext importedTop(imported.topContextIndex());
+        if (importedTop.isValid() &&
+            (!m_staticFeaturesManipulated.contains(importedTop.url()) || m_checked.contains(importedTop)))
+            continue;
         if (imported.context(nullptr) && imported.context(nullptr)->topContext())
             imports << KDevelop::ReferencedTopDUContext(imported.context(nullptr)->topContext());
     }
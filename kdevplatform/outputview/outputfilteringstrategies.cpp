@@ -40,7 +40,11 @@ template<typename ErrorFormats>
 FilteredItem match(const ErrorFormats& errorFormats, const QString& line)
 {
     FilteredItem item(line);
+    const int lineFeatures = LinePrefilter::lineFeatures(line);
     for( const ErrorFormat& curErrFilter : errorFormats ) {
+        if (!curErrFilter.prefilter.accepts(line, lineFeatures)) {
+            continue;
+        }
         const auto match = curErrFilter.expression.match(line);
         if( match.hasMatch() ) {
             initializeFilteredItem(item, curErrFilter, match);
@@ -166,49 +170,53 @@ FilteredItem CompilerFilterStrategy::actionInLine(const QString& line)
 
     // A list of filters for possible compiler, linker, and make actions
     static const ActionFormat ACTION_FILTERS[] = {
-        ActionFormat( 2,
+        ActionFormat( "-c", 2,
                       QStringLiteral("(?:^|[^=])\\b(gcc|CC|cc|distcc|c\\+\\+|g\\+\\+|clang(?:\\+\\+)|mpicc|icc|icpc)\\s+.*-c.*[/ '\\\\]+(\\w+\\.(?:cpp|CPP|c|C|cxx|CXX|cs|java|hpf|f|F|f90|F90|f95|F95))")),
         //moc and uic
-        ActionFormat( 2, QStringLiteral("/(moc|uic)\\b.*\\s-o\\s([^\\s;]+)")),
+        ActionFormat( {"/moc", "/uic"}, 2, QStringLiteral("/(moc|uic)\\b.*\\s-o\\s([^\\s;]+)")),
         //libtool linking
-        ActionFormat( QStringLiteral("libtool"), QStringLiteral("/bin/sh\\s.*libtool.*--mode=link\\s.*\\s-o\\s([^\\s;]+)"), 1 ),
+        ActionFormat( "libtool", QStringLiteral("libtool"), QStringLiteral("/bin/sh\\s.*libtool.*--mode=link\\s.*\\s-o\\s([^\\s;]+)"), 1 ),
         //unsermake
-        ActionFormat( 1, QStringLiteral("^compiling (.*)") ),
-        ActionFormat( 2, QStringLiteral("^generating (.*)") ),
-        ActionFormat( 2, QStringLiteral("(gcc|cc|c\\+\\+|g\\+\\+|clang(?:\\+\\+)|mpicc|icc|icpc)\\S* (?:\\S* )*-o ([^\\s;]+)")),
-        ActionFormat( 2, QStringLiteral("^linking (.*)") ),
+        ActionFormat( "compiling ", 1, QStringLiteral("^compiling (.*)") ),
+        ActionFormat( "generating ", 2, QStringLiteral("^generating (.*)") ),
+        ActionFormat( "-o ", 2, QStringLiteral("(gcc|cc|c\\+\\+|g\\+\\+|clang(?:\\+\\+)|mpicc|icc|icpc)\\S* (?:\\S* )*-o ([^\\s;]+)")),
+        ActionFormat( "linking ", 2, QStringLiteral("^linking (.*)") ),
         //cmake
-        ActionFormat( 1, QStringLiteral("\\[.+%\\] Built target (.*)") ),
-        ActionFormat( QStringLiteral("cmake"),
+        ActionFormat( "] Built target ", 1, QStringLiteral("\\[.+%\\] Built target (.*)") ),
+        ActionFormat( "] Building ", QStringLiteral("cmake"),
                       QStringLiteral("\\[.+%\\] Building .* object (.*)"), 1 ),
-        ActionFormat( 1, QStringLiteral("\\[.+%\\] Generating (.*)") ),
-        ActionFormat( 1, QStringLiteral("^Linking (.*)") ),
-        ActionFormat( QStringLiteral("cmake"),
+        ActionFormat( "] Generating ", 1, QStringLiteral("\\[.+%\\] Generating (.*)") ),
+        ActionFormat( "Linking ", 1, QStringLiteral("^Linking (.*)") ),
+        ActionFormat( "-- ", QStringLiteral("cmake"),
                       QStringLiteral("(-- (?:Configuring|Generating) (?:done|incomplete)|-- Found|-- Adding|-- Enabling)"), -1 ),
-        ActionFormat( 1, QStringLiteral("-- Installing (.*)") ),
+        ActionFormat( "-- Installing ", 1, QStringLiteral("-- Installing (.*)") ),
         //cmake - cd - filter for project directory
-        ActionFormat( QStringLiteral("cd"),
+        ActionFormat( "cmake", QStringLiteral("cd"),
                       QStringLiteral("cmake(?:\\.exe|\\.bat)? (?:.*?) ((?:[A-Za-z]:|/).*$)"), 1),
         //libtool install
-        ActionFormat( {},
+        ActionFormat( "mkinstalldirs", {},
                       QStringLiteral("/(?:bin/sh\\s.*mkinstalldirs).*\\s([^\\s;]+)"), 1 ),
-        ActionFormat( {},
+        ActionFormat( "install", {},
                       QStringLiteral("/(?:usr/bin/install|bin/sh\\s.*mkinstalldirs|bin/sh\\s.*libtool.*--mode=install).*\\s([^\\s;]+)"), 1 ),
         //dcop
-        ActionFormat( QStringLiteral("dcopidl"),
+        ActionFormat( "dcopidl ", QStringLiteral("dcopidl"),
                       QStringLiteral("dcopidl .* > ([^\\s;]+)"), 1 ),
-        ActionFormat( QStringLiteral("dcopidl2cpp"),
+        ActionFormat( "dcopidl2cpp ", QStringLiteral("dcopidl2cpp"),
                       QStringLiteral("dcopidl2cpp (?:\\S* )*([^\\s;]+)"), 1 ),
         // match against Entering directory to update current build dir
-        ActionFormat( QStringLiteral("cd"),
+        ActionFormat( "Entering directory ", QStringLiteral("cd"),
                       QStringLiteral("make\\[\\d+\\]: Entering directory (\\`|\\')(.+)'"), 2),
         // waf and scons use the same basic convention as make
-        ActionFormat( QStringLiteral("cd"),
+        ActionFormat( "Entering directory ", QStringLiteral("cd"),
                       QStringLiteral("(Waf|scons): Entering directory (\\`|\\')(.+)'"), 3)
     };
 
     FilteredItem item(line);
+    const int lineFeatures = LinePrefilter::lineFeatures(line);
     for (const auto& curActFilter : ACTION_FILTERS) {
+        if (!curActFilter.prefilter.accepts(line, lineFeatures)) {
+            continue;
+        }
         const auto match = curActFilter.expression.match(line);
         if( match.hasMatch() ) {
             item.type = FilteredItem::ActionItem;
@@ -262,52 +270,56 @@ FilteredItem CompilerFilterStrategy::errorInLine(const QString& line)
     static const ErrorFormat ERROR_FILTERS[] = {
 #ifdef Q_OS_WIN
         // MSVC
-        ErrorFormat( QStringLiteral("^([a-zA-Z]:\\\\.+)\\(([1-9][0-9]*)\\): ((?:error|warning) .+\\:).*$"), 1, 2, 3 ),
+        ErrorFormat( LinePrefilter::ParenNumber, QStringLiteral("^([a-zA-Z]:\\\\.+)\\(([1-9][0-9]*)\\): ((?:error|warning) .+\\:).*$"), 1, 2, 3 ),
 #endif
         // GCC - another case, eg. for #include "pixmap.xpm" which does not exists
-        ErrorFormat( QStringLiteral("^(.:?[^:\\t]+):([0-9]+):([0-9]+):([^0-9]+)"), 1, 2, 4, 3 ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("^(.:?[^:\\t]+):([0-9]+):([0-9]+):([^0-9]+)"), 1, 2, 4, 3 ),
         // ant
-        ErrorFormat( QStringLiteral("\\[javac\\][\\s]+([^:\\t]+):([0-9]+): (warning: .*|error: .*)"), 1, 2, 3, QStringLiteral("javac")),
+        ErrorFormat( "[javac]", QStringLiteral("\\[javac\\][\\s]+([^:\\t]+):([0-9]+): (warning: .*|error: .*)"), 1, 2, 3, QStringLiteral("javac")),
         // GCC
-        ErrorFormat( QStringLiteral("^(.:?[^:\\t]+):([0-9]+):([^0-9]+)"), 1, 2, 3 ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("^(.:?[^:\\t]+):([0-9]+):([^0-9]+)"), 1, 2, 3 ),
         // GCC
-        ErrorFormat( QStringLiteral("^(In file included from |[ ]+from )(..[^:\\t]+):([0-9]+)(:|,)(|[0-9]+)"), 2, 3, 5 ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("^(In file included from |[ ]+from )(..[^:\\t]+):([0-9]+)(:|,)(|[0-9]+)"), 2, 3, 5 ),
         // ICC
-        ErrorFormat( QStringLiteral("^(.:?[^:\\t]+)\\(([0-9]+)\\):([^0-9]+)"), 1, 2, 3, QStringLiteral("intel") ),
+        ErrorFormat( LinePrefilter::ParenNumber, QStringLiteral("^(.:?[^:\\t]+)\\(([0-9]+)\\):([^0-9]+)"), 1, 2, 3, QStringLiteral("intel") ),
         //libtool link
-        ErrorFormat( QStringLiteral("^(libtool):( link):( warning): "), 0, 0, 0 ),
+        ErrorFormat( "libtool", QStringLiteral("^(libtool):( link):( warning): "), 0, 0, 0 ),
         // make
-        ErrorFormat( QStringLiteral("No rule to make target"), 0, 0, 0 ),
+        ErrorFormat( "No rule to make target", QStringLiteral("No rule to make target"), 0, 0, 0 ),
         // cmake - multiline expression
-        ErrorFormat( QStringLiteral("((^\\/|^[a-zA-Z]:)[\\w|\\/| |\\.]+):([0-9]+):"), 1, 2, 0, QStringLiteral("cmake") ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("((^\\/|^[a-zA-Z]:)[\\w|\\/| |\\.]+):([0-9]+):"), 1, 2, 0, QStringLiteral("cmake") ),
         // cmake
-        ErrorFormat( QStringLiteral("CMake (Error|Warning) (|\\([a-zA-Z]+\\) )(in|at) ([^:]+):($|[0-9]+)"), 4, 5, 1, QStringLiteral("cmake") ),
+        ErrorFormat( "CMake ", QStringLiteral("CMake (Error|Warning) (|\\([a-zA-Z]+\\) )(in|at) ([^:]+):($|[0-9]+)"), 4, 5, 1, QStringLiteral("cmake") ),
         // cmake/automoc
         // example: AUTOMOC: error: /foo/bar.cpp The file includes (...),
         // example: AUTOMOC: error: /foo/bar.cpp: The file includes (...)
         // note: ':' after file name isn't always appended, see https://cmake.org/gitweb?p=cmake.git;a=commitdiff;h=317d8498aa02c9f486bf5071963bb2034777cdd6
         // example: AUTOGEN: error: /foo/bar.cpp: The file includes (...)
         // note: AUTOMOC got renamed to AUTOGEN at some point
-        ErrorFormat( QStringLiteral("^(AUTOMOC|AUTOGEN): error: (.*?) (The file .*)$"), 2, 0, 0 ),
+        ErrorFormat( ": error: ", QStringLiteral("^(AUTOMOC|AUTOGEN): error: (.*?) (The file .*)$"), 2, 0, 0 ),
         // via qt4_automoc
         // example: automoc4: The file "/foo/bar.cpp" includes the moc file "bar1.moc", but ...
-        ErrorFormat( QStringLiteral("^automoc4: The file \"([^\"]+)\" includes the moc file"), 1, 0, 0 ),
+        ErrorFormat( "automoc4: ", QStringLiteral("^automoc4: The file \"([^\"]+)\" includes the moc file"), 1, 0, 0 ),
         // Fortran
-        ErrorFormat( QStringLiteral("\"(.*)\", line ([0-9]+):(.*)"), 1, 2, 3 ),
+        ErrorFormat( "\", line ", QStringLiteral("\"(.*)\", line ([0-9]+):(.*)"), 1, 2, 3 ),
         // GFortran
-        ErrorFormat( QStringLiteral("^(.*):([0-9]+)\\.([0-9]+):(.*)"), 1, 2, 4, QStringLiteral("gfortran"), 3 ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("^(.*):([0-9]+)\\.([0-9]+):(.*)"), 1, 2, 4, QStringLiteral("gfortran"), 3 ),
         // Jade
-        ErrorFormat( QStringLiteral("^[a-zA-Z]+:([^:\\t]+):([0-9]+):[0-9]+:[a-zA-Z]:(.*)"), 1, 2, 3 ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("^[a-zA-Z]+:([^:\\t]+):([0-9]+):[0-9]+:[a-zA-Z]:(.*)"), 1, 2, 3 ),
         // ifort
-        ErrorFormat( QStringLiteral("^fortcom: (.*): (.*), line ([0-9]+):(.*)"), 2, 3, 1, QStringLiteral("intel") ),
+        ErrorFormat( "fortcom: ", QStringLiteral("^fortcom: (.*): (.*), line ([0-9]+):(.*)"), 2, 3, 1, QStringLiteral("intel") ),
         // PGI
-        ErrorFormat( QStringLiteral("PGF9(.*)-(.*)-(.*)-(.*) \\((.*): ([0-9]+)\\)"), 5, 6, 4, QStringLiteral("pgi") ),
+        ErrorFormat( "PGF9", QStringLiteral("PGF9(.*)-(.*)-(.*)-(.*) \\((.*): ([0-9]+)\\)"), 5, 6, 4, QStringLiteral("pgi") ),
         // PGI (2)
-        ErrorFormat( QStringLiteral("PGF9(.*)-(.*)-(.*)-Symbol, (.*) \\((.*)\\)"), 5, 5, 4, QStringLiteral("pgi") ),
+        ErrorFormat( "PGF9", QStringLiteral("PGF9(.*)-(.*)-(.*)-Symbol, (.*) \\((.*)\\)"), 5, 5, 4, QStringLiteral("pgi") ),
     };
 
     FilteredItem item(line);
+    const int lineFeatures = LinePrefilter::lineFeatures(line);
     for (const auto& curErrFilter : ERROR_FILTERS) {
+        if (!curErrFilter.prefilter.accepts(line, lineFeatures)) {
+            continue;
+        }
         const auto match = curErrFilter.expression.match(line);
         if( match.hasMatch() && !( line.contains( QLatin1String("Each undeclared identifier is reported only once") )
                                || line.contains( QLatin1String("for each function it appears in.") ) ) )
@@ -371,9 +383,9 @@ FilteredItem ScriptErrorFilterStrategy::errorInLine(const QString& line)
 {
     // A list of filters for possible Python and PHP errors
     static const ErrorFormat SCRIPT_ERROR_FILTERS[] = {
-        ErrorFormat( QStringLiteral("^  File \"(.*)\", line ([0-9]+)(.*$|, in(.*)$)"), 1, 2, -1 ),
-        ErrorFormat( QStringLiteral("^.*(/.*):([0-9]+).*$"), 1, 2, -1 ),
-        ErrorFormat( QStringLiteral("^.* in (/.*) on line ([0-9]+).*$"), 1, 2, -1 )
+        ErrorFormat( "  File \"", QStringLiteral("^  File \"(.*)\", line ([0-9]+)(.*$|, in(.*)$)"), 1, 2, -1 ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("^.*(/.*):([0-9]+).*$"), 1, 2, -1 ),
+        ErrorFormat( " on line ", QStringLiteral("^.* in (/.*) on line ([0-9]+).*$"), 1, 2, -1 )
     };
 
     return match(SCRIPT_ERROR_FILTERS, line);
@@ -396,7 +408,7 @@ FilteredItem NativeAppErrorFilterStrategy::errorInLine(const QString& line)
         // BEGIN: C++
 
         // a.out: test.cpp:5: int main(): Assertion `false' failed.
-        ErrorFormat(QStringLiteral("^.+: (.+):([1-9][0-9]*): .*: Assertion `.*' failed\\.$"), 1, 2, -1),
+        ErrorFormat("Assertion `", QStringLiteral("^.+: (.+):([1-9][0-9]*): .*: Assertion `.*' failed\\.$"), 1, 2, -1),
 
         // END: C++
 
@@ -408,9 +420,9 @@ FilteredItem NativeAppErrorFilterStrategy::errorInLine(const QString& line)
 
         // QObject::connect related errors, also see err_method_notfound() in qobject.cpp
         // QObject::connect: No such slot Foo::bar() in /foo/bar.cpp:313
-        ErrorFormat(QStringLiteral("QObject::connect: (?:No such|Parentheses expected,) (?:slot|signal) [^ ]* in (.*):([0-9]+)"), 1, 2, -1),
+        ErrorFormat("QObject::connect: ", QStringLiteral("QObject::connect: (?:No such|Parentheses expected,) (?:slot|signal) [^ ]* in (.*):([0-9]+)"), 1, 2, -1),
         // ASSERT: "errors().isEmpty()" in file /foo/bar.cpp, line 49
-        ErrorFormat(QStringLiteral("ASSERT: \"(.*)\" in file (.*), line ([0-9]+)"), 2, 3, -1),
+        ErrorFormat("ASSERT: \"", QStringLiteral("ASSERT: \"(.*)\" in file (.*), line ([0-9]+)"), 2, 3, -1),
         // Catch:
         // FAIL!  : FooTest::testBar() Compared pointers are not the same
         //    Actual   ...
@@ -420,14 +432,14 @@ FilteredItem NativeAppErrorFilterStrategy::errorInLine(const QString& line)
         // Do *not* catch:
         //    ...
         //    Loc: [Unknown file(0)]
-        ErrorFormat(QStringLiteral("   Loc: \\[(.*)\\(([1-9][0-9]*)\\)\\]"), 1, 2, -1),
+        ErrorFormat("   Loc: [", QStringLiteral("   Loc: \\[(.*)\\(([1-9][0-9]*)\\)\\]"), 1, 2, -1),
 
         // file:///path/to/foo.qml:7:1: Bar is not a type
         // file:///path/to/foo.qml:49:5: QML Row: Binding loop detected for property "height"
-        ErrorFormat(QStringLiteral("(file:\\/\\/(?:[^:]+)):([1-9][0-9]*):([1-9][0-9]*): (.*) (?:is not a type|is ambiguous|is instantiated recursively|Binding loop detected)"), 1, 2, -1, 3),
+        ErrorFormat("file://", QStringLiteral("(file:\\/\\/(?:[^:]+)):([1-9][0-9]*):([1-9][0-9]*): (.*) (?:is not a type|is ambiguous|is instantiated recursively|Binding loop detected)"), 1, 2, -1, 3),
 
         // file:///path/to/foo.qml:52: TypeError: Cannot read property 'height' of null
-        ErrorFormat(QStringLiteral("(file:\\/\\/(?:[^:]+)):([1-9][0-9]*): ([a-zA-Z]+)Error"), 1, 2, -1),
+        ErrorFormat("file://", QStringLiteral("(file:\\/\\/(?:[^:]+)):([1-9][0-9]*): ([a-zA-Z]+)Error"), 1, 2, -1),
 
         // END: Qt
     };
@@ -451,11 +463,11 @@ FilteredItem StaticAnalysisFilterStrategy::errorInLine(const QString& line)
     // A list of filters for static analysis tools (krazy2, cppcheck)
     static const ErrorFormat STATIC_ANALYSIS_FILTERS[] = {
         // CppCheck
-        ErrorFormat( QStringLiteral("^\\[(.*):([0-9]+)\\]:(.*)"), 1, 2, 3 ),
+        ErrorFormat( LinePrefilter::ColonNumber, QStringLiteral("^\\[(.*):([0-9]+)\\]:(.*)"), 1, 2, 3 ),
         // krazy2
-        ErrorFormat( QStringLiteral("^\\t([^:]+).*line#([0-9]+).*"), 1, 2, -1 ),
+        ErrorFormat( "line#", QStringLiteral("^\\t([^:]+).*line#([0-9]+).*"), 1, 2, -1 ),
         // krazy2 without line info
-        ErrorFormat( QStringLiteral("^\\t(.*): missing license"), 1, -1, -1 )
+        ErrorFormat( ": missing license", QStringLiteral("^\\t(.*): missing license"), 1, -1, -1 )
     };
 
     return match(STATIC_ANALYSIS_FILTERS, line);
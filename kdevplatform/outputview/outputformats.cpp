@@ -17,34 +17,92 @@
 namespace KDevelop
 {
 
-ErrorFormat::ErrorFormat( const QString& regExp, int file, int line, int text, int column )
-    : expression( regExp )
+LinePrefilter::LinePrefilter( Feature feature )
+    : feature( feature )
+{
+}
+
+LinePrefilter::LinePrefilter( const char* literal )
+{
+    literals << QLatin1String( literal );
+}
+
+LinePrefilter::LinePrefilter( std::initializer_list<const char*> literals )
+{
+    this->literals.reserve( literals.size() );
+    for( const char* literal : literals ) {
+        this->literals << QLatin1String( literal );
+    }
+}
+
+int LinePrefilter::lineFeatures( const QString& line )
+{
+    int features = NoFeature;
+    const QChar* it = line.constData();
+    const QChar* const end = it + line.size();
+    for( ; it + 1 < end; ++it ) {
+        const ushort c = it->unicode();
+        if( (c == ':' || c == '(') && (it + 1)->isDigit() ) {
+            features |= (c == ':') ? ColonNumber : ParenNumber;
+        }
+    }
+    return features;
+}
+
+bool LinePrefilter::accepts( const QString& line, int lineFeatures ) const
+{
+    if( feature == NoFeature && literals.isEmpty() ) {
+        return true;
+    }
+    if( lineFeatures & feature ) {
+        return true;
+    }
+    for( const QLatin1String& literal : literals ) {
+        if( line.contains( literal ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ErrorFormat::ErrorFormat( const LinePrefilter& prefilter, const QString& regExp, int file, int line, int text, int column )
+    : prefilter( prefilter )
+    , expression( regExp )
     , fileGroup( file )
     , lineGroup( line )
     , columnGroup( column )
     , textGroup( text )
-{}
+{
+    expression.optimize();
+}
 
-ErrorFormat::ErrorFormat( const QString& regExp, int file, int line, int text, const QString& comp, int column )
-    : expression( regExp )
+ErrorFormat::ErrorFormat( const LinePrefilter& prefilter, const QString& regExp, int file, int line, int text, const QString& comp, int column )
+    : prefilter( prefilter )
+    , expression( regExp )
     , fileGroup( file )
     , lineGroup( line )
     , columnGroup( column )
     , textGroup( text )
     , compiler( comp )
-{}
+{
+    expression.optimize();
+}
 
-ActionFormat::ActionFormat(const QString& _tool, const QString& regExp, int file )
-    : expression( regExp )
+ActionFormat::ActionFormat( const LinePrefilter& prefilter, const QString& _tool, const QString& regExp, int file )
+    : prefilter( prefilter )
+    , expression( regExp )
     , tool( _tool )
     , fileGroup( file )
 {
+    expression.optimize();
 }
 
-ActionFormat::ActionFormat(int file, const QString& regExp)
-    : expression( regExp )
+ActionFormat::ActionFormat( const LinePrefilter& prefilter, int file, const QString& regExp )
+    : prefilter( prefilter )
+    , expression( regExp )
     , fileGroup( file )
 {
+    expression.optimize();
 }
 
 int ErrorFormat::columnNumber(const QRegularExpressionMatch& match) const
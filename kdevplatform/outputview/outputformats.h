@@ -14,15 +14,49 @@
 
 #include <QString>
 #include <QRegularExpression>
+#include <QVector>
+
+#include <initializer_list>
 
 namespace KDevelop
 {
 
+/**
+ * Cheap necessary condition for a line to match a format, checked before
+ * the regular expression runs. Most output lines match no format at all,
+ * so they never reach the regular expressions.
+ *
+ * A line passes if it contains any of the literals, or has the feature.
+ * A default constructed prefilter lets every line pass.
+ */
+struct LinePrefilter
+{
+    enum Feature {
+        NoFeature = 0,
+        ColonNumber = 1, ///< ':' followed by a digit, as in "file.cpp:42"
+        ParenNumber = 2  ///< '(' followed by a digit, as in "file.cpp(42)"
+    };
+
+    LinePrefilter() = default;
+    LinePrefilter( Feature feature );
+    LinePrefilter( const char* literal );
+    LinePrefilter( std::initializer_list<const char*> literals );
+
+    /// Features of @p line, to be computed once per line
+    static int lineFeatures( const QString& line );
+
+    bool accepts( const QString& line, int lineFeatures ) const;
+
+    QVector<QLatin1String> literals;
+    Feature feature = NoFeature;
+};
+
 struct ActionFormat
 {
     ActionFormat() = default;
-    ActionFormat( const QString& _tool, const QString& regExp, int file );
-    ActionFormat( int file, const QString& regExp );
+    ActionFormat( const LinePrefilter& prefilter, const QString& _tool, const QString& regExp, int file );
+    ActionFormat( const LinePrefilter& prefilter, int file, const QString& regExp );
+    LinePrefilter prefilter;
     QRegularExpression expression;
     QString tool;
     int fileGroup;
@@ -31,8 +65,9 @@ struct ActionFormat
 struct ErrorFormat
 {
     ErrorFormat() = default;
-    ErrorFormat( const QString& regExp, int file, int line, int text, int column=-1 );
-    ErrorFormat( const QString& regExp, int file, int line, int text, const QString& comp, int column=-1 );
+    ErrorFormat( const LinePrefilter& prefilter, const QString& regExp, int file, int line, int text, int column=-1 );
+    ErrorFormat( const LinePrefilter& prefilter, const QString& regExp, int file, int line, int text, const QString& comp, int column=-1 );
+    LinePrefilter prefilter;
     QRegularExpression expression;
     int fileGroup;
     int lineGroup, columnGroup;
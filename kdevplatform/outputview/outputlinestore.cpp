@@ -0,0 +1,213 @@
+/***************************************************************************
+ *   This file is part of KDevelop                                         *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Library General Public License as       *
+ *   published by the Free Software Foundation; either version 2 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this program; if not, write to the                 *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.         *
+ ***************************************************************************/
+
+#include "outputlinestore.h"
+#include "debug.h"
+
+#include <QDir>
+#include <QTemporaryFile>
+
+#include <algorithm>
+
+namespace KDevelop
+{
+
+/// Number of lines packed into one chunk
+static const int CHUNK_SIZE = 1024;
+
+/// Number of spilled chunks kept in memory after reading them back
+static const int LOADED_CHUNKS_CACHE_SIZE = 8;
+
+static qint64 chunkBytes(const QString& text, const QVector<int>& offsets)
+{
+    return text.capacity() * qint64(sizeof(QChar)) + offsets.capacity() * qint64(sizeof(int));
+}
+
+OutputLineStore::OutputLineStore(qint64 memoryLimit)
+    : m_memoryLimit(memoryLimit)
+    , m_loadedChunks(LOADED_CHUNKS_CACHE_SIZE)
+{
+}
+
+OutputLineStore::~OutputLineStore() = default;
+
+void OutputLineStore::append(const FilteredItem& item)
+{
+    if (m_count % CHUNK_SIZE == 0) {
+        if (!m_chunks.isEmpty()) {
+            // the previous chunk is complete, it will not grow anymore
+            Chunk& last = m_chunks.last();
+            m_residentBytes -= chunkBytes(last.text, last.offsets);
+            last.text.squeeze();
+            last.offsets.squeeze();
+            m_residentBytes += chunkBytes(last.text, last.offsets);
+            enforceMemoryLimit();
+        }
+        m_chunks.append(Chunk());
+        Chunk& chunk = m_chunks.last();
+        chunk.offsets.reserve(CHUNK_SIZE + 1);
+        chunk.offsets.append(0);
+        chunk.types.reserve(CHUNK_SIZE);
+        m_residentBytes += chunkBytes(chunk.text, chunk.offsets);
+    }
+
+    Chunk& chunk = m_chunks.last();
+    m_residentBytes -= chunkBytes(chunk.text, chunk.offsets);
+    chunk.text += item.originalLine;
+    chunk.offsets.append(chunk.text.size());
+    chunk.types.append(static_cast<quint8>(item.type));
+    m_residentBytes += chunkBytes(chunk.text, chunk.offsets);
+
+    const int row = m_count++;
+    if (item.type == FilteredItem::ErrorItem) {
+        m_errorRows.append(row);
+    }
+    if (item.isActivatable) {
+        m_activatableRows.append(row);
+        m_locations.append({item.url, item.lineNo, item.columnNo});
+    }
+}
+
+void OutputLineStore::clear()
+{
+    m_chunks.clear();
+    m_count = 0;
+    m_residentBytes = 0;
+    m_firstResidentChunk = 0;
+    m_errorRows.clear();
+    m_activatableRows.clear();
+    m_locations.clear();
+    m_loadedChunks.clear();
+    m_spillFile.reset();
+}
+
+QString OutputLineStore::line(int row) const
+{
+    Q_ASSERT(row >= 0 && row < m_count);
+
+    const int chunkIndex = row / CHUNK_SIZE;
+    const QString* text = chunkText(chunkIndex);
+    if (!text) {
+        return QString();
+    }
+
+    const Chunk& chunk = m_chunks.at(chunkIndex);
+    const int lineIndex = row % CHUNK_SIZE;
+    const int begin = chunk.offsets.at(lineIndex);
+    return text->mid(begin, chunk.offsets.at(lineIndex + 1) - begin);
+}
+
+FilteredItem::FilteredOutputItemType OutputLineStore::type(int row) const
+{
+    Q_ASSERT(row >= 0 && row < m_count);
+
+    return static_cast<FilteredItem::FilteredOutputItemType>(m_chunks.at(row / CHUNK_SIZE).types.at(row % CHUNK_SIZE));
+}
+
+FilteredItem OutputLineStore::item(int row) const
+{
+    FilteredItem item(line(row), type(row));
+
+    auto it = std::lower_bound(m_activatableRows.constBegin(), m_activatableRows.constEnd(), row);
+    if (it != m_activatableRows.constEnd() && *it == row) {
+        const Location& location = m_locations.at(it - m_activatableRows.constBegin());
+        item.isActivatable = true;
+        item.url = location.url;
+        item.lineNo = location.lineNo;
+        item.columnNo = location.columnNo;
+    }
+    return item;
+}
+
+void OutputLineStore::setMemoryLimit(qint64 bytes)
+{
+    m_memoryLimit = bytes;
+    enforceMemoryLimit();
+}
+
+const QString* OutputLineStore::chunkText(int chunkIndex) const
+{
+    const Chunk& chunk = m_chunks.at(chunkIndex);
+    if (chunk.spillPosition < 0) {
+        return chunk.dropped ? nullptr : &chunk.text;
+    }
+
+    if (const QString* text = m_loadedChunks.object(chunkIndex)) {
+        return text;
+    }
+
+    const int size = chunk.offsets.last() * int(sizeof(QChar));
+    if (!m_spillFile->seek(chunk.spillPosition)) {
+        qCWarning(OUTPUTVIEW) << "failed to seek in output spill file" << m_spillFile->errorString();
+        return nullptr;
+    }
+    const QByteArray data = m_spillFile->read(size);
+    if (data.size() != size) {
+        qCWarning(OUTPUTVIEW) << "failed to read from output spill file" << m_spillFile->errorString();
+        return nullptr;
+    }
+
+    auto* text = new QString(reinterpret_cast<const QChar*>(data.constData()), chunk.offsets.last());
+    m_loadedChunks.insert(chunkIndex, text);
+    return text;
+}
+
+void OutputLineStore::enforceMemoryLimit()
+{
+    // the last chunk is still being filled, it always stays in memory
+    while (m_residentBytes > m_memoryLimit && m_firstResidentChunk < m_chunks.size() - 1) {
+        Chunk& chunk = m_chunks[m_firstResidentChunk++];
+        const qint64 bytes = chunk.text.capacity() * qint64(sizeof(QChar));
+        if (!spill(chunk)) {
+            chunk.dropped = true;
+        }
+        chunk.text = QString();
+        m_residentBytes -= bytes;
+    }
+}
+
+bool OutputLineStore::spill(Chunk& chunk)
+{
+    if (!m_spillFile) {
+        m_spillFile.reset(new QTemporaryFile(QDir::tempPath() + QLatin1String("/kdevelop-output-XXXXXX")));
+        if (!m_spillFile->open()) {
+            qCWarning(OUTPUTVIEW) << "failed to open output spill file, dropping old output"
+                                  << m_spillFile->errorString();
+            return false;
+        }
+    }
+    if (!m_spillFile->isOpen()) {
+        return false;
+    }
+
+    const qint64 position = m_spillFile->size();
+    const qint64 size = chunk.text.size() * qint64(sizeof(QChar));
+    if (!m_spillFile->seek(position)
+        || m_spillFile->write(reinterpret_cast<const char*>(chunk.text.constData()), size) != size) {
+        qCWarning(OUTPUTVIEW) << "failed to write output spill file, dropping old output"
+                              << m_spillFile->errorString();
+        m_spillFile->close();
+        return false;
+    }
+
+    chunk.spillPosition = position;
+    return true;
+}
+
+}
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   This file is part of KDevelop                                         *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU Library General Public License as       *
+ *   published by the Free Software Foundation; either version 2 of the    *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this program; if not, write to the                 *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.         *
+ ***************************************************************************/
+
+#ifndef KDEVPLATFORM_OUTPUTLINESTORE_H
+#define KDEVPLATFORM_OUTPUTLINESTORE_H
+
+#include "filtereditem.h"
+
+#include <QCache>
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+
+class QTemporaryFile;
+
+namespace KDevelop
+{
+
+/**
+ * Append-only storage for the lines of an OutputModel.
+ *
+ * Lines are packed into chunks of one string each, so a line costs its
+ * characters plus an offset and a type byte instead of a whole FilteredItem.
+ * The location of activatable lines is kept separately, in row order.
+ *
+ * Once the text held in memory exceeds the memory limit, the oldest complete
+ * chunks are written to a temporary file and read back on demand. If that
+ * file cannot be written, their text is dropped instead, so the limit holds
+ * in any case.
+ */
+class OutputLineStore
+{
+public:
+    /// Default limit of the line text kept in memory, in bytes
+    static const qint64 DefaultMemoryLimit = 64 * 1024 * 1024;
+
+    explicit OutputLineStore(qint64 memoryLimit = DefaultMemoryLimit);
+    ~OutputLineStore();
+
+    void append(const FilteredItem& item);
+    void clear();
+
+    int count() const { return m_count; }
+
+    QString line(int row) const;
+    FilteredItem::FilteredOutputItemType type(int row) const;
+    /// Recreates the full item of @p row, only to be used for single lines
+    FilteredItem item(int row) const;
+
+    /// Rows of error items, ascending
+    const QVector<int>& errorRows() const { return m_errorRows; }
+    /// Rows of activatable items, ascending
+    const QVector<int>& activatableRows() const { return m_activatableRows; }
+
+    void setMemoryLimit(qint64 bytes);
+    qint64 memoryLimit() const { return m_memoryLimit; }
+    /// Bytes of line text currently held in memory
+    qint64 residentBytes() const { return m_residentBytes; }
+
+private:
+    struct Chunk
+    {
+        QString text;
+        /// Start of each line in text, followed by the end of the last one
+        QVector<int> offsets;
+        QVector<quint8> types;
+        /// Position of the text in the spill file, -1 if resident
+        qint64 spillPosition = -1;
+        bool dropped = false;
+    };
+
+    struct Location
+    {
+        QUrl url;
+        int lineNo;
+        int columnNo;
+    };
+
+    const QString* chunkText(int chunkIndex) const;
+    void enforceMemoryLimit();
+    bool spill(Chunk& chunk);
+
+    QVector<Chunk> m_chunks;
+    int m_count = 0;
+    qint64 m_memoryLimit;
+    qint64 m_residentBytes = 0;
+    /// First chunk that may still be resident
+    int m_firstResidentChunk = 0;
+
+    QVector<int> m_errorRows;
+    QVector<int> m_activatableRows;
+    QVector<Location> m_locations; // index matching m_activatableRows
+
+    QScopedPointer<QTemporaryFile> m_spillFile;
+    mutable QCache<int, QString> m_loadedChunks;
+};
+
+}
+
+#endif // KDEVPLATFORM_OUTPUTLINESTORE_H
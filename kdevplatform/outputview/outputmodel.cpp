@@ -23,6 +23,7 @@
 #include "outputmodel.h"
 #include "filtereditem.h"
 #include "outputfilteringstrategies.h"
+#include "outputlinestore.h"
 #include "debug.h"
 
 #include <interfaces/icore.h>
@@ -35,8 +36,8 @@
 #include <QFont>
 #include <QFontDatabase>
 
+#include <algorithm>
 #include <functional>
-#include <set>
 
 namespace KDevelop
 {
@@ -187,25 +188,39 @@ public:
     OutputModel* model;
     ParseWorker* worker;
 
-    QVector<FilteredItem> m_filteredItems;
-    // We use std::set because that is ordered
-    std::set<int> m_errorItems; // Indices of all items that we want to move to using previous and next
+    // Lines with their type, error items and activatable items are
+    // tracked in ascending row order to move to them using previous and next
+    OutputLineStore m_lines;
     QUrl m_buildDir;
 
     void linesParsed(const QVector<KDevelop::FilteredItem>& items)
     {
         model->beginInsertRows( QModelIndex(), model->rowCount(), model->rowCount() + items.size() -  1);
 
-        m_filteredItems.reserve(m_filteredItems.size() + items.size());
         for (const FilteredItem& item : items) {
-            if( item.type == FilteredItem::ErrorItem ) {
-                m_errorItems.insert(m_filteredItems.size());
-            }
-            m_filteredItems << item;
+            m_lines.append(item);
         }
 
         model->endInsertRows();
     }
+
+    /// First row in @p rows after @p row, wrapping around
+    static int nextRow(const QVector<int>& rows, int row)
+    {
+        auto next = std::upper_bound(rows.constBegin(), rows.constEnd(), row);
+        if (next == rows.constEnd())
+            next = rows.constBegin();
+        return *next;
+    }
+
+    /// Last row in @p rows before @p row, wrapping around
+    static int previousRow(const QVector<int>& rows, int row)
+    {
+        auto previous = std::lower_bound(rows.constBegin(), rows.constEnd(), row);
+        if (previous == rows.constBegin())
+            previous = rows.constEnd();
+        return *(--previous);
+    }
 };
 
 OutputModelPrivate::OutputModelPrivate( OutputModel* model_, const QUrl& builddir)
@@ -259,9 +274,9 @@ QVariant OutputModel::data(const QModelIndex& idx , int role ) const
         switch( role )
         {
             case Qt::DisplayRole:
-                return d->m_filteredItems.at( idx.row() ).originalLine;
+                return d->m_lines.line( idx.row() );
             case OutputModel::OutputItemTypeRole:
-                return static_cast<int>(d->m_filteredItems.at( idx.row() ).type);
+                return static_cast<int>(d->m_lines.type( idx.row() ));
             case Qt::FontRole:
                 return QFontDatabase::systemFont(QFontDatabase::FixedFont);
         }
@@ -274,7 +289,7 @@ int OutputModel::rowCount( const QModelIndex& parent ) const
     Q_D(const OutputModel);
 
     if( !parent.isValid() )
-        return d->m_filteredItems.count();
+        return d->m_lines.count();
     return 0;
 }
 
@@ -294,7 +309,7 @@ void OutputModel::activate( const QModelIndex& index )
     qCDebug(OUTPUTVIEW) << "Model activated" << index.row();
 
 
-    FilteredItem item = d->m_filteredItems.at( index.row() );
+    FilteredItem item = d->m_lines.item( index.row() );
     if( item.isActivatable )
     {
         qCDebug(OUTPUTVIEW) << "activating:" << item.lineNo << item.url;
@@ -319,14 +334,12 @@ QModelIndex OutputModel::firstHighlightIndex()
 {
     Q_D(OutputModel);
 
-    if( !d->m_errorItems.empty() ) {
-        return index( *d->m_errorItems.begin(), 0, QModelIndex() );
+    if( !d->m_lines.errorRows().isEmpty() ) {
+        return index( d->m_lines.errorRows().first(), 0, QModelIndex() );
     }
 
-    for( int row = 0; row < rowCount(); ++row ) {
-        if( d->m_filteredItems.at( row ).isActivatable ) {
-            return index( row, 0, QModelIndex() );
-        }
+    if( !d->m_lines.activatableRows().isEmpty() ) {
+        return index( d->m_lines.activatableRows().first(), 0, QModelIndex() );
     }
 
     return QModelIndex();
@@ -336,26 +349,18 @@ QModelIndex OutputModel::nextHighlightIndex( const QModelIndex &currentIdx )
 {
     Q_D(OutputModel);
 
-    int startrow = d->isValidIndex(currentIdx, rowCount()) ? currentIdx.row() + 1 : 0;
+    int currentRow = d->isValidIndex(currentIdx, rowCount()) ? currentIdx.row() : -1;
 
-    if( !d->m_errorItems.empty() )
+    if( !d->m_lines.errorRows().isEmpty() )
     {
         qCDebug(OUTPUTVIEW) << "searching next error";
         // Jump to the next error item
-        auto next = d->m_errorItems.lower_bound( startrow );
-        if( next == d->m_errorItems.end() )
-            next = d->m_errorItems.begin();
-
-        return index( *next, 0, QModelIndex() );
+        return index( d->nextRow(d->m_lines.errorRows(), currentRow), 0, QModelIndex() );
     }
 
-    for( int row = 0; row < rowCount(); ++row )
+    if( !d->m_lines.activatableRows().isEmpty() )
     {
-        int currow = (startrow + row) % rowCount();
-        if( d->m_filteredItems.at( currow ).isActivatable )
-        {
-            return index( currow, 0, QModelIndex() );
-        }
+        return index( d->nextRow(d->m_lines.activatableRows(), currentRow), 0, QModelIndex() );
     }
     return QModelIndex();
 }
@@ -364,31 +369,19 @@ QModelIndex OutputModel::previousHighlightIndex( const QModelIndex &currentIdx )
 {
     Q_D(OutputModel);
 
-    //We have to ensure that startrow is >= rowCount - 1 to get a positive value from the % operation.
-    int startrow = rowCount() + (d->isValidIndex(currentIdx, rowCount()) ? currentIdx.row() : rowCount()) - 1;
+    int currentRow = d->isValidIndex(currentIdx, rowCount()) ? currentIdx.row() : rowCount();
 
-    if(!d->m_errorItems.empty())
+    if( !d->m_lines.errorRows().isEmpty() )
     {
         qCDebug(OUTPUTVIEW) << "searching previous error";
 
         // Jump to the previous error item
-        auto previous = d->m_errorItems.lower_bound( currentIdx.row() );
-
-        if( previous == d->m_errorItems.begin() )
-            previous = d->m_errorItems.end();
-
-        --previous;
-
-        return index( *previous, 0, QModelIndex() );
+        return index( d->previousRow(d->m_lines.errorRows(), currentRow), 0, QModelIndex() );
     }
 
-    for ( int row = 0; row < rowCount(); ++row )
+    if( !d->m_lines.activatableRows().isEmpty() )
     {
-        int currow = (startrow - row) % rowCount();
-        if( d->m_filteredItems.at( currow ).isActivatable )
-        {
-            return index( currow, 0, QModelIndex() );
-        }
+        return index( d->previousRow(d->m_lines.activatableRows(), currentRow), 0, QModelIndex() );
     }
     return QModelIndex();
 }
@@ -397,14 +390,12 @@ QModelIndex OutputModel::lastHighlightIndex()
 {
     Q_D(OutputModel);
 
-    if( !d->m_errorItems.empty() ) {
-        return index( *d->m_errorItems.rbegin(), 0, QModelIndex() );
+    if( !d->m_lines.errorRows().isEmpty() ) {
+        return index( d->m_lines.errorRows().last(), 0, QModelIndex() );
     }
 
-    for( int row = rowCount()-1; row >=0; --row ) {
-        if( d->m_filteredItems.at( row ).isActivatable ) {
-            return index( row, 0, QModelIndex() );
-        }
+    if( !d->m_lines.activatableRows().isEmpty() ) {
+        return index( d->m_lines.activatableRows().last(), 0, QModelIndex() );
     }
 
     return QModelIndex();
@@ -479,10 +470,17 @@ void OutputModel::clear()
 
     ensureAllDone();
     beginResetModel();
-    d->m_filteredItems.clear();
+    d->m_lines.clear();
     endResetModel();
 }
 
+void OutputModel::setMemoryLimit(qint64 bytes)
+{
+    Q_D(OutputModel);
+
+    d->m_lines.setMemoryLimit(bytes);
+}
+
 }
 
 #include "outputmodel.moc"
@@ -74,6 +74,13 @@ public:
     void setFilteringStrategy(const OutputFilterStrategy& currentStrategy);
     void setFilteringStrategy(IFilterStrategy* filterStrategy);
 
+    /**
+     * Limits the memory used for the text of the lines, in bytes.
+     * Beyond the limit the oldest lines are moved to a temporary file.
+     * The default is 64 MiB.
+     */
+    void setMemoryLimit(qint64 bytes);
+
 public Q_SLOTS:
     void appendLine( const QString& );
     void appendLines( const QStringList& );
@@ -19,6 +19,7 @@
 #include "test_outputmodel.h"
 #include "testlinebuilderfunctions.h"
 #include "../outputmodel.h"
+#include "../filtereditem.h"
 
 #include <QTest>
 
@@ -122,4 +123,57 @@ void TestOutputModel::bench_data()
     QTest::newRow("static-analysis-filter-longline") << OutputModel::StaticAnalysisFilter << longLine;
 }
 
+void TestOutputModel::testSpilledLines()
+{
+    OutputModel testee(QUrl::fromLocalFile(QStringLiteral("/tmp/build-foo")));
+    testee.setFilteringStrategy(OutputModel::CompilerFilter);
+    // keep no complete chunk of lines in memory
+    testee.setMemoryLimit(1);
+
+    QStringList lines;
+    for (int i = 0; i < 5000; ++i) {
+        lines << ((i % 1000 == 999) ? buildCompilerErrorLine() : QStringLiteral("line %1").arg(i));
+    }
+    testee.appendLines(lines);
+    QTRY_COMPARE(testee.rowCount(), lines.count());
+
+    for (int row : {0, 1, 999, 1023, 1024, 2500, 4999}) {
+        const QModelIndex index = testee.index(row, 0);
+        QCOMPARE(index.data().toString(), lines.at(row));
+        QCOMPARE(index.data(OutputModel::OutputItemTypeRole).toInt() == FilteredItem::ErrorItem,
+                 row % 1000 == 999);
+    }
+
+    testee.clear();
+    QCOMPARE(testee.rowCount(), 0);
+    testee.appendLines(lines.mid(0, 10));
+    QTRY_COMPARE(testee.rowCount(), 10);
+    QCOMPARE(testee.index(9, 0).data().toString(), lines.at(9));
+}
+
+void TestOutputModel::testHighlightNavigation()
+{
+    OutputModel testee(QUrl::fromLocalFile(QStringLiteral("/tmp/build-foo")));
+    testee.setFilteringStrategy(OutputModel::CompilerFilter);
+
+    QCOMPARE(testee.firstHighlightIndex(), QModelIndex());
+
+    QStringList lines;
+    for (int i = 0; i < 3000; ++i) {
+        lines << ((i == 10 || i == 2000) ? buildCompilerErrorLine() : QStringLiteral("line %1").arg(i));
+    }
+    testee.appendLines(lines);
+    QTRY_COMPARE(testee.rowCount(), lines.count());
+
+    QCOMPARE(testee.firstHighlightIndex().row(), 10);
+    QCOMPARE(testee.lastHighlightIndex().row(), 2000);
+    QCOMPARE(testee.nextHighlightIndex(QModelIndex()).row(), 10);
+    QCOMPARE(testee.nextHighlightIndex(testee.index(10, 0)).row(), 2000);
+    QCOMPARE(testee.nextHighlightIndex(testee.index(2000, 0)).row(), 10);
+    QCOMPARE(testee.previousHighlightIndex(QModelIndex()).row(), 2000);
+    QCOMPARE(testee.previousHighlightIndex(testee.index(2000, 0)).row(), 10);
+    QCOMPARE(testee.previousHighlightIndex(testee.index(10, 0)).row(), 2000);
+    QCOMPARE(testee.previousHighlightIndex(testee.index(500, 0)).row(), 10);
+}
+
 }
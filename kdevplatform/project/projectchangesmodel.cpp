@@ -21,6 +21,7 @@
 
 #include "debug.h"
 
+#include <KConfigGroup>
 #include <KLocalizedString>
 
 #include <vcs/interfaces/ibasicversioncontrol.h>
@@ -34,19 +35,29 @@
 #include <vcs/vcsjob.h>
 #include <interfaces/iruncontroller.h>
 #include <interfaces/idocumentcontroller.h>
+#include <interfaces/isession.h>
 #include <project/projectmodel.h>
 #include <util/path.h>
 
 #include <QDir>
 #include <QIcon>
+#include <QTimer>
 
 #include <array>
 
 using namespace KDevelop;
 
+/// Time in ms to collect reload requests, e.g. of a "Save All", before starting status jobs
+static const int RELOAD_DELAY = 300;
+
 ProjectChangesModel::ProjectChangesModel(QObject* parent)
     : VcsFileChangesModel(parent)
+    , m_reloadTimer(new QTimer(this))
 {
+    m_reloadTimer->setSingleShot(true);
+    m_reloadTimer->setInterval(RELOAD_DELAY);
+    connect(m_reloadTimer, &QTimer::timeout, this, &ProjectChangesModel::flushPendingReloads);
+
     const auto projects = ICore::self()->projectController()->projects();
     for (IProject* p : projects) {
         addProject(p);
@@ -95,19 +106,70 @@ void ProjectChangesModel::addProject(IProject* p)
     }
     
     appendRow(it);
+
+    if (plugin) {
+        // shown until the status job scheduled above replaces them
+        restoreStates(p, it);
+    }
 }
 
 void ProjectChangesModel::removeProject(IProject* p)
 {
+    m_pendingReloads.remove(p);
+    m_runningRecursiveReloads.remove(p);
+
     QStandardItem* it=projectItem(p);
     if (!it) {
         // when the project is closed before it was fully populated, we won't ever see a
         // projectOpened signal - handle this gracefully by just ignoring the remove request
         return;
     }
+    saveStates(p, it);
     removeRow(it->row());
 }
 
+void ProjectChangesModel::saveStates(IProject* project, QStandardItem* item) const
+{
+    if (!ICore::self()->activeSession()) {
+        return;
+    }
+
+    KConfigGroup group = ICore::self()->activeSession()->config()->group("Project Changes").group(project->name());
+    QStringList files;
+    QList<int> states;
+    for (int i = 0, c = item->rowCount(); i < c; ++i) {
+        const QModelIndex idx = indexFromItem(item->child(i));
+        files << idx.data(UrlRole).toUrl().toString();
+        states << int(idx.data(StateRole).value<VcsStatusInfo::State>());
+    }
+    group.writeEntry("Files", files);
+    group.writeEntry("States", states);
+}
+
+void ProjectChangesModel::restoreStates(IProject* project, QStandardItem* item)
+{
+    if (!ICore::self()->activeSession()) {
+        return;
+    }
+
+    const KConfigGroup group = ICore::self()->activeSession()->config()->group("Project Changes").group(project->name());
+    const QStringList files = group.readEntry("Files", QStringList());
+    const QList<int> states = group.readEntry("States", QList<int>());
+    if (files.size() != states.size()) {
+        return;
+    }
+
+    QList<VcsStatusInfo> statuses;
+    statuses.reserve(files.size());
+    for (int i = 0; i < files.size(); ++i) {
+        VcsStatusInfo status;
+        status.setUrl(QUrl(files.at(i)));
+        status.setState(VcsStatusInfo::State(states.at(i)));
+        statuses << status;
+    }
+    updateStates(item, statuses);
+}
+
 QStandardItem* findItemChild(QStandardItem* parent, const QVariant& value, int role = Qt::DisplayRole)
 {
     for(int i=0; i<parent->rowCount(); i++) {
@@ -143,7 +205,10 @@ void ProjectChangesModel::changes(IProject* project, const QList<QUrl>& urls, IB
         job->setProperty("mode", QVariant::fromValue<int>(mode));
         job->setProperty("project", QVariant::fromValue(project));
         connect(job, &VcsJob::finished, this, &ProjectChangesModel::statusReady);
-        
+
+        if (mode == IBasicVersionControl::Recursive) {
+            m_runningRecursiveReloads.insert(project);
+        }
         ICore::self()->runController()->registerJob(job);
     }
 }
@@ -152,18 +217,15 @@ void ProjectChangesModel::statusReady(KJob* job)
 {
     auto* status=static_cast<VcsJob*>(job);
 
-    const QList<QVariant> states = status->fetchResults().toList();
     auto* project = job->property("project").value<KDevelop::IProject*>();
     if(!project)
         return;
 
-    QSet<QUrl> foundUrls;
-    foundUrls.reserve(states.size());
-    for (const QVariant& state : states) {
-        const VcsStatusInfo st = state.value<VcsStatusInfo>();
-        foundUrls += st.url();
-
-        updateState(project, st);
+    IBasicVersionControl::RecursionMode mode = IBasicVersionControl::RecursionMode(job->property("mode").toInt());
+    if (mode == IBasicVersionControl::Recursive && m_runningRecursiveReloads.remove(project)
+        && m_pendingReloads.contains(project)) {
+        // requests held back while this job was running
+        m_reloadTimer->start();
     }
 
     QStandardItem* itProject = projectItem(project);
@@ -172,7 +234,17 @@ void ProjectChangesModel::statusReady(KJob* job)
         return;
     }
 
-    IBasicVersionControl::RecursionMode mode = IBasicVersionControl::RecursionMode(job->property("mode").toInt());
+    const QList<QVariant> states = status->fetchResults().toList();
+    QList<VcsStatusInfo> statuses;
+    statuses.reserve(states.size());
+    QSet<QUrl> foundUrls;
+    foundUrls.reserve(states.size());
+    for (const QVariant& state : states) {
+        const VcsStatusInfo st = state.value<VcsStatusInfo>();
+        foundUrls += st.url();
+        statuses << st;
+    }
+
     const QList<QUrl> projectUrls = urls(itProject);
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
     const QSet<QUrl> uncertainUrls = QSet<QUrl>(projectUrls.begin(), projectUrls.end()).subtract(foundUrls);
@@ -186,11 +258,17 @@ void ProjectChangesModel::statusReady(KJob* job)
                 if((mode == IBasicVersionControl::NonRecursive && currentUrl.adjusted(QUrl::RemoveFilename | QUrl::StripTrailingSlash) == url.adjusted(QUrl::StripTrailingSlash))
                     || (mode == IBasicVersionControl::Recursive && url.isParentOf(currentUrl))
                 ) {
-                    removeUrl(currentUrl);
+                    VcsStatusInfo unchanged;
+                    unchanged.setUrl(currentUrl);
+                    unchanged.setState(VcsStatusInfo::ItemUpToDate);
+                    statuses << unchanged;
                 }
             }
         }
     }
+
+    // one pass over the items of the project for all changes
+    updateStates(itProject, statuses);
 }
 
 void ProjectChangesModel::documentSaved(KDevelop::IDocument* document)
@@ -222,13 +300,46 @@ void ProjectChangesModel::itemsAdded(const QModelIndex& parent, int start, int e
     }
         
     if(!urls.isEmpty())
-        changes(project, urls, KDevelop::IBasicVersionControl::NonRecursive);
+        scheduleReload(project, urls);
+}
+
+void ProjectChangesModel::scheduleReload(IProject* project, const QList<QUrl>& urls)
+{
+    PendingReload& pending = m_pendingReloads[project];
+    if (urls.isEmpty()) {
+        pending.recursive = true;
+        pending.urls.clear();
+    } else if (!pending.recursive) {
+        for (const QUrl& url : urls) {
+            pending.urls.insert(url);
+        }
+    }
+    m_reloadTimer->start();
+}
+
+void ProjectChangesModel::flushPendingReloads()
+{
+    for (auto it = m_pendingReloads.begin(); it != m_pendingReloads.end();) {
+        IProject* project = it.key();
+        if (m_runningRecursiveReloads.contains(project)) {
+            // the running job might have missed these changes, wait for its result
+            ++it;
+            continue;
+        }
+
+        if (it->recursive) {
+            changes(project, {project->path().toUrl()}, KDevelop::IBasicVersionControl::Recursive);
+        } else {
+            changes(project, it->urls.values(), KDevelop::IBasicVersionControl::NonRecursive);
+        }
+        it = m_pendingReloads.erase(it);
+    }
 }
 
 void ProjectChangesModel::reload(const QList<IProject*>& projects)
 {
     for (IProject* project : projects) {
-        changes(project, {project->path().toUrl()}, KDevelop::IBasicVersionControl::Recursive);
+        scheduleReload(project, {});
     }
 }
 
@@ -238,8 +349,7 @@ void ProjectChangesModel::reload(const QList<QUrl>& urls)
         IProject* project=ICore::self()->projectController()->findProjectForUrl(url);
         
         if (project) {
-            // FIXME: merge multiple urls of the same project
-            changes(project, {url}, KDevelop::IBasicVersionControl::NonRecursive);
+            scheduleReload(project, {url});
         }
     }
 }
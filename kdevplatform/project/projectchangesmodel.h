@@ -25,7 +25,11 @@
 
 #include "projectexport.h"
 
+#include <QHash>
+#include <QSet>
+
 class KJob;
+class QTimer;
 namespace KDevelop {
 class IProject;
 class IDocument;
@@ -43,6 +47,11 @@ class KDEVPLATFORMPROJECT_EXPORT ProjectChangesModel : public VcsFileChangesMode
         void changes(KDevelop::IProject* project, const QList<QUrl>& urls, KDevelop::IBasicVersionControl::RecursionMode mode);
         
     public Q_SLOTS:
+        /**
+         * The reload methods only schedule the status updates. Requests
+         * arriving in short succession are merged into one status job per
+         * project, and a project is not reloaded as a whole twice at a time.
+         */
         void reloadAll();
         void reload(const QList<KDevelop::IProject*>& p);
         void reload(const QList<QUrl>& p);
@@ -57,8 +66,26 @@ class KDEVPLATFORMPROJECT_EXPORT ProjectChangesModel : public VcsFileChangesMode
         void repositoryBranchChanged(const QUrl& url);
         void branchNameReady(KDevelop::VcsJob* job);
 
+    private Q_SLOTS:
+        void flushPendingReloads();
+
     private:
+        struct PendingReload
+        {
+            bool recursive = false;
+            QSet<QUrl> urls;
+        };
+
         QStandardItem* projectItem(KDevelop::IProject* p) const;
+        /// Remembers the changed files of @p project in the session, to list them right away when it is opened again
+        void saveStates(KDevelop::IProject* project, QStandardItem* item) const;
+        void restoreStates(KDevelop::IProject* project, QStandardItem* item);
+        /// Reloads @p urls of @p project after a short delay, the whole project if @p urls is empty
+        void scheduleReload(KDevelop::IProject* project, const QList<QUrl>& urls);
+
+        QHash<KDevelop::IProject*, PendingReload> m_pendingReloads;
+        QSet<KDevelop::IProject*> m_runningRecursiveReloads;
+        QTimer* m_reloadTimer;
 };
 
 }
@@ -472,9 +472,22 @@ void ProjectBaseItem::setPath( const Path& path)
         model()->d_func()->pathLookupTable.remove(d->m_pathIndex, this);
     }
 
+    const bool pathChanged = (d->m_path != path);
     d->m_path = path;
     d->m_pathIndex = indexForPath(path);
-    setText( path.lastPathSegment() );
+    const QString text = path.lastPathSegment();
+    if (text == d->text) {
+        // usually the item was just created with this name, share the string with the path
+        // and spare the model a dataChanged() for each new item
+        d->text = text;
+        // the tooltip and the url show the whole path
+        if (pathChanged && d->model) {
+            const QModelIndex idx = index();
+            emit d->model->dataChanged(idx, idx);
+        }
+    } else {
+        setText(text);
+    }
 
     if (model() && d->m_pathIndex) {
         model()->d_func()->pathLookupTable.insert(d->m_pathIndex, this);
@@ -46,29 +46,44 @@ QList<QUrl> ProjectItemContextImpl::urls() const
 QList<ProjectFileItem*> allFiles(ProjectBaseItem* projectItem)
 {
     QList<ProjectFileItem*> files;
-    if ( ProjectFolderItem * folder = projectItem->folder() )
-    {
-        const QList<ProjectFolderItem*> subFolders = folder->folderList();
-        for (auto* subFolder : subFolders) {
-            files += allFiles(subFolder);
-        }
-
-        const QList<ProjectTargetItem*> targets = folder->targetList();
-        for (auto* target : targets) {
-            files += allFiles(target);
-        }
+    forEachFile(projectItem, [&files](ProjectFileItem* file) {
+        files.append(file);
+    });
+    return files;
+}
 
-        files += folder->fileList();
+void forEachFile(ProjectBaseItem* projectItem, const std::function<void(ProjectFileItem*)>& callback)
+{
+    if (ProjectFileItem* file = projectItem->file()) {
+        callback(file);
+        return;
     }
-    else if ( ProjectTargetItem * target = projectItem->target() )
-    {
-        files += target->fileList();
+    const bool isFolder = projectItem->folder();
+    if (!isFolder && !projectItem->target()) {
+        return;
     }
-    else if ( ProjectFileItem * file = projectItem->file() )
-    {
-        files.append( file );
+
+    // sub folders and targets first, then the files of the item itself
+    const int rowCount = projectItem->rowCount();
+    if (isFolder) {
+        for (int i = 0; i < rowCount; ++i) {
+            ProjectBaseItem* child = projectItem->child(i);
+            if (child->folder()) {
+                forEachFile(child, callback);
+            }
+        }
+        for (int i = 0; i < rowCount; ++i) {
+            ProjectBaseItem* child = projectItem->child(i);
+            if (child->target()) {
+                forEachFile(child, callback);
+            }
+        }
+    }
+    for (int i = 0; i < rowCount; ++i) {
+        if (ProjectFileItem* file = projectItem->child(i)->file()) {
+            callback(file);
+        }
     }
-    return files;
 }
 
 }
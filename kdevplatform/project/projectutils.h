@@ -27,6 +27,8 @@
 
 #include <QList>
 
+#include <functional>
+
 class QMenu;
 
 namespace KDevelop {
@@ -51,6 +53,14 @@ private:
  */
 KDEVPLATFORMPROJECT_EXPORT QList<ProjectFileItem*> allFiles(ProjectBaseItem* projectItem);
 
+/**
+ * Calls @p callback for all the files that have @p projectItem as ancestor
+ *
+ * Unlike allFiles() this builds no lists, neither of the files nor of the children on the way.
+ */
+KDEVPLATFORMPROJECT_EXPORT void forEachFile(ProjectBaseItem* projectItem,
+                                            const std::function<void(ProjectFileItem*)>& callback);
+
 }
 
 #endif // KDEVPLATFORM_PROJECTUTILS_H
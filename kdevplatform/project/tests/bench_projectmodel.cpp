@@ -0,0 +1,155 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "bench_projectmodel.h"
+
+#include <interfaces/iprojectcontroller.h>
+#include <project/projectmodel.h>
+#include <project/projectutils.h>
+#include <serialization/indexedstring.h>
+#include <tests/autotestshell.h>
+#include <tests/testcore.h>
+#include <util/path.h>
+
+#include <QDir>
+#include <QTest>
+
+using namespace KDevelop;
+
+namespace {
+// like a source tree, files are spread over folders
+const int filesPerFolder = 1000;
+
+ProjectFolderItem* createTree(ProjectModel* model, int fileCount)
+{
+    auto* root = new ProjectFolderItem(nullptr, Path(QUrl::fromLocalFile(QDir::tempPath() + QLatin1String("/benchproject"))));
+    model->appendRow(root);
+    ProjectFolderItem* folder = nullptr;
+    for (int i = 0; i < fileCount; ++i) {
+        if (i % filesPerFolder == 0) {
+            folder = new ProjectFolderItem(QLatin1String("folder") + QString::number(i / filesPerFolder), root);
+        }
+        new ProjectFileItem(QLatin1String("file") + QString::number(i) + QLatin1String(".cpp"), folder);
+    }
+    return root;
+}
+
+void addCounts()
+{
+    QTest::addColumn<int>("fileCount");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+}
+
+void BenchProjectModel::initTestCase()
+{
+    AutoTestShell::init();
+    TestCore::initialize(Core::NoUi);
+    m_model = ICore::self()->projectController()->projectModel();
+}
+
+void BenchProjectModel::cleanupTestCase()
+{
+    TestCore::shutdown();
+}
+
+void BenchProjectModel::cleanup()
+{
+    m_model->clear();
+}
+
+void BenchProjectModel::benchCreateItems()
+{
+    QFETCH(int, fileCount);
+
+    QBENCHMARK_ONCE {
+        createTree(m_model, fileCount);
+    }
+}
+
+void BenchProjectModel::benchCreateItems_data()
+{
+    addCounts();
+}
+
+void BenchProjectModel::benchItemsForPath()
+{
+    QFETCH(int, fileCount);
+
+    const auto* root = createTree(m_model, fileCount);
+    QVector<IndexedString> paths;
+    const int lookups = 10000;
+    paths.reserve(lookups);
+    for (int i = 0; i < lookups; ++i) {
+        const int file = (i * 7919) % fileCount;
+        Path path(root->path(), QLatin1String("folder") + QString::number(file / filesPerFolder));
+        path.addPath(QLatin1String("file") + QString::number(file) + QLatin1String(".cpp"));
+        paths << IndexedString(path.pathOrUrl());
+    }
+
+    QBENCHMARK {
+        for (const auto& path : qAsConst(paths)) {
+            QCOMPARE(m_model->itemsForPath(path).size(), 1);
+        }
+    }
+}
+
+void BenchProjectModel::benchItemsForPath_data()
+{
+    addCounts();
+}
+
+void BenchProjectModel::benchAllFiles()
+{
+    QFETCH(int, fileCount);
+
+    auto* root = createTree(m_model, fileCount);
+    QBENCHMARK {
+        QCOMPARE(allFiles(root).size(), fileCount);
+    }
+}
+
+void BenchProjectModel::benchAllFiles_data()
+{
+    addCounts();
+}
+
+void BenchProjectModel::benchForEachFile()
+{
+    QFETCH(int, fileCount);
+
+    auto* root = createTree(m_model, fileCount);
+    QBENCHMARK {
+        int files = 0;
+        forEachFile(root, [&files](ProjectFileItem*) {
+            ++files;
+        });
+        QCOMPARE(files, fileCount);
+    }
+}
+
+void BenchProjectModel::benchForEachFile_data()
+{
+    addCounts();
+}
+
+QTEST_MAIN(BenchProjectModel)
@@ -0,0 +1,51 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_BENCH_PROJECTMODEL_H
+#define KDEVPLATFORM_BENCH_PROJECTMODEL_H
+
+#include <QObject>
+
+namespace KDevelop {
+class ProjectModel;
+}
+
+class BenchProjectModel : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void cleanup();
+
+    void benchCreateItems();
+    void benchCreateItems_data();
+    void benchItemsForPath();
+    void benchItemsForPath_data();
+    void benchAllFiles();
+    void benchAllFiles_data();
+    void benchForEachFile();
+    void benchForEachFile_data();
+
+private:
+    KDevelop::ProjectModel* m_model = nullptr;
+};
+
+#endif // KDEVPLATFORM_BENCH_PROJECTMODEL_H
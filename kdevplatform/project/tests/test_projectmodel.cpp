@@ -31,6 +31,7 @@
 
 #include <projectmodel.h>
 #include <projectproxymodel.h>
+#include <projectutils.h>
 #if QT_VERSION < QT_VERSION_CHECK(5, 11, 0)
 #include <tests/modeltest.h>
 #endif
@@ -327,6 +328,14 @@ void TestProjectModel::testItemSanity()
     QCOMPARE( s.count(), 1 );
     QCOMPARE( model->data( parent->index() ).toString(), QStringLiteral("newtest") );
 
+    // a path with the same name in another folder still changes the tooltip and url
+    const Path movedPath(QDir::rootPath() + QStringLiteral("moved/newtest"));
+    parent->setPath(movedPath);
+    QCOMPARE(s.count(), 2);
+    QCOMPARE(model->data(parent->index(), ProjectModel::UrlRole).toUrl(), movedPath.toUrl());
+    parent->setPath(movedPath);
+    QCOMPARE(s.count(), 2);
+
     parent->removeRow( child->row() );
 }
 
@@ -524,6 +533,34 @@ void TestProjectModel::testItemsForPath_data()
     }
 }
 
+void TestProjectModel::testForEachFile()
+{
+    auto* root = new ProjectFolderItem(nullptr, Path(QUrl::fromLocalFile(QDir::tempPath())));
+    auto* rootFile = new ProjectFileItem(QStringLiteral("a"), root);
+    auto* folder = new ProjectFolderItem(QStringLiteral("b"), root);
+    auto* folderFile = new ProjectFileItem(QStringLiteral("c"), folder);
+    auto* target = new ProjectTargetItem(nullptr, QStringLiteral("d"), root);
+    auto* targetFile = new ProjectFileItem(nullptr, rootFile->path(), target);
+    new ProjectFolderItem(QStringLiteral("e"), folder);
+    model->appendRow(root);
+
+    QList<ProjectFileItem*> files;
+    forEachFile(root, [&files](ProjectFileItem* file) {
+        files << file;
+    });
+    const QList<ProjectFileItem*> expected = {folderFile, targetFile, rootFile};
+    QCOMPARE(files, expected);
+    QCOMPARE(allFiles(root), expected);
+
+    files.clear();
+    forEachFile(targetFile, [&files](ProjectFileItem* file) {
+        files << file;
+    });
+    QCOMPARE(files, QList<ProjectFileItem*>{targetFile});
+
+    model->clear();
+}
+
 void TestProjectModel::testProjectProxyModel()
 {
     auto* root = new ProjectFolderItem(nullptr, Path(QUrl::fromLocalFile(QDir::tempPath())));
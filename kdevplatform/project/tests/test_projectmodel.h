@@ -49,6 +49,7 @@ private Q_SLOTS:
     void testTakeRow();
     void testItemsForPath();
     void testItemsForPath_data();
+    void testForEachFile();
     void testProjectProxyModel();
     void testProjectFileSet();
     void testProjectFileIcon();
@@ -27,6 +27,9 @@
 
 #include <KLocalizedString>
 
+#include <QHash>
+#include <QSet>
+
 using namespace KDevelop;
 
 namespace
@@ -61,7 +64,52 @@ public:
     }
 
     /// Add a problem to the appropriate group
-    virtual void addProblem(const IProblem::Ptr &problem) = 0;
+    void addProblem(const IProblem::Ptr &problem)
+    {
+        ProblemStoreNode* parent = parentFor(problem);
+        if (!parent) {
+            parent = createGroup(problem);
+            m_groupedRootNode->addChild(parent);
+        }
+
+        parent->addChild(createNode(problem));
+    }
+
+    /// Returns the node the node of @p problem belongs to, nullptr if that group does not exist yet
+    virtual ProblemStoreNode* parentFor(const IProblem::Ptr &problem) const = 0;
+
+    /// Creates the group for @p problem, which the caller adds to the grouped root node
+    virtual ProblemStoreNode* createGroup(const IProblem::Ptr &problem)
+    {
+        Q_UNUSED(problem);
+        Q_ASSERT_X(false, "GroupingStrategy::createGroup", "strategy has fixed groups");
+        return nullptr;
+    }
+
+    /// Tells if groups are removed once they are empty
+    virtual bool removesEmptyGroups() const
+    {
+        return false;
+    }
+
+    /// Called before the empty @p group is removed
+    virtual void groupRemoved(const ProblemStoreNode *group)
+    {
+        Q_UNUSED(group);
+    }
+
+    /// Creates the node of @p problem, with the nodes of its diagnostics
+    static ProblemStoreNode* createNode(const IProblem::Ptr &problem)
+    {
+        auto *node = new ProblemNode(nullptr, problem);
+        addDiagnostics(node, problem->diagnostics());
+        return node;
+    }
+
+    ProblemStoreNode* groupedRootNode() const
+    {
+        return m_groupedRootNode.data();
+    }
 
     /// Find the specified noe
     const ProblemStoreNode* findNode(int row, ProblemStoreNode *parent = nullptr) const
@@ -103,12 +151,10 @@ public:
     {
     }
 
-    void addProblem(const IProblem::Ptr &problem) override
+    ProblemStoreNode* parentFor(const IProblem::Ptr &problem) const override
     {
-        auto *node = new ProblemNode(m_groupedRootNode.data(), problem);
-        addDiagnostics(node, problem->diagnostics());
-        m_groupedRootNode->addChild(node);
-
+        Q_UNUSED(problem);
+        return m_groupedRootNode.data();
     }
 
 };
@@ -124,28 +170,38 @@ public:
     {
     }
 
-    void addProblem(const IProblem::Ptr &problem) override
+    ProblemStoreNode* parentFor(const IProblem::Ptr &problem) const override
     {
-        QString path = problem->finalLocation().document.str();
+        return m_groups.value(problem->finalLocation().document);
+    }
 
-        /// See if we already have this path
-        const auto childrenNodes = m_groupedRootNode->children();
-        auto it = std::find_if(childrenNodes.begin(), childrenNodes.end(), [&](ProblemStoreNode* node) {
-            return (node->label() == path);
-        });
-        ProblemStoreNode* parent = (it != childrenNodes.end()) ? *it : nullptr;
+    ProblemStoreNode* createGroup(const IProblem::Ptr &problem) override
+    {
+        const IndexedString& document = problem->finalLocation().document;
+        auto *group = new LabelNode(nullptr, document.str());
+        m_groups.insert(document, group);
+        return group;
+    }
 
-        /// If not add it!
-        if (parent == nullptr) {
-            parent = new LabelNode(m_groupedRootNode.data(), path);
-            m_groupedRootNode->addChild(parent);
-        }
+    bool removesEmptyGroups() const override
+    {
+        return true;
+    }
 
-        auto *node = new ProblemNode(parent, problem);
-        addDiagnostics(node, problem->diagnostics());
-        parent->addChild(node);
+    void groupRemoved(const ProblemStoreNode *group) override
+    {
+        m_groups.remove(IndexedString(group->label()));
+    }
+
+    void clear() override
+    {
+        GroupingStrategy::clear();
+        m_groups.clear();
     }
 
+private:
+    /// The group nodes by their path, so they need not be searched
+    QHash<IndexedString, ProblemStoreNode*> m_groups;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -170,20 +226,14 @@ public:
         m_groupedRootNode->addChild(new LabelNode(m_groupedRootNode.data(), i18n("Hint")));
     }
 
-    void addProblem(const IProblem::Ptr &problem) override
+    ProblemStoreNode* parentFor(const IProblem::Ptr &problem) const override
     {
-        ProblemStoreNode *parent = nullptr;
-
         switch (problem->severity()) {
-            case IProblem::Error: parent = m_groupedRootNode->child(GroupError); break;
-            case IProblem::Warning: parent = m_groupedRootNode->child(GroupWarning); break;
-            case IProblem::Hint: parent = m_groupedRootNode->child(GroupHint); break;
-            default: break;
+            case IProblem::Error: return m_groupedRootNode->child(GroupError);
+            case IProblem::Warning: return m_groupedRootNode->child(GroupWarning);
+            // problems without severity pass the filter as hints
+            default: return m_groupedRootNode->child(GroupHint);
         }
-
-        auto *node = new ProblemNode(m_groupedRootNode.data(), problem);
-        addDiagnostics(node, problem->diagnostics());
-        parent->addChild(node);
     }
 
     void clear() override
@@ -214,6 +264,15 @@ public:
     /// Tells if the problem matches the filters
     bool match(const IProblem::Ptr &problem) const;
 
+    /// Removes the nodes of @p problems from the groups, and groups which are empty then
+    void removeProblems(const QVector<IProblem::Ptr> &problems);
+
+    /// Adds nodes for @p problems, to the groups created if needed
+    void addProblems(const QVector<IProblem::Ptr> &problems);
+
+    /// Makes the nodes of the first problems of @p replaced refer to the second ones
+    void replaceProblems(const QVector<QPair<IProblem::Ptr, IProblem::Ptr>> &replaced);
+
     FilteredProblemStore* const q;
     QScopedPointer<GroupingStrategy> m_strategy;
     GroupingMethod m_grouping;
@@ -229,16 +288,6 @@ FilteredProblemStore::~FilteredProblemStore()
 {
 }
 
-void FilteredProblemStore::addProblem(const IProblem::Ptr &problem)
-{
-    Q_D(FilteredProblemStore);
-
-    ProblemStore::addProblem(problem);
-
-    if (d->match(problem))
-        d->m_strategy->addProblem(problem);
-}
-
 const ProblemStoreNode* FilteredProblemStore::findNode(int row, ProblemStoreNode *parent) const
 {
     Q_D(const FilteredProblemStore);
@@ -253,14 +302,6 @@ int FilteredProblemStore::count(ProblemStoreNode *parent) const
     return d->m_strategy->count(parent);
 }
 
-void FilteredProblemStore::clear()
-{
-    Q_D(FilteredProblemStore);
-
-    d->m_strategy->clear();
-    ProblemStore::clear();
-}
-
 void FilteredProblemStore::rebuild()
 {
     Q_D(FilteredProblemStore);
@@ -280,6 +321,60 @@ void FilteredProblemStore::rebuild()
     emit endRebuild();
 }
 
+void FilteredProblemStore::applyChanges(const Changes& changes)
+{
+    Q_D(FilteredProblemStore);
+
+    d->removeProblems(changes.removed);
+    d->replaceProblems(changes.replaced);
+
+    storeChanges(changes);
+
+    QVector<IProblem::Ptr> added;
+    for (const IProblem::Ptr& problem : changes.added) {
+        if (d->match(problem)) {
+            added.append(problem);
+        }
+    }
+    d->addProblems(added);
+}
+
+void FilteredProblemStore::refilter()
+{
+    Q_D(FilteredProblemStore);
+
+    // only the problems of documents which entered or left the scope change
+    QSet<const IProblem*> shown;
+    const auto groupedRootNode = d->m_strategy->groupedRootNode();
+    for (const ProblemStoreNode* node : groupedRootNode->children()) {
+        if (node->problem()) {
+            shown.insert(node->problem().data());
+        } else {
+            for (const ProblemStoreNode* child : node->children()) {
+                shown.insert(child->problem().data());
+            }
+        }
+    }
+
+    QVector<IProblem::Ptr> hidden;
+    QVector<IProblem::Ptr> added;
+    const auto childrenNodes = rootNode()->children();
+    for (const ProblemStoreNode* node : childrenNodes) {
+        IProblem::Ptr problem = node->problem();
+        const bool matches = d->match(problem);
+        if (shown.contains(problem.data())) {
+            if (!matches) {
+                hidden.append(problem);
+            }
+        } else if (matches) {
+            added.append(problem);
+        }
+    }
+
+    d->removeProblems(hidden);
+    d->addProblems(added);
+}
+
 void FilteredProblemStore::setGrouping(int grouping)
 {
     Q_D(FilteredProblemStore);
@@ -307,6 +402,105 @@ int FilteredProblemStore::grouping() const
     return d->m_grouping;
 }
 
+void FilteredProblemStorePrivate::removeProblems(const QVector<IProblem::Ptr> &problems)
+{
+    if (problems.isEmpty()) {
+        return;
+    }
+
+    QHash<ProblemStoreNode*, QSet<const IProblem*>> removedByParent;
+    for (const IProblem::Ptr& problem : problems) {
+        // problems which did not match the filters have no node
+        if (ProblemStoreNode* parent = m_strategy->parentFor(problem)) {
+            removedByParent[parent].insert(problem.data());
+        }
+    }
+
+    ProblemStoreNode* groupedRootNode = m_strategy->groupedRootNode();
+    QSet<const ProblemStoreNode*> emptyGroups;
+    for (auto it = removedByParent.constBegin(); it != removedByParent.constEnd(); ++it) {
+        const QSet<const IProblem*>& removed = it.value();
+        q->removeNodes(it.key(), [&removed](const ProblemStoreNode* node) {
+            return removed.contains(node->problem().data());
+        });
+
+        if (it.key() != groupedRootNode && it.key()->count() == 0 && m_strategy->removesEmptyGroups()) {
+            emptyGroups.insert(it.key());
+        }
+    }
+
+    if (!emptyGroups.isEmpty()) {
+        for (const ProblemStoreNode* group : qAsConst(emptyGroups)) {
+            m_strategy->groupRemoved(group);
+        }
+        q->removeNodes(groupedRootNode, [&emptyGroups](const ProblemStoreNode* node) {
+            return emptyGroups.contains(node);
+        });
+    }
+}
+
+void FilteredProblemStorePrivate::addProblems(const QVector<IProblem::Ptr> &problems)
+{
+    if (problems.isEmpty()) {
+        return;
+    }
+
+    // nodes are added per group, and new groups at once with their nodes
+    QVector<ProblemStoreNode*> parents;
+    QHash<ProblemStoreNode*, QVector<ProblemStoreNode*>> nodesByParent;
+    QVector<ProblemStoreNode*> newGroups;
+    QSet<ProblemStoreNode*> isNewGroup;
+    for (const IProblem::Ptr& problem : problems) {
+        ProblemStoreNode* parent = m_strategy->parentFor(problem);
+        if (!parent) {
+            parent = m_strategy->createGroup(problem);
+            newGroups.append(parent);
+            isNewGroup.insert(parent);
+        }
+
+        ProblemStoreNode* node = GroupingStrategy::createNode(problem);
+        if (isNewGroup.contains(parent)) {
+            parent->addChild(node);
+            continue;
+        }
+
+        auto& nodes = nodesByParent[parent];
+        if (nodes.isEmpty()) {
+            parents.append(parent);
+        }
+        nodes.append(node);
+    }
+
+    for (ProblemStoreNode* parent : qAsConst(parents)) {
+        q->appendNodes(parent, nodesByParent.value(parent));
+    }
+    q->appendNodes(m_strategy->groupedRootNode(), newGroups);
+}
+
+void FilteredProblemStorePrivate::replaceProblems(const QVector<QPair<IProblem::Ptr, IProblem::Ptr>> &replaced)
+{
+    if (replaced.isEmpty()) {
+        return;
+    }
+
+    QHash<ProblemStoreNode*, QHash<const IProblem*, IProblem::Ptr>> replacementsByParent;
+    for (const auto& pair : replaced) {
+        if (ProblemStoreNode* parent = m_strategy->parentFor(pair.first)) {
+            replacementsByParent[parent].insert(pair.first.data(), pair.second);
+        }
+    }
+
+    for (auto it = replacementsByParent.constBegin(); it != replacementsByParent.constEnd(); ++it) {
+        const auto& replacements = it.value();
+        for (ProblemStoreNode* node : it.key()->children()) {
+            const auto replacement = replacements.constFind(node->problem().data());
+            if (replacement != replacements.constEnd()) {
+                FilteredProblemStore::replaceNodeProblem(node, *replacement);
+            }
+        }
+    }
+}
+
 bool FilteredProblemStorePrivate::match(const IProblem::Ptr &problem) const
 {
     if (q->scope() != ProblemScope::BypassScopeFilter &&
@@ -81,18 +81,12 @@ public:
     explicit FilteredProblemStore(QObject *parent = nullptr);
     ~FilteredProblemStore() override;
 
-    /// Adds a problem, which is then filtered and also added to the filtered problem list if it matches the filters
-    void addProblem(const IProblem::Ptr &problem) override;
-
     /// Retrieves the specified node
     const ProblemStoreNode* findNode(int row, ProblemStoreNode *parent = nullptr) const override;
 
     /// Retrieves the number of filtered problems
     int count(ProblemStoreNode *parent = nullptr) const override;
 
-    /// Clears the problems
-    void clear() override;
-
     /// Rebuilds the filtered problem list
     void rebuild() override;
 
@@ -102,6 +96,13 @@ public:
     /// Tells which grouping strategy is currently in use
     int grouping() const;
 
+protected:
+    /// Passes the changes on to the groups, for the problems which match the filters
+    void applyChanges(const Changes& changes) override;
+
+    /// Shows and hides the problems of the documents which entered or left the scope
+    void refilter() override;
+
 private:
     friend class FilteredProblemStorePrivate;
     const QScopedPointer<class FilteredProblemStorePrivate> d_ptr;
@@ -0,0 +1,141 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "problembatcher.h"
+
+#include "problemstore.h"
+
+#include <language/editor/documentrange.h>
+
+#include <QMultiHash>
+#include <QTimer>
+
+#include <algorithm>
+
+namespace
+{
+
+/// Problems passed on at once, more are passed on with the next batch
+const int BATCH_SIZE = 200;
+
+/// Time problems are collected for a batch, in ms
+const int BATCH_INTERVAL = 250;
+
+bool equalProblems(const KDevelop::IProblem::Ptr& a, const KDevelop::IProblem::Ptr& b)
+{
+    return a->source() == b->source() &&
+           a->sourceString() == b->sourceString() &&
+           a->severity() == b->severity() &&
+           a->finalLocation() == b->finalLocation() &&
+           a->description() == b->description() &&
+           a->explanation() == b->explanation();
+}
+
+}
+
+namespace KDevelop
+{
+
+class ProblemBatcherPrivate
+{
+public:
+    bool contains(const IProblem::Ptr& problem) const
+    {
+        const auto candidates = m_problemsByHash.values(problemHash(problem));
+        return std::any_of(candidates.begin(), candidates.end(), [&problem](const IProblem::Ptr& candidate) {
+            return equalProblems(problem, candidate);
+        });
+    }
+
+    QVector<IProblem::Ptr> m_problems;
+    /// m_problems by their problemHash()
+    QMultiHash<uint, IProblem::Ptr> m_problemsByHash;
+
+    QVector<IProblem::Ptr> m_pendingProblems;
+    QTimer m_flushTimer;
+};
+
+ProblemBatcher::ProblemBatcher(QObject* parent)
+    : QObject(parent)
+    , d_ptr(new ProblemBatcherPrivate)
+{
+    Q_D(ProblemBatcher);
+
+    d->m_flushTimer.setSingleShot(true);
+    d->m_flushTimer.setInterval(BATCH_INTERVAL);
+    connect(&d->m_flushTimer, &QTimer::timeout, this, &ProblemBatcher::flush);
+}
+
+ProblemBatcher::~ProblemBatcher() = default;
+
+void ProblemBatcher::addProblems(const QVector<IProblem::Ptr>& problems)
+{
+    Q_D(ProblemBatcher);
+
+    d->m_pendingProblems += problems;
+
+    if (d->m_pendingProblems.size() >= BATCH_SIZE) {
+        flush();
+    } else if (!d->m_flushTimer.isActive()) {
+        d->m_flushTimer.start();
+    }
+}
+
+void ProblemBatcher::flush()
+{
+    Q_D(ProblemBatcher);
+
+    d->m_flushTimer.stop();
+
+    QVector<IProblem::Ptr> problems;
+    problems.swap(d->m_pendingProblems);
+    QVector<IProblem::Ptr> added;
+    for (const IProblem::Ptr& problem : qAsConst(problems)) {
+        if (d->contains(problem)) {
+            continue;
+        }
+
+        d->m_problems.append(problem);
+        d->m_problemsByHash.insert(problemHash(problem), problem);
+        added.append(problem);
+    }
+
+    if (!added.isEmpty()) {
+        emit problemsAdded(added);
+    }
+}
+
+void ProblemBatcher::clear()
+{
+    Q_D(ProblemBatcher);
+
+    d->m_flushTimer.stop();
+    d->m_problems.clear();
+    d->m_problemsByHash.clear();
+    d->m_pendingProblems.clear();
+}
+
+QVector<IProblem::Ptr> ProblemBatcher::problems() const
+{
+    Q_D(const ProblemBatcher);
+
+    return d->m_problems;
+}
+
+}
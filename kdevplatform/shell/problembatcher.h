@@ -0,0 +1,71 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_PROBLEMBATCHER_H
+#define KDEVPLATFORM_PROBLEMBATCHER_H
+
+#include <QObject>
+#include <QVector>
+#include <shell/shellexport.h>
+#include <interfaces/iproblem.h>
+
+namespace KDevelop
+{
+
+class ProblemBatcherPrivate;
+
+/**
+ * @brief Collects the problems reported while an analysis runs and passes them on in batches.
+ *
+ * Analyzers may report thousands of problems, and updating the view for each of them
+ * gets slow. Queued problems are passed on every 250 ms, or as soon as 200 of them wait.
+ * Problems equal to one queued before are dropped.
+ */
+class KDEVPLATFORMSHELL_EXPORT ProblemBatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ProblemBatcher(QObject* parent = nullptr);
+    ~ProblemBatcher() override;
+
+    /// Queues @p problems for the next batch
+    void addProblems(const QVector<IProblem::Ptr>& problems);
+
+    /// Passes the queued problems on right away
+    void flush();
+
+    /// Drops the queued problems and the ones passed on
+    void clear();
+
+    /// All problems passed on so far, in the order they were queued
+    QVector<IProblem::Ptr> problems() const;
+
+Q_SIGNALS:
+    /// Emitted when a batch added new problems to problems(), with just the new ones
+    void problemsAdded(const QVector<KDevelop::IProblem::Ptr>& problems);
+
+private:
+    const QScopedPointer<class ProblemBatcherPrivate> d_ptr;
+    Q_DECLARE_PRIVATE(ProblemBatcher)
+};
+
+}
+
+#endif
@@ -100,6 +100,28 @@ ProblemModel::ProblemModel(QObject * parent, ProblemStore *store)
     connect(d->m_problems.data(), &ProblemStore::beginRebuild, this, &ProblemModel::onBeginRebuild);
     connect(d->m_problems.data(), &ProblemStore::endRebuild, this, &ProblemModel::onEndRebuild);
 
+    // the store reports which nodes change, so the views keep their state
+    auto nodeIndex = [this](ProblemStoreNode* node) {
+        if (!node || node->isRoot()) {
+            return QModelIndex();
+        }
+        return createIndex(node->index(), 0, node);
+    };
+    connect(d->m_problems.data(), &ProblemStore::beginInsertNodes, this,
+            [this, nodeIndex](ProblemStoreNode* parent, int first, int last) {
+        beginInsertRows(nodeIndex(parent), first, last);
+    });
+    connect(d->m_problems.data(), &ProblemStore::endInsertNodes, this, [this]() {
+        endInsertRows();
+    });
+    connect(d->m_problems.data(), &ProblemStore::beginRemoveNodes, this,
+            [this, nodeIndex](ProblemStoreNode* parent, int first, int last) {
+        beginRemoveRows(nodeIndex(parent), first, last);
+    });
+    connect(d->m_problems.data(), &ProblemStore::endRemoveNodes, this, [this]() {
+        endRemoveRows();
+    });
+
     connect(d->m_problems.data(), &ProblemStore::problemsChanged, this, &ProblemModel::problemsChanged);
 }
 
@@ -288,10 +310,22 @@ void ProblemModel::addProblem(const IProblem::Ptr &problem)
     if (d->m_isPlaceholderShown) {
         setProblems({ problem });
     } else {
-        int c = d->m_problems->count();
-        beginInsertRows(QModelIndex(), c, c);
         d->m_problems->addProblem(problem);
-        endInsertRows();
+    }
+}
+
+void ProblemModel::addProblems(const QVector<IProblem::Ptr> &problems)
+{
+    Q_D(ProblemModel);
+
+    if (problems.isEmpty()) {
+        return;
+    }
+
+    if (d->m_isPlaceholderShown) {
+        setProblems(problems);
+    } else {
+        d->m_problems->addProblems(problems);
     }
 }
 
@@ -299,7 +333,6 @@ void ProblemModel::setProblems(const QVector<IProblem::Ptr> &problems)
 {
     Q_D(ProblemModel);
 
-    beginResetModel();
     if (problems.isEmpty() && !d->m_placeholderText.isEmpty()) {
         d->m_problems->setProblems({ d->createPlaceholdreProblem() });
         d->m_isPlaceholderShown = true;
@@ -307,7 +340,23 @@ void ProblemModel::setProblems(const QVector<IProblem::Ptr> &problems)
         d->m_problems->setProblems(problems);
         d->m_isPlaceholderShown = false;
     }
-    endResetModel();
+}
+
+void ProblemModel::setProblems(const KDevelop::IndexedString& document, const QVector<IProblem::Ptr> &problems)
+{
+    Q_D(ProblemModel);
+
+    if (d->m_isPlaceholderShown) {
+        d->m_problems->setProblems(QVector<IProblem::Ptr>());
+        d->m_isPlaceholderShown = false;
+    }
+
+    d->m_problems->setProblems(document, problems);
+
+    if (d->m_problems->isEmpty() && !d->m_placeholderText.isEmpty()) {
+        d->m_problems->setProblems({ d->createPlaceholdreProblem() });
+        d->m_isPlaceholderShown = true;
+    }
 }
 
 void ProblemModel::clearProblems()
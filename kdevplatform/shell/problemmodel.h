@@ -123,9 +123,15 @@ public:
     /// Adds a new problem to the model
     void addProblem(const IProblem::Ptr &problem);
 
-    /// Clears the problems, then adds a new set of them
+    /// Adds new problems to the model, e.g. a batch of those an analyzer found so far
+    void addProblems(const QVector<IProblem::Ptr> &problems);
+
+    /// Replaces the problems by a new set of them, views are only told about the ones which changed
     void setProblems(const QVector<IProblem::Ptr> &problems);
 
+    /// Replaces the problems last set for @p document, see ProblemStore::setProblems()
+    void setProblems(const KDevelop::IndexedString& document, const QVector<IProblem::Ptr> &problems);
+
     /// Clears the problems
     void clearProblems();
 
@@ -25,9 +25,81 @@
 #include <shell/watcheddocumentset.h>
 #include "problemstorenode.h"
 
+#include <QHash>
+#include <QSet>
+
+#include <algorithm>
+
+using namespace KDevelop;
+
+namespace
+{
+
+bool equalProblems(const IProblem::Ptr& a, const IProblem::Ptr& b)
+{
+    if (a == b) {
+        return true;
+    }
+
+    if (a->source() != b->source() ||
+        a->severity() != b->severity() ||
+        !(a->finalLocation() == b->finalLocation()) ||
+        a->description() != b->description() ||
+        a->explanation() != b->explanation() ||
+        a->sourceString() != b->sourceString()) {
+        return false;
+    }
+
+    const auto aDiagnostics = a->diagnostics();
+    const auto bDiagnostics = b->diagnostics();
+    if (aDiagnostics.size() != bDiagnostics.size()) {
+        return false;
+    }
+    for (int i = 0; i < aDiagnostics.size(); ++i) {
+        if (!equalProblems(aDiagnostics.at(i), bDiagnostics.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Removes runs of adjacent children from the back, so the rows of the runs before stay valid
+template<typename BeginRemove, typename EndRemove>
+void removeChildren(ProblemStoreNode* parent, const std::function<bool(const ProblemStoreNode*)>& remove,
+                    BeginRemove beginRemove, EndRemove endRemove)
+{
+    int last = parent->count() - 1;
+    while (last >= 0) {
+        if (!remove(parent->child(last))) {
+            --last;
+            continue;
+        }
+
+        int first = last;
+        while (first > 0 && remove(parent->child(first - 1))) {
+            --first;
+        }
+
+        beginRemove(first, last);
+        parent->removeChildren(first, last - first + 1);
+        endRemove();
+
+        last = first - 1;
+    }
+}
+
+}
+
 namespace KDevelop
 {
 
+uint problemHash(const IProblem::Ptr& problem)
+{
+    const DocumentRange location = problem->finalLocation();
+    return qHash(problem->description()) ^ qHash(location.document) ^ qHash(location.start().line())
+           ^ qHash(location.start().column()) ^ qHash(static_cast<int>(problem->severity()));
+}
+
 class ProblemStorePrivate
 {
 public:
@@ -49,8 +121,11 @@ public:
     /// Path of the currently open document
     KDevelop::IndexedString m_currentDocument;
 
-    /// All stored problems
+    /// All stored problems, in the order of the nodes of m_rootNode
     QVector<KDevelop::IProblem::Ptr> m_allProblems;
+
+    /// The stored problems by the document they were set for
+    QHash<KDevelop::IndexedString, QVector<KDevelop::IProblem::Ptr>> m_documentProblems;
 };
 
 
@@ -65,8 +140,6 @@ ProblemStore::~ProblemStore()
 {
     Q_D(ProblemStore);
 
-    clear();
-
     delete d->m_rootNode;
 }
 
@@ -74,38 +147,216 @@ void ProblemStore::addProblem(const IProblem::Ptr &problem)
 {
     Q_D(ProblemStore);
 
-    auto* node = new ProblemNode(d->m_rootNode);
-    node->setProblem(problem);
-    d->m_rootNode->addChild(node);
+    d->m_documentProblems[problem->finalLocation().document].append(problem);
+
+    Changes changes;
+    changes.added.append(problem);
+    applyChanges(changes);
 
-    d->m_allProblems += problem;
     emit problemsChanged();
 }
 
-void ProblemStore::setProblems(const QVector<IProblem::Ptr> &problems)
+void ProblemStore::addProblems(const QVector<IProblem::Ptr> &problems)
 {
     Q_D(ProblemStore);
 
-    int oldSize = d->m_allProblems.size();
+    if (problems.isEmpty()) {
+        return;
+    }
 
-    // set signals block to prevent problemsChanged() emitting during clean
-    {
-        QSignalBlocker blocker(this);
-        clear();
+    for (const IProblem::Ptr& problem : problems) {
+        d->m_documentProblems[problem->finalLocation().document].append(problem);
+    }
+
+    Changes changes;
+    changes.added = problems;
+    applyChanges(changes);
+
+    emit problemsChanged();
+}
+
+/// Matches @p newProblems against @p oldProblems, hashing instead of comparing each pair
+static void diffProblems(const QVector<IProblem::Ptr>& oldProblems, const QVector<IProblem::Ptr>& newProblems,
+                         ProblemStore::Changes* changes)
+{
+    QMultiHash<uint, int> oldByHash;
+    oldByHash.reserve(oldProblems.size());
+    for (int i = 0; i < oldProblems.size(); ++i) {
+        oldByHash.insert(problemHash(oldProblems.at(i)), i);
+    }
+
+    QVector<bool> matched(oldProblems.size(), false);
+    for (const IProblem::Ptr& problem : newProblems) {
+        bool found = false;
+        const uint hash = problemHash(problem);
+        for (auto it = oldByHash.constFind(hash); it != oldByHash.constEnd() && it.key() == hash; ++it) {
+            const int i = it.value();
+            if (!matched.at(i) && equalProblems(oldProblems.at(i), problem)) {
+                matched[i] = true;
+                found = true;
+                if (oldProblems.at(i) != problem) {
+                    changes->replaced.append({oldProblems.at(i), problem});
+                }
+                break;
+            }
+        }
+        if (!found) {
+            changes->added.append(problem);
+        }
     }
 
+    for (int i = 0; i < oldProblems.size(); ++i) {
+        if (!matched.at(i)) {
+            changes->removed.append(oldProblems.at(i));
+        }
+    }
+}
+
+void ProblemStore::setProblems(const QVector<IProblem::Ptr> &problems)
+{
+    Q_D(ProblemStore);
+
+    Changes changes;
+    diffProblems(d->m_allProblems, problems, &changes);
+
+    d->m_documentProblems.clear();
     for (const IProblem::Ptr& problem : problems) {
-        d->m_rootNode->addChild(new ProblemNode(d->m_rootNode, problem));
+        d->m_documentProblems[problem->finalLocation().document].append(problem);
     }
 
-    rebuild();
+    applyChanges(changes);
 
-    if (d->m_allProblems.size() != oldSize || d->m_allProblems != problems) {
-        d->m_allProblems = problems;
+    if (!changes.removed.isEmpty() || !changes.added.isEmpty()) {
         emit problemsChanged();
     }
 }
 
+void ProblemStore::setProblems(const IndexedString& document, const QVector<IProblem::Ptr> &problems)
+{
+    Q_D(ProblemStore);
+
+    Changes changes;
+    diffProblems(d->m_documentProblems.value(document), problems, &changes);
+
+    if (problems.isEmpty()) {
+        d->m_documentProblems.remove(document);
+    } else {
+        d->m_documentProblems.insert(document, problems);
+    }
+
+    applyChanges(changes);
+
+    if (!changes.removed.isEmpty() || !changes.added.isEmpty()) {
+        emit problemsChanged();
+    }
+}
+
+void ProblemStore::applyChanges(const Changes& changes)
+{
+    Q_D(ProblemStore);
+
+    if (!changes.removed.isEmpty()) {
+        QSet<const IProblem*> removed;
+        removed.reserve(changes.removed.size());
+        for (const IProblem::Ptr& problem : changes.removed) {
+            removed.insert(problem.data());
+        }
+        removeNodes(d->m_rootNode, [&removed](const ProblemStoreNode* node) {
+            return removed.contains(node->problem().data());
+        });
+    }
+
+    // removal and replacement are done now, so only the additions remain
+    Changes remaining;
+    remaining.replaced = changes.replaced;
+    storeChanges(remaining);
+
+    if (!changes.added.isEmpty()) {
+        QVector<ProblemStoreNode*> nodes;
+        nodes.reserve(changes.added.size());
+        for (const IProblem::Ptr& problem : changes.added) {
+            nodes.append(new ProblemNode(nullptr, problem));
+        }
+        appendNodes(d->m_rootNode, nodes);
+        d->m_allProblems += changes.added;
+    }
+}
+
+void ProblemStore::storeChanges(const Changes& changes)
+{
+    Q_D(ProblemStore);
+
+    if (!changes.removed.isEmpty()) {
+        QSet<const IProblem*> removed;
+        removed.reserve(changes.removed.size());
+        for (const IProblem::Ptr& problem : changes.removed) {
+            removed.insert(problem.data());
+        }
+        removeChildren(d->m_rootNode, [&removed](const ProblemStoreNode* node) {
+            return removed.contains(node->problem().data());
+        }, [](int, int) {}, []() {});
+    }
+
+    // the nodes of the root are in the order of the list, with those of the removed problems gone now
+    d->m_allProblems.clear();
+    d->m_allProblems.reserve(d->m_rootNode->count() + changes.added.size());
+
+    QHash<const IProblem*, IProblem::Ptr> replacements;
+    replacements.reserve(changes.replaced.size());
+    for (const auto& replaced : changes.replaced) {
+        replacements.insert(replaced.first.data(), replaced.second);
+    }
+    const auto childrenNodes = d->m_rootNode->children();
+    for (ProblemStoreNode* node : childrenNodes) {
+        const auto it = replacements.constFind(node->problem().data());
+        if (it != replacements.constEnd()) {
+            replaceNodeProblem(node, *it);
+        }
+        d->m_allProblems.append(node->problem());
+    }
+
+    for (const IProblem::Ptr& problem : changes.added) {
+        d->m_rootNode->addChild(new ProblemNode(d->m_rootNode, problem));
+        d->m_allProblems.append(problem);
+    }
+}
+
+void ProblemStore::removeNodes(ProblemStoreNode* parent, const std::function<bool(const ProblemStoreNode*)>& remove)
+{
+    removeChildren(parent, remove, [this, parent](int first, int last) {
+        emit beginRemoveNodes(parent, first, last);
+    }, [this]() {
+        emit endRemoveNodes();
+    });
+}
+
+void ProblemStore::appendNodes(ProblemStoreNode* parent, const QVector<ProblemStoreNode*>& nodes)
+{
+    if (nodes.isEmpty()) {
+        return;
+    }
+
+    const int first = parent->count();
+    emit beginInsertNodes(parent, first, first + nodes.size() - 1);
+    for (ProblemStoreNode* node : nodes) {
+        parent->addChild(node);
+    }
+    emit endInsertNodes();
+}
+
+void ProblemStore::replaceNodeProblem(ProblemStoreNode* node, const IProblem::Ptr& problem)
+{
+    auto* problemNode = static_cast<ProblemNode*>(node);
+    problemNode->setProblem(problem);
+
+    // the children are the nodes of the diagnostics, if there are any
+    const auto diagnostics = problem->diagnostics();
+    const int count = std::min(node->count(), diagnostics.size());
+    for (int i = 0; i < count; ++i) {
+        replaceNodeProblem(node->child(i), diagnostics.at(i));
+    }
+}
+
 QVector<IProblem::Ptr> ProblemStore::problems(const KDevelop::IndexedString& document) const
 {
     Q_D(const ProblemStore);
@@ -128,6 +379,13 @@ const ProblemStoreNode* ProblemStore::findNode(int row, ProblemStoreNode *parent
     return d->m_rootNode->child(row);
 }
 
+bool ProblemStore::isEmpty() const
+{
+    Q_D(const ProblemStore);
+
+    return d->m_allProblems.isEmpty();
+}
+
 int ProblemStore::count(ProblemStoreNode *parent) const
 {
     Q_D(const ProblemStore);
@@ -140,20 +398,18 @@ int ProblemStore::count(ProblemStoreNode *parent) const
 
 void ProblemStore::clear()
 {
-    Q_D(ProblemStore);
-
-    d->m_rootNode->clear();
-
-    if (!d->m_allProblems.isEmpty()) {
-        d->m_allProblems.clear();
-        emit problemsChanged();
-    }
+    setProblems(QVector<IProblem::Ptr>());
 }
 
 void ProblemStore::rebuild()
 {
 }
 
+void ProblemStore::refilter()
+{
+    rebuild();
+}
+
 void ProblemStore::setSeverity(int severity)
 {
     switch (severity)
@@ -298,7 +554,7 @@ const KDevelop::IndexedString& ProblemStore::currentDocument() const
 
 void ProblemStore::onDocumentSetChanged()
 {
-    rebuild();
+    refilter();
 
     emit changed();
 }
@@ -22,9 +22,12 @@
 #define PROBLEMSTORE_H
 
 #include <QObject>
+#include <QPair>
 #include <shell/shellexport.h>
 #include <interfaces/iproblem.h>
 
+#include <functional>
+
 namespace KDevelop
 {
 
@@ -40,6 +43,8 @@ class ProblemStorePrivate;
  * Stores the problems in ProblemStoreNodes.
  * When implementing a subclass, first and foremost the rebuild method needs to be implemented, which is called every time there's a change in scope and severity filter.
  * If grouping is desired then also the setGrouping method must be implemented.
+ * Subclasses which show other nodes than the ones of rootNode() also need to implement applyChanges(),
+ * so that changes of the stored problems are passed on as inserted and removed nodes instead of a rebuild.
  * ProblemStore depending on settings uses CurrentDocumentSet, OpenDocumentSet, CurrentProjectSet, or AllProjectSet for scope support (NOTE: Filtering still has to be implemented in either a subclass, or somewhere else).
  * When the scope changes it emits the changed() signal.
  *
@@ -71,21 +76,50 @@ class KDEVPLATFORMSHELL_EXPORT ProblemStore : public QObject
 {
     Q_OBJECT
 public:
+    /// Difference between the stored problems and a new list of them
+    struct Changes
+    {
+        /// Stored problems without an equal new one
+        QVector<IProblem::Ptr> removed;
+        /// New problems without an equal stored one
+        QVector<IProblem::Ptr> added;
+        /// Stored problems and the equal new ones which replace them
+        QVector<QPair<IProblem::Ptr, IProblem::Ptr>> replaced;
+    };
+
     explicit ProblemStore(QObject *parent = nullptr);
     ~ProblemStore() override;
 
     /// Adds a problem
     virtual void addProblem(const IProblem::Ptr &problem);
 
-    /// Clears the current problems, and adds new ones from a list
+    /// Adds @p problems, views are told about all of them at once
+    void addProblems(const QVector<IProblem::Ptr> &problems);
+
+    /**
+     * Replaces the current problems by a new list.
+     *
+     * Stored problems that are equal to a new one keep their node, which then refers to the new problem,
+     * so views only get told about the problems which really were removed or added.
+     */
     virtual void setProblems(const QVector<IProblem::Ptr> &problems);
 
+    /**
+     * Replaces the problems last set for @p document, e.g. after it was parsed again, like setProblems() does for all.
+     *
+     * The problems do not need to be located in @p document, it only names the list.
+     */
+    void setProblems(const KDevelop::IndexedString& document, const QVector<IProblem::Ptr> &problems);
+
     /// Retrieve problems for selected document
     QVector<IProblem::Ptr> problems(const KDevelop::IndexedString& document) const;
 
     /// Finds the specified node
     virtual const ProblemStoreNode* findNode(int row, ProblemStoreNode *parent = nullptr) const;
 
+    /// Tells if there are no problems stored, the grouping nodes left aside
+    bool isEmpty() const;
+
     /// Returns the number of problems
     virtual int count(ProblemStoreNode *parent = nullptr) const;
 
@@ -144,6 +178,18 @@ Q_SIGNALS:
     /// Emitted once the problemlist has been rebuilt
     void endRebuild();
 
+    /// Emitted before the children @p first to @p last are added to @p parent
+    void beginInsertNodes(KDevelop::ProblemStoreNode* parent, int first, int last);
+
+    /// Emitted once nodes have been added
+    void endInsertNodes();
+
+    /// Emitted before the children @p first to @p last are removed from @p parent
+    void beginRemoveNodes(KDevelop::ProblemStoreNode* parent, int first, int last);
+
+    /// Emitted once nodes have been removed
+    void endRemoveNodes();
+
 private Q_SLOTS:
     /// Triggered when the watched document set changes. E.g.:document closed, new one added, etc
     virtual void onDocumentSetChanged();
@@ -151,11 +197,40 @@ private Q_SLOTS:
 protected:
     ProblemStoreNode* rootNode() const;
 
+    /**
+     * Applies @p changes to the stored problems and to the shown nodes.
+     *
+     * The base class shows the nodes of rootNode(), so it just calls storeChanges()
+     * and emits the signals about the inserted and removed nodes.
+     */
+    virtual void applyChanges(const Changes& changes);
+
+    /// Applies @p changes to the list of all problems and to rootNode(), without emitting any signals
+    void storeChanges(const Changes& changes);
+
+    /**
+     * Updates the shown problems after the watched documents changed.
+     * It calls rebuild() in the base class.
+     */
+    virtual void refilter();
+
+    /// Removes the children of @p parent which @p remove returns true for, signalling runs of adjacent ones at once
+    void removeNodes(ProblemStoreNode* parent, const std::function<bool(const ProblemStoreNode*)>& remove);
+
+    /// Appends @p nodes to the children of @p parent, with a single signal
+    void appendNodes(ProblemStoreNode* parent, const QVector<ProblemStoreNode*>& nodes);
+
+    /// Makes @p node and the nodes of its diagnostics refer to @p problem, which is equal to its current problem
+    static void replaceNodeProblem(ProblemStoreNode* node, const IProblem::Ptr& problem);
+
 private:
     const QScopedPointer<class ProblemStorePrivate> d_ptr;
     Q_DECLARE_PRIVATE(ProblemStore)
 };
 
+/// Hash of the description, location and severity of @p problem, for looking up equal problems
+KDEVPLATFORMSHELL_EXPORT uint problemHash(const IProblem::Ptr& problem);
+
 }
 
 #endif
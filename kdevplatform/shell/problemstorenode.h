@@ -118,6 +118,14 @@ public:
         child->setParent(this);
     }
 
+    /// Deletes @p count children nodes, starting with the one at @p first
+    void removeChildren(int first, int count)
+    {
+        const auto begin = m_children.begin() + first;
+        qDeleteAll(begin, begin + count);
+        m_children.erase(begin, begin + count);
+    }
+
     /// Returns the label of this node, if there's one
     virtual QString label() const{
         return QString();
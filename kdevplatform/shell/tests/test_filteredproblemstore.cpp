@@ -59,6 +59,8 @@ private Q_SLOTS:
     void testPathGrouping();
     void testSeverityGrouping();
 
+    void testDocumentUpdate();
+
 private:
     // Severity grouping testing
     bool checkCounts(int error, int warning, int hint);
@@ -568,6 +570,55 @@ void TestFilteredProblemStore::testSeverityGrouping()
     QVERIFY(checkDiagnodes(m_store->findNode(0)->child(0), m_diagnosticTestProblem));
 }
 
+void TestFilteredProblemStore::testDocumentUpdate()
+{
+    m_store->clear();
+    m_store->setGrouping(PathGrouping);
+
+    const IndexedString document(QStringLiteral("/updated/document"));
+    m_store->setProblems(document, {m_problems[0], m_problems[1]});
+    QCOMPARE(m_store->count(), 2);
+
+    // An equal problem, as parsing the document again gives
+    IProblem::Ptr reparsed(new DetectedProblem());
+    reparsed->setDescription(m_problems[0]->description());
+    reparsed->setSeverity(m_problems[0]->severity());
+    reparsed->setFinalLocation(m_problems[0]->finalLocation());
+
+    QSignalSpy beginRebuildSpy(m_store.data(), &FilteredProblemStore::beginRebuild);
+    QSignalSpy beginInsertSpy(m_store.data(), &FilteredProblemStore::beginInsertNodes);
+    QSignalSpy beginRemoveSpy(m_store.data(), &FilteredProblemStore::beginRemoveNodes);
+    QSignalSpy problemsChangedSpy(m_store.data(), &FilteredProblemStore::problemsChanged);
+
+    m_store->setProblems(document, {reparsed, m_problems[2]});
+
+    // The problem and the path group of m_problems[1] go, the group of m_problems[2] comes
+    QCOMPARE(beginRebuildSpy.count(), 0);
+    QCOMPARE(beginRemoveSpy.count(), 2);
+    QCOMPARE(beginInsertSpy.count(), 1);
+    QCOMPARE(problemsChangedSpy.count(), 1);
+
+    QCOMPARE(m_store->count(), 2);
+    const ProblemStoreNode *node = m_store->findNode(0);
+    checkNodeLabel(node, m_problems[0]->finalLocation().document.str());
+    QCOMPARE(node->child(0)->problem(), reparsed);
+    node = m_store->findNode(1);
+    checkNodeLabel(node, m_problems[2]->finalLocation().document.str());
+    checkNodeDescription(node->child(0), m_problems[2]->description());
+
+    // Setting the same problems again changes nothing
+    m_store->setProblems(document, {reparsed, m_problems[2]});
+    QCOMPARE(beginRemoveSpy.count(), 2);
+    QCOMPARE(beginInsertSpy.count(), 1);
+    QCOMPARE(problemsChangedSpy.count(), 1);
+
+    m_store->setProblems(document, {});
+    QCOMPARE(m_store->count(), 0);
+    QCOMPARE(beginRebuildSpy.count(), 0);
+
+    m_store->setGrouping(NoGrouping);
+}
+
 bool TestFilteredProblemStore::checkCounts(int error, int warning, int hint)
 {
     const ProblemStoreNode *errorNode = m_store->findNode(0);
@@ -0,0 +1,157 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <QTest>
+#include <QSignalSpy>
+#include <shell/problembatcher.h>
+#include <shell/problem.h>
+#include <language/editor/documentrange.h>
+
+#include <tests/testcore.h>
+#include <tests/autotestshell.h>
+
+using namespace KDevelop;
+
+class TestProblemBatcher : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testInterval();
+    void testBatchSize();
+    void testDuplicates();
+    void testClear();
+
+private:
+    static IProblem::Ptr createProblem(int line);
+    static QVector<IProblem::Ptr> createProblems(int count);
+};
+
+void TestProblemBatcher::initTestCase()
+{
+    AutoTestShell::init();
+    TestCore::initialize(Core::NoUi);
+}
+
+void TestProblemBatcher::cleanupTestCase()
+{
+    TestCore::shutdown();
+}
+
+IProblem::Ptr TestProblemBatcher::createProblem(int line)
+{
+    IProblem::Ptr problem(new DetectedProblem());
+    problem->setDescription(QStringLiteral("PROBLEM"));
+    problem->setFinalLocation(DocumentRange(IndexedString(QStringLiteral("/file.cpp")), KTextEditor::Range(line, 0, line, 1)));
+    return problem;
+}
+
+QVector<IProblem::Ptr> TestProblemBatcher::createProblems(int count)
+{
+    QVector<IProblem::Ptr> problems;
+    for (int i = 0; i < count; ++i) {
+        problems.append(createProblem(i));
+    }
+    return problems;
+}
+
+void TestProblemBatcher::testInterval()
+{
+    ProblemBatcher batcher;
+    QSignalSpy spy(&batcher, &ProblemBatcher::problemsAdded);
+
+    batcher.addProblems(createProblems(3));
+    batcher.addProblems({createProblem(3)});
+    QCOMPARE(spy.count(), 0);
+    QVERIFY(batcher.problems().isEmpty());
+
+    // all problems queued within the interval come as one batch
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(batcher.problems().size(), 4);
+}
+
+void TestProblemBatcher::testBatchSize()
+{
+    ProblemBatcher batcher;
+    QSignalSpy spy(&batcher, &ProblemBatcher::problemsAdded);
+
+    batcher.addProblems(createProblems(199));
+    QCOMPARE(spy.count(), 0);
+
+    // a full batch is passed on without waiting
+    batcher.addProblems({createProblem(199)});
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(batcher.problems().size(), 200);
+}
+
+void TestProblemBatcher::testDuplicates()
+{
+    ProblemBatcher batcher;
+    QSignalSpy spy(&batcher, &ProblemBatcher::problemsAdded);
+
+    const auto problems = createProblems(2);
+    batcher.addProblems(problems);
+    batcher.addProblems({createProblem(0)});
+    batcher.flush();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).value<QVector<IProblem::Ptr>>(), problems);
+    QCOMPARE(batcher.problems(), problems);
+
+    // a batch without new problems is not passed on
+    batcher.addProblems({createProblem(1)});
+    batcher.flush();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(batcher.problems(), problems);
+
+    IProblem::Ptr other = createProblem(0);
+    other->setSeverity(IProblem::Hint);
+    batcher.addProblems({other});
+    batcher.flush();
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(spy.at(1).at(0).value<QVector<IProblem::Ptr>>(), QVector<IProblem::Ptr>{other});
+    QCOMPARE(batcher.problems().size(), 3);
+}
+
+void TestProblemBatcher::testClear()
+{
+    ProblemBatcher batcher;
+    QSignalSpy spy(&batcher, &ProblemBatcher::problemsAdded);
+
+    batcher.addProblems(createProblems(2));
+    batcher.flush();
+    batcher.addProblems({createProblem(2)});
+    batcher.clear();
+    QVERIFY(batcher.problems().isEmpty());
+    QVERIFY(!spy.wait(500));
+    QCOMPARE(spy.count(), 1);
+
+    // cleared problems are not duplicates anymore
+    batcher.addProblems(createProblems(2));
+    batcher.flush();
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(batcher.problems().size(), 2);
+}
+
+QTEST_MAIN(TestProblemBatcher)
+
+#include "test_problembatcher.moc"
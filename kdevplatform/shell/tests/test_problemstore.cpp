@@ -39,6 +39,7 @@ private Q_SLOTS:
 
     void testAddProblems();
     void testClearProblems();
+    void testAddProblemBatches();
     void testSetProblems();
     void testFindNode();
     void testSeverity();
@@ -89,6 +90,24 @@ void TestProblemStore::testClearProblems()
     QCOMPARE(m_store->count(), 0);
 }
 
+void TestProblemStore::testAddProblemBatches()
+{
+    QSignalSpy spy(m_store.data(), &ProblemStore::problemsChanged);
+
+    m_store->addProblems(m_problems.mid(0, 2));
+    QCOMPARE(m_store->count(), 2);
+    QCOMPARE(spy.count(), 1);
+
+    m_store->addProblems(m_problems.mid(2));
+    QCOMPARE(m_store->count(), m_problems.count());
+    QCOMPARE(spy.count(), 2);
+
+    m_store->addProblems({});
+    QCOMPARE(spy.count(), 2);
+
+    m_store->clear();
+}
+
 void TestProblemStore::testSetProblems()
 {
     m_store->setProblems(m_problems);
@@ -0,0 +1,217 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) version 3, or any
+ * later version accepted by the membership of KDE e.V. (or its
+ * successor approved by the membership of KDE e.V.), which shall
+ * act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "internedpath.h"
+
+#include "path.h"
+
+#include <QHash>
+#include <QPair>
+#include <QReadWriteLock>
+#include <QVector>
+
+#include <algorithm>
+
+using namespace KDevelop;
+
+namespace {
+
+inline bool isWindowsDriveLetter(const QString& segment)
+{
+#ifdef Q_OS_WIN
+    return segment.size() == 2 && segment.at(0).isLetter() && segment.at(1) == QLatin1Char(':');
+#else
+    Q_UNUSED(segment);
+    return false;
+#endif
+}
+
+struct Node
+{
+    QString segment;
+    /// the node of the previous segment, 0 for the first segment
+    uint parentNode;
+    /// the node of Path::parent() of this path
+    uint parentPath;
+    /// the number of segments
+    int depth;
+    /// whether the first segment is the prefix of a remote url
+    bool remote;
+};
+
+class PathTrie
+{
+public:
+    PathTrie()
+    {
+        // index 0 is the invalid path
+        nodes.append(Node{QString(), 0, 0, 0, false});
+    }
+
+    uint intern(const QVector<QString>& segments)
+    {
+        if (segments.isEmpty()) {
+            return 0;
+        }
+
+        {
+            // most paths are in the trie already
+            QReadLocker lock(&this->lock);
+            uint node = 0;
+            int i = 0;
+            for (; i < segments.size(); ++i) {
+                const auto it = children.constFind(qMakePair(node, segments.at(i)));
+                if (it == children.constEnd()) {
+                    break;
+                }
+                node = *it;
+            }
+            if (i == segments.size()) {
+                return node;
+            }
+        }
+
+        QWriteLocker lock(&this->lock);
+        uint node = 0;
+        for (const auto& segment : segments) {
+            node = childLocked(node, segment);
+        }
+        return node;
+    }
+
+    uint childLocked(uint parent, const QString& segment)
+    {
+        const auto key = qMakePair(parent, segment);
+        const auto it = children.constFind(key);
+        if (it != children.constEnd()) {
+            return *it;
+        }
+
+        const Node& parentNode = nodes.at(parent);
+        const bool remote = parent ? parentNode.remote : segment.contains(QLatin1Char('/'));
+        const int depth = parentNode.depth + 1;
+        const uint index = nodes.size();
+        nodes.append(Node{segment, parent, index, depth, remote});
+        children.insert(key, index);
+
+        // see Path::parent(): the root item is kept but cleared, the others are dropped
+        const int rootDepth = remote ? 2 : 1;
+        if (depth > rootDepth) {
+            nodes[index].parentPath = parent;
+        } else if (depth == rootDepth && !segment.isEmpty() && !isWindowsDriveLetter(segment)) {
+            const uint parentPath = childLocked(parent, QString());
+            nodes[index].parentPath = parentPath;
+        }
+        return index;
+    }
+
+    QReadWriteLock lock;
+    QVector<Node> nodes;
+    QHash<QPair<uint, QString>, uint> children;
+};
+
+Q_GLOBAL_STATIC(PathTrie, s_trie)
+
+}
+
+InternedPath::InternedPath(const Path& path)
+    : m_index(s_trie->intern(path.m_data))
+{
+}
+
+Path InternedPath::toPath() const
+{
+    Path path;
+    if (!m_index) {
+        return path;
+    }
+
+    QReadLocker lock(&s_trie->lock);
+    const auto& nodes = s_trie->nodes;
+    path.m_data.resize(nodes.at(m_index).depth);
+    for (uint node = m_index; node; node = nodes.at(node).parentNode) {
+        path.m_data[nodes.at(node).depth - 1] = nodes.at(node).segment;
+    }
+    return path;
+}
+
+InternedPath InternedPath::parent() const
+{
+    QReadLocker lock(&s_trie->lock);
+    return InternedPath(s_trie->nodes.at(m_index).parentPath);
+}
+
+bool InternedPath::hasParent() const
+{
+    QReadLocker lock(&s_trie->lock);
+    const Node& node = s_trie->nodes.at(m_index);
+    const int rootDepth = node.remote ? 2 : 1;
+    return node.depth >= rootDepth && !(node.depth == rootDepth && node.segment.isEmpty());
+}
+
+bool InternedPath::isParentOf(const InternedPath& path) const
+{
+    if (!m_index || !path.m_index) {
+        return false;
+    }
+
+    QReadLocker lock(&s_trie->lock);
+    const auto& nodes = s_trie->nodes;
+    const Node& parent = nodes.at(m_index);
+    const Node& child = nodes.at(path.m_index);
+    if (parent.remote != child.remote || child.depth <= parent.depth) {
+        return false;
+    }
+
+    uint ancestor = path.m_index;
+    while (nodes.at(ancestor).depth > parent.depth) {
+        ancestor = nodes.at(ancestor).parentNode;
+    }
+    // support for trailing '/', see Path::isParentOf()
+    return ancestor == m_index || (parent.segment.isEmpty() && nodes.at(ancestor).parentNode == parent.parentNode);
+}
+
+bool InternedPath::isDirectParentOf(const InternedPath& path) const
+{
+    if (!m_index || !path.m_index) {
+        return false;
+    }
+
+    QReadLocker lock(&s_trie->lock);
+    const auto& nodes = s_trie->nodes;
+    const Node& parent = nodes.at(m_index);
+    const Node& child = nodes.at(path.m_index);
+    if (parent.remote != child.remote || child.depth != parent.depth + 1) {
+        return false;
+    }
+    // support for trailing '/', see Path::isDirectParentOf()
+    return child.parentNode == m_index
+        || (parent.segment.isEmpty() && nodes.at(child.parentNode).parentNode == parent.parentNode);
+}
+
+QString InternedPath::lastPathSegment() const
+{
+    QReadLocker lock(&s_trie->lock);
+    const Node& node = s_trie->nodes.at(m_index);
+    if (node.remote && node.depth == 1) {
+        return QString();
+    }
+    return node.segment;
+}
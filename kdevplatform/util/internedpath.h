@@ -0,0 +1,139 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) version 3, or any
+ * later version accepted by the membership of KDE e.V. (or its
+ * successor approved by the membership of KDE e.V.), which shall
+ * act as a proxy defined in Section 6 of version 3 of the license.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KDEVELOP_INTERNEDPATH_H
+#define KDEVELOP_INTERNEDPATH_H
+
+#include "utilexport.h"
+
+#include <QMetaType>
+#include <QString>
+
+namespace KDevelop {
+
+class Path;
+
+/**
+ * @brief A Path interned into a global trie of path segments.
+ *
+ * Each node of the trie stands for the segment of a path below the node of
+ * its parent segment, so an interned path is nothing but the index of a node.
+ * Equal paths get the same index. Comparing and hashing interned paths thus
+ * never touches a string, and parent() and isDirectParentOf() take constant
+ * time. isParentOf() only walks up as many nodes as @p path is deeper.
+ *
+ * The trie is shared by all threads and lives as long as the process, so
+ * intern paths that are kept and compared often, e.g. those of a project.
+ *
+ * @code
+ * InternedPath foo(Path("/foo"));
+ * InternedPath bar(Path("/foo/bar"));
+ * foo == bar.parent(); // true
+ * bar.toPath(); // shares the segment strings with all other paths from the trie
+ * @endcode
+ *
+ * The semantics are those of Path, including those for remote paths and
+ * root paths.
+ */
+class KDEVPLATFORMUTIL_EXPORT InternedPath
+{
+public:
+    /**
+     * Construct an empty, invalid path.
+     */
+    InternedPath() = default;
+
+    /**
+     * Intern @p path.
+     */
+    explicit InternedPath(const Path& path);
+
+    /**
+     * @return the path, made from the segment strings stored in the trie.
+     */
+    Path toPath() const;
+
+    /**
+     * @return the index of the node of this path, 0 for an invalid path.
+     */
+    inline uint index() const
+    {
+        return m_index;
+    }
+
+    inline bool isValid() const
+    {
+        return m_index;
+    }
+
+    inline bool operator==(const InternedPath& other) const
+    {
+        return m_index == other.m_index;
+    }
+
+    inline bool operator!=(const InternedPath& other) const
+    {
+        return m_index != other.m_index;
+    }
+
+    /**
+     * @return the path pointing to the parent folder of this path, as Path::parent().
+     */
+    InternedPath parent() const;
+
+    /**
+     * @return true when this path has a parent, as Path::hasParent().
+     */
+    bool hasParent() const;
+
+    /**
+     * @return True if this path is the parent of @p path, as Path::isParentOf().
+     */
+    bool isParentOf(const InternedPath& path) const;
+
+    /**
+     * @return True if this path is the direct parent of @p path, as Path::isDirectParentOf().
+     */
+    bool isDirectParentOf(const InternedPath& path) const;
+
+    /**
+     * @return the last element of the path, as Path::lastPathSegment().
+     */
+    QString lastPathSegment() const;
+
+private:
+    explicit InternedPath(uint index)
+        : m_index(index)
+    {
+    }
+
+    uint m_index = 0;
+};
+
+inline uint qHash(const InternedPath& path)
+{
+    return path.index();
+}
+}
+
+Q_DECLARE_TYPEINFO(KDevelop::InternedPath, Q_PRIMITIVE_TYPE);
+Q_DECLARE_METATYPE(KDevelop::InternedPath)
+
+#endif // KDEVELOP_INTERNEDPATH_H
@@ -292,3 +292,11 @@ void KDevelop::normalizeLineEndings(QByteArray& text)
         }
     }
 }
+
+void KDevelop::appendKeepingLast(QStringList& output, const QStringList& lines, int maxLines)
+{
+    output += lines;
+    if (output.size() > 2 * maxLines) {
+        output.erase(output.begin(), output.end() - maxLines);
+    }
+}
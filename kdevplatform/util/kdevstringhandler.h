@@ -93,6 +93,14 @@ KDEVPLATFORMUTIL_EXPORT QString stripAnsiSequences(const QString& str);
  * Replace all occurrences of "\r" or "\r\n" in @p text with "\n".
  */
 KDEVPLATFORMUTIL_EXPORT void normalizeLineEndings(QByteArray& text);
+
+/**
+ * Append @p lines to @p output, keeping at least its last @p maxLines lines.
+ *
+ * Older lines are dropped once there are twice as many, so they are not removed one by one.
+ * Meant for keeping the tail of the output of long running tools for debugging.
+ */
+KDEVPLATFORMUTIL_EXPORT void appendKeepingLast(QStringList& output, const QStringList& lines, int maxLines = 1000);
 }
 
 #endif // KDEVPLATFORM_KDEVSTRINGHANDLER_H
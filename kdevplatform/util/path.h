@@ -346,6 +346,8 @@ public:
     Path cd(const QString& dir) const;
 
 private:
+    friend class InternedPath;
+
     // for remote urls the first element contains the a Path prefix
     // containing the protocol, user, port etc. pp.
     QVector<QString> m_data;
@@ -23,6 +23,7 @@
 #include "test_path.h"
 
 #include <util/path.h>
+#include <util/internedpath.h>
 
 #include <KIO/Global>
 
@@ -615,6 +616,80 @@ void TestPath::testHasParent()
     QTEST(path.hasParent(), "hasParent");
 }
 
+void TestPath::testInternedPath()
+{
+    QVector<Path> paths = {
+        Path(),
+        Path(QStringLiteral("/")),
+        Path(QStringLiteral("/foo")),
+        Path(QStringLiteral("/foo/bar")),
+        Path(QStringLiteral("/foo/bar/asdf.txt")),
+        Path(QStringLiteral("/foo/asdf")),
+        Path(QStringLiteral("/bar")),
+        Path(QStringLiteral("http://foo.bar")),
+        Path(QStringLiteral("http://foo.bar/asdf")),
+        Path(QStringLiteral("http://foo.bar/asdf/asdf")),
+        Path(QStringLiteral("http://foo.bar/foo/bar")),
+        Path(QStringLiteral("ftp://foo.bar/asdf")),
+    };
+
+    for (const Path& path : qAsConst(paths)) {
+        const InternedPath interned(path);
+        QCOMPARE(interned.isValid(), path.isValid());
+        QCOMPARE(interned.toPath(), path);
+        QCOMPARE(InternedPath(interned.toPath()), interned);
+        QCOMPARE(interned.parent(), InternedPath(path.parent()));
+        QCOMPARE(interned.hasParent(), path.hasParent());
+        QCOMPARE(interned.lastPathSegment(), path.lastPathSegment());
+
+        for (const Path& other : qAsConst(paths)) {
+            const InternedPath internedOther(other);
+            QCOMPARE(interned == internedOther, path == other);
+            QCOMPARE(interned.isParentOf(internedOther), path.isParentOf(other));
+            QCOMPARE(interned.isDirectParentOf(internedOther), path.isDirectParentOf(other));
+        }
+    }
+}
+
+void TestPath::bench_parentOf()
+{
+    QFETCH(bool, interned);
+
+    const auto paths = generateData(Path(QStringLiteral("/tmp/foo/bar")), 0);
+    const Path base(QStringLiteral("/tmp/foo/bar/folder2"));
+    if (interned) {
+        QVector<InternedPath> internedPaths;
+        internedPaths.reserve(paths.size());
+        for (const Path& path : paths) {
+            internedPaths << InternedPath(path);
+        }
+        const InternedPath internedBase(base);
+        QBENCHMARK {
+            int children = 0;
+            for (const InternedPath& path : qAsConst(internedPaths)) {
+                children += internedBase.isParentOf(path) || internedBase == path.parent();
+            }
+            Q_UNUSED(children);
+        }
+    } else {
+        QBENCHMARK {
+            int children = 0;
+            for (const Path& path : paths) {
+                children += base.isParentOf(path) || base == path.parent();
+            }
+            Q_UNUSED(children);
+        }
+    }
+}
+
+void TestPath::bench_parentOf_data()
+{
+    QTest::addColumn<bool>("interned");
+
+    QTest::newRow("Path") << false;
+    QTest::newRow("InternedPath") << true;
+}
+
 void TestPath::QUrl_acceptance()
 {
     const QUrl baseLocal = QUrl(QStringLiteral("file:///foo.h"));
@@ -35,6 +35,8 @@ private Q_SLOTS:
     void bench_fromLocalPath();
     void bench_fromLocalPath_data();
     void bench_hash();
+    void bench_parentOf();
+    void bench_parentOf_data();
 
     void testPath();
     void testPath_data();
@@ -50,6 +52,7 @@ private Q_SLOTS:
     void testPathCd_data();
     void testHasParent_data();
     void testHasParent();
+    void testInternedPath();
 
     void QUrl_acceptance();
 };
@@ -271,3 +271,17 @@ void TestStringHandler::testNormalizeLineEndings_data()
         << QByteArray("\r\n\n\r\r\r\n\r")
         << QByteArray("\n\n\n\n\n\n");
 }
+
+void TestStringHandler::testAppendKeepingLast()
+{
+    QStringList output;
+    appendKeepingLast(output, {QStringLiteral("1"), QStringLiteral("2"), QStringLiteral("3")}, 2);
+    QCOMPARE(output, QStringList({QStringLiteral("1"), QStringLiteral("2"), QStringLiteral("3")}));
+
+    appendKeepingLast(output, {QStringLiteral("4")}, 2);
+    QCOMPARE(output, QStringList({QStringLiteral("1"), QStringLiteral("2"), QStringLiteral("3"), QStringLiteral("4")}));
+
+    // more than twice as many, trimmed to the last ones
+    appendKeepingLast(output, {QStringLiteral("5")}, 2);
+    QCOMPARE(output, QStringList({QStringLiteral("4"), QStringLiteral("5")}));
+}
@@ -49,6 +49,8 @@ private Q_SLOTS:
 
     void testNormalizeLineEndings();
     void testNormalizeLineEndings_data();
+
+    void testAppendKeepingLast();
 };
 
 #endif // TESTSTRINGHANDLER_H
@@ -317,6 +317,13 @@ void DVcsJob::slotReceivedStdout()
     d->output.append(output);
 
     displayOutput(QString::fromLocal8Bit(output));
+
+    receivedStdout(output);
+}
+
+void DVcsJob::receivedStdout(const QByteArray& output)
+{
+    Q_UNUSED(output);
 }
 
 VcsJob::JobStatus DVcsJob::status() const
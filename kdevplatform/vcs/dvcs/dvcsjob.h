@@ -221,6 +221,13 @@ private Q_SLOTS:
 protected:
     bool doKill() override;
 
+    /**
+     * Called for each chunk of standard output as it arrives, while the
+     * process is still running. Lets subclasses parse long outputs as a
+     * stream instead of waiting for readyForParsing. Does nothing by default.
+     */
+    virtual void receivedStdout(const QByteArray& output);
+
 private:
     void jobIsReady();
 
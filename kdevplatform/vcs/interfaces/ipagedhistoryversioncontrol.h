@@ -0,0 +1,69 @@
+/* This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_IPAGEDHISTORYVERSIONCONTROL_H
+#define KDEVPLATFORM_IPAGEDHISTORYVERSIONCONTROL_H
+
+#include <QObject>
+
+class QUrl;
+
+namespace KDevelop
+{
+class VcsRevision;
+class VcsJob;
+
+/**
+ * This interface is used by version control systems which can list the
+ * history of large repositories page by page, such as git.
+ *
+ * The pages only carry the metadata of each revision, the items changed
+ * by a revision are fetched separately once they are needed.
+ */
+class IPagedHistoryVersionControl
+{
+public:
+    virtual ~IPagedHistoryVersionControl() {}
+
+    /**
+     * Retrieve one page of the history of a given local url
+     *
+     * The job returns a QList<QVariant> where the QVariant is a
+     * KDevelop::VcsEvent without item events, just like IBasicVersionControl::log.
+     *
+     * @param rev List @p rev and earlier.
+     * @param skip Number of the most recent entries to leave out.
+     * @param limit Maximum number of entries of the page.
+     */
+    virtual VcsJob* logPage(const QUrl& localLocation, const VcsRevision& rev,
+                            unsigned long skip, unsigned long limit) = 0;
+
+    /**
+     * Retrieve the items changed by the revision @p rev
+     *
+     * The job returns a QList<QVariant> where the QVariant is a
+     * KDevelop::VcsItemEvent.
+     */
+    virtual VcsJob* logItems(const QUrl& localLocation, const VcsRevision& rev) = 0;
+};
+
+}
+
+Q_DECLARE_INTERFACE( KDevelop::IPagedHistoryVersionControl, "org.kdevelop.IPagedHistoryVersionControl" )
+
+#endif
@@ -139,4 +139,46 @@ void TestModels::testVcsFileChangesModel()
     QCOMPARE(model->rowCount(), 2);
 }
 
+void TestModels::testVcsFileChangesModelBatchUpdate()
+{
+    const auto stateForUrl = [](const VcsFileChangesModel* model, const QUrl& url) {
+        const QModelIndex idx = model->match(model->index(0, 0), VcsFileChangesModel::UrlRole,
+                                             url, 1, Qt::MatchExactly).value(0);
+        return idx.data(VcsFileChangesModel::StateRole).value<VcsStatusInfo::State>();
+    };
+    const auto statusInfo = [](int i, VcsStatusInfo::State state) {
+        VcsStatusInfo status;
+        status.setUrl(QUrl::fromLocalFile(QStringLiteral("file%1").arg(i)));
+        status.setState(state);
+        return status;
+    };
+
+    VcsFileChangesModel model;
+
+    QList<VcsStatusInfo> statuses;
+    for (int i = 0; i < 10; ++i) {
+        statuses << statusInfo(i, VcsStatusInfo::ItemModified);
+    }
+    // up-to-date files are not added
+    statuses << statusInfo(10, VcsStatusInfo::ItemUpToDate);
+    model.updateStates(statuses);
+    QCOMPARE(model.rowCount(), 10);
+
+    // remove a range and single rows, update and add some in one go
+    statuses.clear();
+    for (int i : {2, 3, 4, 7, 9}) {
+        statuses << statusInfo(i, VcsStatusInfo::ItemUpToDate);
+    }
+    statuses << statusInfo(0, VcsStatusInfo::ItemAdded);
+    statuses << statusInfo(11, VcsStatusInfo::ItemDeleted);
+    model.updateStates(statuses);
+    QCOMPARE(model.rowCount(), 6);
+
+    QCOMPARE(stateForUrl(&model, statusInfo(0, {}).url()), VcsStatusInfo::ItemAdded);
+    for (int i : {1, 5, 6, 8}) {
+        QCOMPARE(stateForUrl(&model, statusInfo(i, {}).url()), VcsStatusInfo::ItemModified);
+    }
+    QCOMPARE(stateForUrl(&model, statusInfo(11, {}).url()), VcsStatusInfo::ItemDeleted);
+}
+
 QTEST_MAIN(TestModels)
@@ -25,6 +25,7 @@
 #include <QDateTime>
 #include <QList>
 #include <QLocale>
+#include <QSet>
 
 #include <KLocalizedString>
 
@@ -32,12 +33,17 @@
 #include "../vcsrevision.h"
 #include <vcsjob.h>
 #include <interfaces/ibasicversioncontrol.h>
+#include <interfaces/ipagedhistoryversioncontrol.h>
 #include <interfaces/icore.h>
+#include <interfaces/iplugin.h>
 #include <interfaces/iruncontroller.h>
 
 namespace KDevelop
 {
 
+/// Number of events requested by one call of fetchMore
+static const int LOG_PAGE_SIZE = 100;
+
 class VcsBasicEventModelPrivate
 {
 public:
@@ -124,6 +130,18 @@ void VcsBasicEventModel::addEvents(const QList<KDevelop::VcsEvent>& list)
     endInsertRows();
 }
 
+void VcsBasicEventModel::setEventItems(int row, const QList<KDevelop::VcsItemEvent>& items)
+{
+    Q_D(VcsBasicEventModel);
+
+    if (row < 0 || row >= rowCount()) {
+        return;
+    }
+
+    d->m_events[row].setItems(items);
+    emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+}
+
 KDevelop::VcsEvent VcsBasicEventModel::eventForIndex(const QModelIndex& idx) const
 {
     Q_D(const VcsBasicEventModel);
@@ -139,6 +157,9 @@ class VcsEventLogModelPrivate
 {
 public:
     KDevelop::IBasicVersionControl* m_iface;
+    KDevelop::IPagedHistoryVersionControl* m_pagedHistory;
+    /// Rows whose items were requested via fetchItems
+    QSet<int> m_itemRequests;
     VcsRevision m_rev;
     QUrl m_url;
     bool done;
@@ -152,6 +173,8 @@ VcsEventLogModel::VcsEventLogModel(KDevelop::IBasicVersionControl* iface, const
     Q_D(VcsEventLogModel);
 
     d->m_iface = iface;
+    auto* plugin = dynamic_cast<IPlugin*>(iface);
+    d->m_pagedHistory = plugin ? plugin->extension<IPagedHistoryVersionControl>() : nullptr;
     d->m_rev = rev;
     d->m_url = url;
     d->done = false;
@@ -174,7 +197,13 @@ void VcsEventLogModel::fetchMore(const QModelIndex& parent)
     d->fetching = true;
     Q_ASSERT(!parent.isValid());
     Q_UNUSED(parent);
-    VcsJob* job = d->m_iface->log(d->m_url, d->m_rev, qMax(rowCount(), 100));
+    VcsJob* job;
+    if (d->m_pagedHistory) {
+        // m_rev stays the start of the history, pages are counted from there
+        job = d->m_pagedHistory->logPage(d->m_url, d->m_rev, rowCount(), LOG_PAGE_SIZE);
+    } else {
+        job = d->m_iface->log(d->m_url, d->m_rev, LOG_PAGE_SIZE);
+    }
     connect(this, &VcsEventLogModel::destroyed, job, [job] { job->kill(); });
     connect(job, &VcsJob::finished, this, &VcsEventLogModel::jobReceivedResults);
     ICore::self()->runController()->registerJob( job );
@@ -196,13 +225,56 @@ void VcsEventLogModel::jobReceivedResults(KJob* job)
             newevents << v.value<KDevelop::VcsEvent>();
         }
     }
-    d->m_rev = newevents.last().revision();
-    if (rowCount()) {
-        newevents.removeFirst();
+    if (d->m_pagedHistory) {
+        d->done = newevents.size() < LOG_PAGE_SIZE;
+    } else {
+        // the next log starts with the last event we got
+        d->m_rev = newevents.last().revision();
+        if (rowCount()) {
+            newevents.removeFirst();
+        }
+        d->done = newevents.isEmpty();
     }
-    d->done = newevents.isEmpty();
     addEvents( newevents );
     d->fetching = false;
 }
 
+void VcsEventLogModel::fetchItems(const QModelIndex& index)
+{
+    Q_D(VcsEventLogModel);
+
+    if (!d->m_pagedHistory || !index.isValid() || index.row() >= rowCount()) {
+        return;
+    }
+
+    const int row = index.row();
+    if (d->m_itemRequests.contains(row)) {
+        return;
+    }
+    d->m_itemRequests.insert(row);
+
+    VcsJob* job = d->m_pagedHistory->logItems(d->m_url, eventForIndex(index).revision());
+    connect(this, &VcsEventLogModel::destroyed, job, [job] { job->kill(); });
+    connect(job, &VcsJob::finished, this, [this, row](KJob* job) {
+        Q_D(VcsEventLogModel);
+
+        if (job->error() != 0) {
+            // allow trying again
+            d->m_itemRequests.remove(row);
+            return;
+        }
+
+        const QList<QVariant> l = qobject_cast<KDevelop::VcsJob*>(job)->fetchResults().toList();
+        QList<KDevelop::VcsItemEvent> items;
+        items.reserve(l.size());
+        for (const QVariant& v : l) {
+            if (v.canConvert<KDevelop::VcsItemEvent>()) {
+                items << v.value<KDevelop::VcsItemEvent>();
+            }
+        }
+        setEventItems(row, items);
+    });
+    ICore::self()->runController()->registerJob(job);
+}
+
 }
@@ -34,6 +34,7 @@ namespace KDevelop
 class VcsRevision;
 class IBasicVersionControl;
 class VcsEvent;
+class VcsItemEvent;
 class VcsEventLogModelPrivate;
 class VcsBasicEventModelPrivate;
 
@@ -64,6 +65,8 @@ public:
 
 protected:
     void addEvents(const QList<KDevelop::VcsEvent>&);
+    /// Replaces the items of the event in @p row, emitting dataChanged for it
+    void setEventItems(int row, const QList<KDevelop::VcsItemEvent>& items);
 
 private:
     const QScopedPointer<class VcsBasicEventModelPrivate> d_ptr;
@@ -74,6 +77,10 @@ private:
  * This model stores a list of VcsEvents corresponding to the log obtained
  * via IBasicVersionControl::log for a given revision. The model is populated
  * lazily via @c fetchMore.
+ *
+ * If the version control implements IPagedHistoryVersionControl, the events
+ * are listed page by page without their items, which are only fetched for
+ * the events passed to @c fetchItems.
  */
 class KDEVPLATFORMVCS_EXPORT VcsEventLogModel : public VcsBasicEventModel
 {
@@ -87,6 +94,12 @@ public:
     void fetchMore(const QModelIndex& parent) override;
     bool canFetchMore(const QModelIndex& parent) const override;
 
+    /**
+     * Fetches the items of the event at @p index if they were not listed
+     * together with it. dataChanged is emitted for its row once they are set.
+     */
+    void fetchItems(const QModelIndex& index);
+
 private Q_SLOTS:
     void jobReceivedResults( KJob* job );
 
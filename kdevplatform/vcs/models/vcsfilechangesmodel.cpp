@@ -24,6 +24,7 @@
 
 #include "debug.h"
 
+#include <QHash>
 #include <QIcon>
 #include <QMimeDatabase>
 
@@ -34,6 +35,9 @@
 
 #include <vcs/vcsstatusinfo.h>
 
+#include <algorithm>
+#include <functional>
+
 namespace KDevelop
 {
 
@@ -133,9 +137,34 @@ private:
 class VcsFileChangesModelPrivate
 {
 public:
+    QList<QStandardItem*> createRow(const VcsStatusInfo& status) const;
+
     bool allowSelection;
 };
 
+QList<QStandardItem*> VcsFileChangesModelPrivate::createRow(const VcsStatusInfo& status) const
+{
+    QString path = ICore::self()->projectController()->prettyFileName(status.url(), KDevelop::IProjectController::FormatPlain);
+    QMimeType mime = status.url().isLocalFile()
+        ? QMimeDatabase().mimeTypeForFile(status.url().toLocalFile(), QMimeDatabase::MatchExtension)
+        : QMimeDatabase().mimeTypeForUrl(status.url());
+    QIcon icon = QIcon::fromTheme(mime.iconName());
+    auto* item = new QStandardItem(icon, path);
+    auto itStatus = new VcsStatusInfoItem(status);
+
+    if(allowSelection) {
+        item->setCheckable(true);
+        item->setCheckState(status.state() == VcsStatusInfo::ItemUnknown ? Qt::Unchecked : Qt::Checked);
+    }
+
+    return { item, itStatus };
+}
+
+static bool isRemovedState(VcsStatusInfo::State state)
+{
+    return state == VcsStatusInfo::ItemUnknown || state == VcsStatusInfo::ItemUpToDate;
+}
+
 VcsFileChangesModel::VcsFileChangesModel(QObject *parent, bool allowSelection)
     : QStandardItemModel(parent)
     , d_ptr(new VcsFileChangesModelPrivate{allowSelection})
@@ -153,26 +182,15 @@ int VcsFileChangesModel::updateState(QStandardItem *parent, const KDevelop::VcsS
 {
      Q_D(VcsFileChangesModel);
 
-   if(status.state()==VcsStatusInfo::ItemUnknown || status.state()==VcsStatusInfo::ItemUpToDate) {
+   if(isRemovedState(status.state())) {
         removeUrl(status.url());
         return -1;
     } else {
         QStandardItem* item = fileItemForUrl(parent, status.url());
         if(!item) {
-            QString path = ICore::self()->projectController()->prettyFileName(status.url(), KDevelop::IProjectController::FormatPlain);
-            QMimeType mime = status.url().isLocalFile()
-                ? QMimeDatabase().mimeTypeForFile(status.url().toLocalFile(), QMimeDatabase::MatchExtension)
-                : QMimeDatabase().mimeTypeForUrl(status.url());
-            QIcon icon = QIcon::fromTheme(mime.iconName());
-            item = new QStandardItem(icon, path);
-            auto itStatus = new VcsStatusInfoItem(status);
-
-            if(d->allowSelection) {
-                item->setCheckable(true);
-                item->setCheckState(status.state() == VcsStatusInfo::ItemUnknown ? Qt::Unchecked : Qt::Checked);
-            }
-
-            parent->appendRow({ item, itStatus });
+            const auto row = d->createRow(status);
+            item = row.first();
+            parent->appendRow(row);
         } else {
             QStandardItem *parent = item->parent();
             if(parent == nullptr)
@@ -185,6 +203,49 @@ int VcsFileChangesModel::updateState(QStandardItem *parent, const KDevelop::VcsS
     }
 }
 
+void VcsFileChangesModel::updateStates(QStandardItem* parent, const QList<KDevelop::VcsStatusInfo>& statuses)
+{
+    Q_D(VcsFileChangesModel);
+
+    Q_ASSERT(parent);
+
+    QHash<QUrl, int> rowForUrl;
+    rowForUrl.reserve(parent->rowCount());
+    for (int i = 0, c = parent->rowCount(); i < c; ++i) {
+        rowForUrl.insert(indexFromItem(parent->child(i)).data(UrlRole).toUrl(), i);
+    }
+
+    QVector<int> removedRows;
+    for (const VcsStatusInfo& status : statuses) {
+        const auto it = rowForUrl.find(status.url());
+        if (isRemovedState(status.state())) {
+            if (it != rowForUrl.end()) {
+                removedRows.append(*it);
+                rowForUrl.erase(it);
+            }
+        } else if (it == rowForUrl.end()) {
+            rowForUrl.insert(status.url(), parent->rowCount());
+            parent->appendRow(d->createRow(status));
+        } else {
+            static_cast<VcsStatusInfoItem*>(parent->child(*it, 1))->setStatus(status);
+        }
+    }
+
+    // remove from the bottom up, so the remaining rows stay valid,
+    // and each consecutive range in one go
+    std::sort(removedRows.begin(), removedRows.end(), std::greater<int>());
+    for (int i = 0; i < removedRows.size();) {
+        int first = removedRows.at(i);
+        int count = 1;
+        while (i + count < removedRows.size() && removedRows.at(i + count) == first - 1) {
+            --first;
+            ++count;
+        }
+        parent->removeRows(first, count);
+        i += count;
+    }
+}
+
 QVariant VcsFileChangesModel::data(const QModelIndex &index, int role) const
 {
     if (role >= VcsStatusInfoRole && index.column()==0) {
@@ -116,6 +116,14 @@ public Q_SLOTS:
         updateState(invisibleRootItem(), status);
     }
 
+    /**
+     * Same as @p updateState for many files at once, looking up the
+     * existing items only once.
+     */
+    void updateStates(const QList<KDevelop::VcsStatusInfo>& statuses) {
+        updateStates(invisibleRootItem(), statuses);
+    }
+
 protected:
     /**
      * Post update of status of some file.
@@ -123,6 +131,11 @@ protected:
      */
     int updateState(QStandardItem *parent, const KDevelop::VcsStatusInfo &status);
 
+    /**
+     * Post update of status of many files below @p parent.
+     */
+    void updateStates(QStandardItem *parent, const QList<KDevelop::VcsStatusInfo>& statuses);
+
     /**
      * Returns list of currently checked urls.
      */
@@ -120,6 +120,8 @@ void VcsEventWidgetPrivate::eventViewClicked( const QModelIndex &index )
             QLatin1String("<tt>") + KTextToHTML::convertToHtml(ev.message(), markupOptions) + QLatin1String("</tt>");
         m_ui->message->setHtml(markupMessage);
         m_detailModel->addItemEvents( ev.items() );
+        // the log may have listed the event without its items
+        m_logModel->fetchItems( index );
     }else
     {
         m_ui->itemEventView->setEnabled(false);
@@ -223,6 +225,15 @@ VcsEventWidget::VcsEventWidget( const QUrl& url, const VcsRevision& rev, KDevelo
 
     d->m_detailModel = new VcsItemEventModel(this);
     d->m_ui->itemEventView->setModel( d->m_detailModel );
+    // Show the items of the current event once they were fetched
+    connect(d->m_logModel, &QAbstractItemModel::dataChanged,
+            this, [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+        Q_D(VcsEventWidget);
+        const QModelIndex current = d->m_ui->eventView->currentIndex();
+        if (current.isValid() && current.row() >= topLeft.row() && current.row() <= bottomRight.row()) {
+            d->eventViewClicked(current);
+        }
+    });
 
     connect(d->m_ui->eventView, &QTreeView::clicked, this, [this] (const QModelIndex& index) {
         Q_D(VcsEventWidget);
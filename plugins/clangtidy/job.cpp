@@ -26,6 +26,7 @@
 #include <interfaces/icore.h>
 #include <interfaces/iuicontroller.h>
 #include <sublime/message.h>
+#include <util/kdevstringhandler.h>
 // KF
 #include <KLocalizedString>
 // Qt
@@ -88,6 +89,9 @@ Job::Job(const Parameters& params, QObject* parent)
     setCommand(commandLine.join(QLatin1Char(' ')), false);
     setToolDisplayName(QStringLiteral("Clang-Tidy"));
     setSources(m_parameters.filePaths);
+    // clang-tidy looks up its config from the directory of each file up to the root
+    enableResultCache(QStringLiteral("clang-tidy"), m_parameters.executablePath, commandLine.join(QLatin1Char(' ')),
+                      m_parameters.useConfigFile ? QStringList{QStringLiteral(".clang-tidy")} : QStringList());
 
     connect(&m_parser, &ClangTidyParser::problemsDetected,
             this, &Job::problemsDetected);
@@ -102,7 +106,7 @@ Job::~Job()
 void Job::processStdoutLines(const QStringList& lines)
 {
     m_parser.addData(lines);
-    m_standardOutput << lines;
+    KDevelop::appendKeepingLast(m_standardOutput, lines);
 }
 
 void Job::processStderrLines(const QStringList& lines)
@@ -119,9 +123,9 @@ void Job::processStderrLines(const QStringList& lines)
         // Therefore we must 'move' such messages to m_standardOutput.
 
         if (line.indexOf(xmlStartRegex) != -1) { // the line contains XML
-            m_xmlOutput << line;
+            KDevelop::appendKeepingLast(m_xmlOutput, {line});
         } else {
-            m_standardOutput << line;
+            KDevelop::appendKeepingLast(m_standardOutput, {line});
         }
     }
 }
@@ -77,6 +77,7 @@ protected:
 
 protected:
     ClangTidyParser m_parser;
+    // only the last lines, for debugging a failed run
     QStringList m_standardOutput;
     QStringList m_xmlOutput;
     const Job::Parameters m_parameters;
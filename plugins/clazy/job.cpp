@@ -28,6 +28,7 @@
 
 #include <language/editor/documentrange.h>
 #include <shell/problem.h>
+#include <util/kdevstringhandler.h>
 // KF
 #include <KLocalizedString>
 #include <KShell>
@@ -120,9 +121,11 @@ Job::Job(const JobParameters& params, QSharedPointer<const ChecksDB> db)
 
     setParallelJobCount(params.parallelJobCount);
     setBuildDirectoryRoot(params.buildDir);
-    setCommand(commandLineString(params), params.verboseOutput);
+    const QString commandLine = commandLineString(params);
+    setCommand(commandLine, params.verboseOutput);
     setToolDisplayName(QStringLiteral("Clazy"));
     setSources(params.filePaths);
+    enableResultCache(QStringLiteral("clazy"), params.executablePath, commandLine);
 }
 
 Job::~Job()
@@ -131,7 +134,7 @@ Job::~Job()
 
 void Job::processStdoutLines(const QStringList& lines)
 {
-    m_standardOutput << lines;
+    KDevelop::appendKeepingLast(m_standardOutput, lines);
 }
 
 void Job::processStderrLines(const QStringList& lines)
@@ -0,0 +1,160 @@
+/* This file is part of KDevelop
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include "cmakecompilecommands.h"
+
+#include <debug.h>
+
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace {
+const qint64 ChunkSize = 1024 * 1024;
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+}
+
+namespace CMake {
+namespace CompileCommands {
+Reader::Reader(QIODevice* device)
+    : m_device(device)
+{
+}
+
+bool Reader::fill()
+{
+    // drop what was read already, the entry which is read currently starts at m_pos
+    if (m_pos > 0) {
+        m_buffer.remove(0, m_pos);
+        m_pos = 0;
+    }
+    const auto chunk = m_device->read(ChunkSize);
+    if (chunk.isEmpty()) {
+        return false;
+    }
+    m_buffer += chunk;
+    return true;
+}
+
+bool Reader::fail(const QString& error)
+{
+    m_error = error;
+    m_buffer.clear();
+    m_pos = 0;
+    return false;
+}
+
+int Reader::valueLength()
+{
+    int length = 0;
+    int depth = 0;
+    bool inString = false;
+    bool escaped = false;
+    while (true) {
+        if (m_pos + length == m_buffer.size() && !fill()) {
+            return -1;
+        }
+        const char c = m_buffer.at(m_pos + length);
+        if (inString) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                inString = false;
+                if (depth == 0) {
+                    return length + 1;
+                }
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            ++depth;
+        } else if ((c == '}' || c == ']') && depth > 0) {
+            if (--depth == 0) {
+                return length + 1;
+            }
+        } else if (depth == 0 && (isSpace(c) || c == ',' || c == ']')) {
+            // the end of a number or a literal
+            return length;
+        }
+        ++length;
+    }
+}
+
+bool Reader::readNext(QJsonObject* entry)
+{
+    if (m_finished || !m_error.isEmpty()) {
+        return false;
+    }
+
+    while (true) {
+        // skip to the start of the next entry
+        if (m_pos == m_buffer.size() && !fill()) {
+            return fail(m_started ? QStringLiteral("unterminated array") : QStringLiteral("empty document"));
+        }
+        const char c = m_buffer.at(m_pos);
+        if (isSpace(c) || (m_started && c == ',')) {
+            ++m_pos;
+            continue;
+        } else if (!m_started) {
+            if (c != '[') {
+                return fail(QStringLiteral("document is not an array"));
+            }
+            m_started = true;
+            ++m_pos;
+            continue;
+        } else if (c == ']') {
+            m_finished = true;
+            return false;
+        }
+
+        // find the end of the entry, fill() keeps it at m_pos
+        const int length = valueLength();
+        if (length == -1) {
+            return fail(QStringLiteral("unterminated entry"));
+        }
+
+        const auto value = QByteArray::fromRawData(m_buffer.constData() + m_pos, length);
+        if (c != '{') {
+            qCWarning(CMAKE) << "JSON command file entry is not an object:" << value;
+            m_pos += length;
+            continue;
+        }
+
+        QJsonParseError error;
+        const auto document = QJsonDocument::fromJson(value, &error);
+        if (error.error) {
+            return fail(error.errorString());
+        }
+        m_pos += length;
+        *entry = document.object();
+        return true;
+    }
+}
+
+QString Reader::errorString() const
+{
+    return m_error;
+}
+}
+}
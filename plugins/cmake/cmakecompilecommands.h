@@ -0,0 +1,71 @@
+/* This file is part of KDevelop
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cmakecommonexport.h>
+
+class QIODevice;
+class QJsonObject;
+
+/// see: https://clang.llvm.org/docs/JSONCompilationDatabase.html
+namespace CMake {
+namespace CompileCommands {
+/**
+ * Reads the entries of a compilation database (compile_commands.json) one after the other.
+ *
+ * The device is read in chunks and only the current entry is parsed, so the
+ * whole document is never held in memory. This also allows databases which are
+ * too large for QJsonDocument.
+ */
+class KDEVCMAKECOMMON_EXPORT Reader
+{
+public:
+    explicit Reader(QIODevice* device);
+
+    /**
+     * Reads the next entry into @p entry. Entries which are not objects are skipped.
+     *
+     * @returns false at the end of the database or when it is invalid, see errorString()
+     */
+    bool readNext(QJsonObject* entry);
+
+    /**
+     * @returns why the database could not be read, or an empty string if it is valid so far
+     */
+    QString errorString() const;
+
+private:
+    bool fill();
+    /// the length of the JSON value at m_pos, -1 if the device ends before it
+    int valueLength();
+    bool fail(const QString& error);
+
+    QIODevice* const m_device;
+    QByteArray m_buffer;
+    /// the position in m_buffer up to which everything was read
+    int m_pos = 0;
+    bool m_started = false;
+    bool m_finished = false;
+    QString m_error;
+};
+}
+}
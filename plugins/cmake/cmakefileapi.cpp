@@ -20,13 +20,18 @@
 
 #include "cmakefileapi.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QVersionNumber>
+#include <QtConcurrentMap>
 
 #include <makefileresolver/makefileresolver.h>
 
@@ -71,6 +76,168 @@ bool isKDevelopClientResponse(const QJsonObject& indexObject)
 {
     return indexObject.value(QLatin1String("reply")).toObject().contains(QLatin1String("client-kdevelop"));
 }
+
+const quint32 CodeModelCacheVersion = 1;
+
+QString codeModelCachePath(const Path& buildDirectory)
+{
+    const auto key = QCryptographicHash::hash(buildDirectory.pathOrUrl().toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + QLatin1String("/cmakefileapi/") + QString::fromLatin1(key);
+}
+
+QByteArray replyIndexHash(const QJsonObject& replyIndex, const Path& sourceDirectory)
+{
+    // the reply files are named after their content hash, so an equal index means equal replies
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QJsonDocument(replyIndex).toJson(QJsonDocument::Compact));
+    hash.addData(sourceDirectory.pathOrUrl().toUtf8());
+    return hash.result();
+}
+
+void writePaths(QDataStream& stream, const Path::List& paths)
+{
+    stream << static_cast<quint32>(paths.size());
+    for (const auto& path : paths) {
+        stream << path.pathOrUrl();
+    }
+}
+
+Path readPath(QDataStream& stream)
+{
+    QString path;
+    stream >> path;
+    return Path(path);
+}
+
+Path::List readPaths(QDataStream& stream)
+{
+    quint32 size = 0;
+    stream >> size;
+    Path::List paths;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        paths.append(readPath(stream));
+    }
+    return paths;
+}
+
+void storeCodeModel(const QString& cachePath, const QByteArray& indexHash, const CMakeProjectData& data)
+{
+    if (!QDir().mkpath(QFileInfo(cachePath).absolutePath())) {
+        return;
+    }
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream << CodeModelCacheVersion << indexHash;
+
+    const auto& compilationData = data.compilationData;
+    stream << static_cast<quint32>(compilationData.settings.size());
+    for (const auto& settings : compilationData.settings) {
+        writePaths(stream, settings.includes);
+        writePaths(stream, settings.frameworkDirectories);
+        stream << settings.compileFlags << settings.language << settings.defines;
+    }
+    stream << static_cast<quint32>(compilationData.files.size());
+    for (auto it = compilationData.files.constBegin(), end = compilationData.files.constEnd(); it != end; ++it) {
+        stream << it.key().pathOrUrl() << static_cast<qint32>(it.value());
+    }
+
+    stream << static_cast<quint32>(data.targets.size());
+    for (auto it = data.targets.constBegin(), end = data.targets.constEnd(); it != end; ++it) {
+        stream << it.key().pathOrUrl() << static_cast<quint32>(it->size());
+        for (const auto& target : *it) {
+            stream << static_cast<qint32>(target.type) << target.name;
+            writePaths(stream, target.artifacts);
+            writePaths(stream, target.sources);
+            stream << target.folder;
+        }
+    }
+
+    stream << static_cast<quint32>(data.cmakeFiles.size());
+    for (auto it = data.cmakeFiles.constBegin(), end = data.cmakeFiles.constEnd(); it != end; ++it) {
+        stream << it.key().pathOrUrl() << it->isGenerated << it->isExternal << it->isCMake;
+    }
+
+    if (!file.commit()) {
+        qCWarning(CMAKE) << "failed to store the code model in" << cachePath;
+    }
+}
+
+bool loadCodeModel(const QString& cachePath, const QByteArray& indexHash, CMakeProjectData* data)
+{
+    QFile file(cachePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 version = 0;
+    QByteArray hash;
+    stream >> version;
+    if (version != CodeModelCacheVersion) {
+        return false;
+    }
+    stream >> hash;
+    if (hash != indexHash) {
+        return false;
+    }
+
+    auto& compilationData = data->compilationData;
+    quint32 size = 0;
+    stream >> size;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        CMakeFile settings;
+        settings.includes = readPaths(stream);
+        settings.frameworkDirectories = readPaths(stream);
+        stream >> settings.compileFlags >> settings.language >> settings.defines;
+        compilationData.settingsIds.insert(settings, compilationData.settings.size());
+        compilationData.settings.append(settings);
+    }
+    stream >> size;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        const auto path = readPath(stream);
+        qint32 id = -1;
+        stream >> id;
+        if (id < 0 || id >= compilationData.settings.size()) {
+            return false;
+        }
+        compilationData.files.insert(path, id);
+    }
+
+    stream >> size;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        auto& targets = data->targets[readPath(stream)];
+        quint32 targetCount = 0;
+        stream >> targetCount;
+        for (quint32 j = 0; j < targetCount && stream.status() == QDataStream::Ok; ++j) {
+            CMakeTarget target;
+            qint32 type = 0;
+            stream >> type >> target.name;
+            target.type = static_cast<CMakeTarget::Type>(type);
+            target.artifacts = readPaths(stream);
+            target.sources = readPaths(stream);
+            stream >> target.folder;
+            targets.append(target);
+        }
+    }
+
+    stream >> size;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        auto& flags = data->cmakeFiles[readPath(stream)];
+        stream >> flags.isGenerated >> flags.isExternal >> flags.isCMake;
+    }
+
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+    compilationData.isValid = true;
+    compilationData.rebuildFileForFolderMapping();
+    return true;
+}
 }
 
 namespace CMake {
@@ -184,7 +351,7 @@ static CMakeTarget parseTarget(const QJsonObject& target, StringInterner& string
         const auto compileGroup = compileGroups.value(compileGroupIndex);
         const auto path = sourcePathInterner.internPath(source.value(QLatin1String("path")).toString());
         if (path.isValid()) {
-            compilationData.files[toCanonical(path)] = compileGroup;
+            compilationData.setFile(toCanonical(path), compileGroup);
         }
     }
     return ret;
@@ -198,28 +365,37 @@ static CMakeProjectData parseCodeModel(const QJsonObject& codeModel, const QDir&
     const auto configuration = codeModel.value(QLatin1String("configurations")).toArray().at(0).toObject();
     const auto targets = configuration.value(QLatin1String("targets")).toArray();
     const auto directories = configuration.value(QLatin1String("directories")).toArray();
+    QVector<Path> targetDirectories;
+    QStringList targetFiles;
     for (const auto& directoryValue : directories) {
         const auto directory = directoryValue.toObject();
         if (!directory.contains(QLatin1String("targetIndexes"))) {
             continue;
         }
         const auto dirSourcePath = sourcePathInterner.internPath(directory.value(QLatin1String("source")).toString());
-        auto& dirTargets = ret.targets[dirSourcePath];
+        // the directory gets an entry even if none of its targets can be read
+        ret.targets[dirSourcePath];
         for (const auto& targetIndex : directory.value(QLatin1String("targetIndexes")).toArray()) {
             const auto jsonTarget = targets.at(targetIndex.toInt(-1)).toObject();
             if (jsonTarget.isEmpty()) {
                 continue;
             }
             const auto targetFile = jsonTarget.value(QLatin1String("jsonFile")).toString();
-            const auto target = parseTarget(parseFile(replyDir.absoluteFilePath(targetFile)),
-                                            stringInterner, sourcePathInterner, buildPathInterner,
-                                            ret.compilationData);
-            if (target.name.isEmpty()) {
-                continue;
-            }
-            dirTargets.append(target);
+            targetDirectories.append(dirSourcePath);
+            targetFiles.append(replyDir.absoluteFilePath(targetFile));
         }
     }
+
+    // reading the target files takes most of the time, they are independent of each other
+    const auto jsonTargets = QtConcurrent::blockingMapped<QVector<QJsonObject>>(targetFiles, parseFile);
+    for (int i = 0; i < jsonTargets.size(); ++i) {
+        const auto target = parseTarget(jsonTargets.at(i), stringInterner, sourcePathInterner, buildPathInterner,
+                                        ret.compilationData);
+        if (target.name.isEmpty()) {
+            continue;
+        }
+        ret.targets[targetDirectories.at(i)].append(target);
+    }
     ret.compilationData.isValid = !codeModel.isEmpty();
     ret.compilationData.rebuildFileForFolderMapping();
     if (!ret.compilationData.isValid) {
@@ -282,5 +458,25 @@ CMakeProjectData parseReplyIndexFile(const QJsonObject& replyIndex,
     codeModel.cmakeFiles = cmakeFiles;
     return codeModel;
 }
+
+CMakeProjectData parseReplyIndexFileCached(const QJsonObject& replyIndex,
+                                           const Path& sourceDirectory,
+                                           const Path& buildDirectory)
+{
+    const auto cachePath = codeModelCachePath(buildDirectory);
+    const auto indexHash = replyIndexHash(replyIndex, sourceDirectory);
+
+    CMakeProjectData codeModel;
+    if (loadCodeModel(cachePath, indexHash, &codeModel)) {
+        qCDebug(CMAKE) << "reply index unchanged, reusing the code model of" << buildDirectory;
+        return codeModel;
+    }
+
+    codeModel = parseReplyIndexFile(replyIndex, sourceDirectory, buildDirectory);
+    if (codeModel.compilationData.isValid) {
+        storeCodeModel(cachePath, indexHash, codeModel);
+    }
+    return codeModel;
+}
 }
 }
@@ -62,5 +62,13 @@ KDEVCMAKECOMMON_EXPORT QJsonObject findReplyIndexFile(const QString &buildDirect
 KDEVCMAKECOMMON_EXPORT CMakeProjectData parseReplyIndexFile(const QJsonObject& replyIndex,
                                                             const KDevelop::Path& sourceDirectory,
                                                             const KDevelop::Path& buildDirectory);
+
+/**
+ * Like parseReplyIndexFile, but reuses the code model parsed from an equal @p replyIndex before,
+ * also in an earlier session. The code models are cached per @p buildDirectory.
+ */
+KDEVCMAKECOMMON_EXPORT CMakeProjectData parseReplyIndexFileCached(const QJsonObject& replyIndex,
+                                                                  const KDevelop::Path& sourceDirectory,
+                                                                  const KDevelop::Path& buildDirectory);
 }
 }
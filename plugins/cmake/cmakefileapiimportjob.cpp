@@ -59,7 +59,7 @@ void ImportJob::start()
         if (replyIndex.isEmpty()) {
             return {};
         }
-        auto ret = parseReplyIndexFile(replyIndex, sourceDirectory, buildDirectory);
+        auto ret = parseReplyIndexFileCached(replyIndex, sourceDirectory, buildDirectory);
         if (!ret.compilationData.isValid) {
             return ret;
         }
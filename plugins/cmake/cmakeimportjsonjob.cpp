@@ -21,6 +21,7 @@
 #include "cmakeimportjsonjob.h"
 
 #include "cmakeutils.h"
+#include "cmakecompilecommands.h"
 #include "cmakeprojectdata.h"
 #include "cmakemodelitems.h"
 #include "debug.h"
@@ -38,6 +39,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QtConcurrentRun>
+#include <QFuture>
 #include <QFutureWatcher>
 #include <QRegularExpression>
 
@@ -45,6 +47,36 @@ using namespace KDevelop;
 
 namespace {
 
+using ResolvedFiles = QVector<QPair<Path, CMakeFile>>;
+
+ResolvedFiles resolveCommands(const QVector<QJsonObject>& entries, IRuntime* rt)
+{
+    MakeFileResolver resolver;
+    const QString KEY_COMMAND = QStringLiteral("command");
+    const QString KEY_DIRECTORY = QStringLiteral("directory");
+    const QString KEY_FILE = QStringLiteral("file");
+    auto convert = [rt](const Path &path) { return rt->pathInHost(path); };
+
+    ResolvedFiles files;
+    files.reserve(entries.size());
+    for (const QJsonObject& entry : entries) {
+        if (!entry.contains(KEY_FILE) || !entry.contains(KEY_COMMAND) || !entry.contains(KEY_DIRECTORY)) {
+            qCWarning(CMAKE) << "JSON command file entry does not contain required keys:" << entry;
+            continue;
+        }
+
+        PathResolutionResult result = resolver.processOutput(entry[KEY_COMMAND].toString(), entry[KEY_DIRECTORY].toString());
+
+        CMakeFile ret;
+        ret.includes = kTransform<Path::List>(result.paths, convert);
+        ret.frameworkDirectories = kTransform<Path::List>(result.frameworkDirectories, convert);
+        ret.defines = result.defines;
+        const Path path(rt->pathInHost(Path(entry[KEY_FILE].toString())));
+        files.append({path, ret});
+    }
+    return files;
+}
+
 CMakeFilesCompilationData importCommands(const Path& commandsFile)
 {
     // NOTE: to get compile_commands.json, you need -DCMAKE_EXPORT_COMPILE_COMMANDS=ON
@@ -57,47 +89,38 @@ CMakeFilesCompilationData importCommands(const Path& commandsFile)
 
     qCDebug(CMAKE) << "Found commands file" << commandsFile;
 
+    // the entries are resolved in batches on the thread pool while the rest of the file is read
+    const int batchSize = 1000;
+    auto rt = ICore::self()->runtimeController()->currentRuntime();
+    CMake::CompileCommands::Reader reader(&f);
+    QVector<QFuture<ResolvedFiles>> batches;
+    QVector<QJsonObject> entries;
+    entries.reserve(batchSize);
+    QJsonObject entry;
+    while (reader.readNext(&entry)) {
+        entries.append(entry);
+        if (entries.size() == batchSize) {
+            batches.append(QtConcurrent::run(resolveCommands, entries, rt));
+            entries.clear();
+        }
+    }
+
     CMakeFilesCompilationData data;
-    QJsonParseError error;
-    const QJsonDocument document = QJsonDocument::fromJson(f.readAll(), &error);
-    if (error.error) {
-        qCWarning(CMAKE) << "Failed to parse JSON in commands file:" << error.errorString() << commandsFile;
-        data.isValid = false;
-        return data;
-    } else if (!document.isArray()) {
-        qCWarning(CMAKE) << "JSON document in commands file is not an array: " << commandsFile;
+    if (!reader.errorString().isEmpty()) {
+        qCWarning(CMAKE) << "Failed to read commands file:" << reader.errorString() << commandsFile;
         data.isValid = false;
         return data;
     }
+    if (!entries.isEmpty()) {
+        batches.append(QtConcurrent::run(resolveCommands, entries, rt));
+    }
 
-    MakeFileResolver resolver;
-    const QString KEY_COMMAND = QStringLiteral("command");
-    const QString KEY_DIRECTORY = QStringLiteral("directory");
-    const QString KEY_FILE = QStringLiteral("file");
-    auto rt = ICore::self()->runtimeController()->currentRuntime();
-    const auto values = document.array();
-    for (const QJsonValue& value : values) {
-        if (!value.isObject()) {
-            qCWarning(CMAKE) << "JSON command file entry is not an object:" << value;
-            continue;
-        }
-        const QJsonObject entry = value.toObject();
-        if (!entry.contains(KEY_FILE) || !entry.contains(KEY_COMMAND) || !entry.contains(KEY_DIRECTORY)) {
-            qCWarning(CMAKE) << "JSON command file entry does not contain required keys:" << entry;
-            continue;
+    // merge in the order of the file, so later entries for a file win as before
+    for (const auto& batch : qAsConst(batches)) {
+        const auto files = batch.result();
+        for (const auto& file : files) {
+            data.setFile(file.first, file.second);
         }
-
-        PathResolutionResult result = resolver.processOutput(entry[KEY_COMMAND].toString(), entry[KEY_DIRECTORY].toString());
-
-        auto convert = [rt](const Path &path) { return rt->pathInHost(path); };
-
-        CMakeFile ret;
-        ret.includes = kTransform<Path::List>(result.paths, convert);
-        ret.frameworkDirectories = kTransform<Path::List>(result.frameworkDirectories, convert);
-        ret.defines = result.defines;
-        const Path path(rt->pathInHost(Path(entry[KEY_FILE].toString())));
-        qCDebug(CMAKE) << "entering..." << path << entry[KEY_FILE];
-        data.files[path] = ret;
     }
 
     data.isValid = true;
@@ -111,7 +111,8 @@ CMakeManager::~CMakeManager()
 
 bool CMakeManager::hasBuildInfo(ProjectBaseItem* item) const
 {
-    return m_projects[item->project()].data.compilationData.files.contains(item->path());
+    const auto projectIt = m_projects.constFind(item->project());
+    return projectIt != m_projects.constEnd() && projectIt->data.compilationData.files.contains(item->path());
 }
 
 Path CMakeManager::buildDirectory(KDevelop::ProjectBaseItem *item) const
@@ -240,7 +241,12 @@ QList<KDevelop::ProjectTargetItem*> CMakeManager::targets() const
 
 CMakeFile CMakeManager::fileInformation(KDevelop::ProjectBaseItem* item) const
 {
-    const auto& data = m_projects[item->project()].data.compilationData;
+    const auto projectIt = m_projects.constFind(item->project());
+    if (projectIt == m_projects.constEnd()) {
+        return {};
+    }
+    // the settings are shared by all files compiled the same way, returning them only copies references
+    const auto& data = projectIt->data.compilationData;
 
     auto toCanonicalPath = [](const Path &path) -> Path {
         // if the path contains a symlink, then we will not find it in the lookup table
@@ -254,16 +260,16 @@ CMakeFile CMakeManager::fileInformation(KDevelop::ProjectBaseItem* item) const
     auto path = item->path();
     if (!item->folder()) {
         // try to look for file meta data directly
-        auto it = data.files.find(path);
-        if (it == data.files.end()) {
+        auto file = data.file(path);
+        if (!file) {
             // fallback to canonical path lookup
             auto canonical = toCanonicalPath(path);
             if (canonical != path) {
-                it = data.files.find(canonical);
+                file = data.file(canonical);
             }
         }
-        if (it != data.files.end()) {
-            return *it;
+        if (file) {
+            return *file;
         }
         // else look for a file in the parent folder
         path = path.parent();
@@ -271,16 +277,18 @@ CMakeFile CMakeManager::fileInformation(KDevelop::ProjectBaseItem* item) const
 
     while (true) {
         // try to look for a file in the current folder path
-        auto it = data.fileForFolder.find(path);
-        if (it == data.fileForFolder.end()) {
+        auto it = data.fileForFolder.constFind(path);
+        if (it == data.fileForFolder.constEnd()) {
             // fallback to canonical path lookup
             auto canonical = toCanonicalPath(path);
             if (canonical != path) {
-                it = data.fileForFolder.find(canonical);
+                it = data.fileForFolder.constFind(canonical);
             }
         }
-        if (it != data.fileForFolder.end()) {
-            return data.files[it.value()];
+        if (it != data.fileForFolder.constEnd()) {
+            if (const auto file = data.file(it.value())) {
+                return *file;
+            }
         }
         if (!path.hasParent()) {
             break;
@@ -680,7 +688,10 @@ KDevelop::Path CMakeManager::compiler(KDevelop::ProjectTargetItem* item) const
         return {};
     }
 
-    const auto info = m_projects[item->project()].data.compilationData.files[targetInfo.sources.constFirst()];
+    const auto projectIt = m_projects.constFind(item->project());
+    const auto file = projectIt == m_projects.constEnd() ? nullptr
+                    : projectIt->data.compilationData.file(targetInfo.sources.constFirst());
+    const auto info = file ? *file : CMakeFile();
     const auto lang = info.language;
     if (lang.isEmpty()) {
         qCDebug(CMAKE) << "no language for" << item << item->text() << info.defines << targetInfo.sources.constFirst();
@@ -33,6 +33,38 @@ void CMakeFile::addDefine(const QString& define)
     }
 }
 
+uint qHash(const CMakeFile& file, uint seed)
+{
+    // the order of the defines in the hash is not defined, so combine them commutatively
+    uint definesHash = 0;
+    for (auto it = file.defines.constBegin(), end = file.defines.constEnd(); it != end; ++it) {
+        definesHash += qHash(it.key(), seed) ^ qHash(it.value(), seed);
+    }
+    uint hash = qHashRange(file.includes.constBegin(), file.includes.constEnd(), seed);
+    hash ^= qHashRange(file.frameworkDirectories.constBegin(), file.frameworkDirectories.constEnd(), seed) * 31;
+    hash ^= qHash(file.compileFlags, seed) * 37;
+    hash ^= qHash(file.language, seed) * 41;
+    return hash ^ definesHash;
+}
+
+void CMakeFilesCompilationData::setFile(const KDevelop::Path& path, const CMakeFile& file)
+{
+    auto it = settingsIds.constFind(file);
+    if (it == settingsIds.constEnd()) {
+        it = settingsIds.insert(file, settings.size());
+        settings.append(file);
+    }
+    files.insert(path, *it);
+}
+
+void CMakeFilesCompilationData::clear()
+{
+    settings.clear();
+    files.clear();
+    settingsIds.clear();
+    fileForFolder.clear();
+}
+
 void CMakeFilesCompilationData::rebuildFileForFolderMapping()
 {
     fileForFolder.clear();
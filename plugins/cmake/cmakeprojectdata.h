@@ -24,6 +24,7 @@
 #include <QSharedPointer>
 #include <QStringList>
 #include <QHash>
+#include <QVector>
 #include <util/path.h>
 #include <QDebug>
 
@@ -55,21 +56,55 @@ struct KDEVCMAKECOMMON_EXPORT CMakeFile
 };
 Q_DECLARE_TYPEINFO(CMakeFile, Q_MOVABLE_TYPE);
 
+inline bool operator==(const CMakeFile& lhs, const CMakeFile& rhs)
+{
+    return lhs.includes == rhs.includes
+        && lhs.frameworkDirectories == rhs.frameworkDirectories
+        && lhs.compileFlags == rhs.compileFlags
+        && lhs.language == rhs.language
+        && lhs.defines == rhs.defines;
+}
+
+KDEVCMAKECOMMON_EXPORT uint qHash(const CMakeFile& file, uint seed = 0);
+
 inline QDebug &operator<<(QDebug debug, const CMakeFile& file)
 {
     debug << "CMakeFile(-I" << file.includes << ", -F" << file.frameworkDirectories << ", -D" << file.defines << ", " << file.language << ")";
     return debug.maybeSpace();
 }
 
+/**
+ * The compile settings of the files of a cmake project.
+ *
+ * Usually all files of a target are compiled the same way, so every distinct
+ * set of settings is stored once and the files refer to it by its index.
+ */
 struct KDEVCMAKECOMMON_EXPORT CMakeFilesCompilationData
 {
-    QHash<KDevelop::Path, CMakeFile> files;
+    /// the distinct compile settings, never modify them in place as they are shared
+    QVector<CMakeFile> settings;
+    /// index into @c settings for each file
+    QHash<KDevelop::Path, int> files;
+    /// reverse lookup for @c settings, to find the index of settings which are stored already
+    QHash<CMakeFile, int> settingsIds;
     bool isValid = false;
     /// lookup table to quickly find a file path for a given folder path
     /// this greatly speeds up fallback searching for information on untracked files
     /// based on their folder path
     QHash<KDevelop::Path, KDevelop::Path> fileForFolder;
     void rebuildFileForFolderMapping();
+
+    /// Sets the compile settings of @p path, sharing them with the files which have equal ones
+    void setFile(const KDevelop::Path& path, const CMakeFile& file);
+
+    /// @return the compile settings of @p path, or nullptr if it has none
+    const CMakeFile* file(const KDevelop::Path& path) const
+    {
+        const auto it = files.constFind(path);
+        return it == files.constEnd() ? nullptr : &settings.at(*it);
+    }
+
+    void clear();
 };
 
 struct KDEVCMAKECOMMON_EXPORT CMakeTarget
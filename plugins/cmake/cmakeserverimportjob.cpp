@@ -41,7 +41,7 @@ void CMakeServerImportJob::processCodeModel(const QJsonObject &response, CMakePr
     qCDebug(CMAKE) << "process response" << response;
 
     data.targets.clear();
-    data.compilationData.files.clear();
+    data.compilationData.clear();
 
     StringInterner stringInterner;
 
@@ -85,7 +85,7 @@ void CMakeServerImportJob::processCodeModel(const QJsonObject &response, CMakePr
                         const auto canonicalFile = QFileInfo(source.toLocalFile()).canonicalFilePath();
                         const auto sourcePath = (canonicalFile.isEmpty() || localFile.toLocalFile() == canonicalFile)
                                               ? localFile : KDevelop::Path(canonicalFile);
-                        data.compilationData.files[sourcePath] = file;
+                        data.compilationData.setFile(sourcePath, file);
                         targetSources << sourcePath;
                     }
                     qCDebug(CMAKE) << "registering..." << sources << file;
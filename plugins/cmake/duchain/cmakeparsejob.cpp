@@ -95,7 +95,9 @@ void CMakeParseJob::run(ThreadWeaver::JobPointer /*self*/, ThreadWeaver::Thread*
         context->addImportedParentContext(parentCtx);
     }
 
-    CMakeFileContent package = CMakeListsParser::readCMakeFile(document().toUrl().toLocalFile());
+    // parse what readContents() read, also the unsaved changes, instead of reading the file again
+    CMakeFileContent package = CMakeListsParser::readCMakeContentsCached(contents().contents,
+                                                                         document().toUrl().toLocalFile());
     if (!package.isEmpty()) {
         if (abortRequested()) {
             abortJob();
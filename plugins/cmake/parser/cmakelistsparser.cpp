@@ -23,7 +23,11 @@
 #include <debug.h>
 
 #include <util/stack.h>
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
 
 QMap<QChar, QChar> whatToScape()
 {
@@ -101,19 +105,9 @@ namespace CMakeListsParser
 
 static bool readCMakeFunction( cmListFileLexer* lexer, CMakeFunctionDesc& func);
 
-CMakeFileContent readCMakeFile(const QString & _fileName)
+static CMakeFileContent readCMakeLexer(cmListFileLexer* lexer, const QString& fileName)
 {
-    cmListFileLexer* lexer = cmListFileLexer_New();
-    if ( !lexer )
-        return CMakeFileContent();
-    if ( !cmListFileLexer_SetFileName( lexer, qPrintable( _fileName ), nullptr ) ) {
-        qCDebug(CMAKE) << "cmake read error. could not read " << _fileName;
-        cmListFileLexer_Delete(lexer);
-        return CMakeFileContent();
-    }
-
     CMakeFileContent ret;
-    QString fileName = QDir::cleanPath(_fileName);
 
     bool readError = false, haveNewline = true;
     cmListFileLexer_Token* token;
@@ -152,6 +146,125 @@ CMakeFileContent readCMakeFile(const QString & _fileName)
     return ret;
 }
 
+CMakeFileContent readCMakeFile(const QString & _fileName)
+{
+    cmListFileLexer* lexer = cmListFileLexer_New();
+    if ( !lexer )
+        return CMakeFileContent();
+    if ( !cmListFileLexer_SetFileName( lexer, qPrintable( _fileName ), nullptr ) ) {
+        qCDebug(CMAKE) << "cmake read error. could not read " << _fileName;
+        cmListFileLexer_Delete(lexer);
+        return CMakeFileContent();
+    }
+
+    return readCMakeLexer(lexer, QDir::cleanPath(_fileName));
+}
+
+CMakeFileContent readCMakeContents(const QByteArray& contents, const QString& fileName)
+{
+    cmListFileLexer* lexer = cmListFileLexer_New();
+    if ( !lexer )
+        return CMakeFileContent();
+    // the lexer only converts the line endings when reading a file
+    QByteArray text = contents;
+    text.replace("\r\n", "\n");
+    if ( !cmListFileLexer_SetString( lexer, text.constData() ) ) {
+        cmListFileLexer_Delete(lexer);
+        return CMakeFileContent();
+    }
+
+    return readCMakeLexer(lexer, QDir::cleanPath(fileName));
+}
+
+static const quint32 ContentCacheVersion = 2;
+
+static QString contentCachePath(const QString& fileName)
+{
+    const auto key = QCryptographicHash::hash(fileName.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + QLatin1String("/cmakelists/") + QString::fromLatin1(key);
+}
+
+static void storeContent(const QString& cachePath, const QByteArray& contentsHash, const CMakeFileContent& content)
+{
+    if (!QDir().mkpath(QFileInfo(cachePath).absolutePath())) {
+        return;
+    }
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    // the file path is the same for all the functions, and known when loading
+    QDataStream stream(&file);
+    stream << ContentCacheVersion << contentsHash << static_cast<quint32>(content.size());
+    for (const auto& function : content) {
+        stream << function.name << function.line << function.column << function.endLine << function.endColumn
+               << static_cast<quint32>(function.arguments.size());
+        for (const auto& argument : function.arguments) {
+            stream << argument.value << argument.quoted << argument.line << argument.column;
+        }
+    }
+
+    if (!file.commit()) {
+        qCDebug(CMAKE) << "failed to cache the contents of" << cachePath << file.errorString();
+    }
+}
+
+static bool loadContent(const QString& cachePath, const QByteArray& contentsHash, const QString& fileName,
+                        CMakeFileContent* content)
+{
+    QFile file(cachePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 version = 0;
+    QByteArray hash;
+    stream >> version;
+    if (version != ContentCacheVersion) {
+        return false;
+    }
+    stream >> hash;
+    if (hash != contentsHash) {
+        return false;
+    }
+
+    quint32 size = 0;
+    stream >> size;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; ++i) {
+        CMakeFunctionDesc function;
+        function.filePath = fileName;
+        quint32 argumentCount = 0;
+        stream >> function.name >> function.line >> function.column >> function.endLine >> function.endColumn
+               >> argumentCount;
+        for (quint32 j = 0; j < argumentCount && stream.status() == QDataStream::Ok; ++j) {
+            CMakeFunctionArgument argument;
+            stream >> argument.value >> argument.quoted >> argument.line >> argument.column;
+            function.arguments.append(argument);
+        }
+        content->append(function);
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+CMakeFileContent readCMakeContentsCached(const QByteArray& contents, const QString& fileName)
+{
+    const QString cleanFileName = QDir::cleanPath(fileName);
+    const auto cachePath = contentCachePath(cleanFileName);
+    const auto contentsHash = QCryptographicHash::hash(contents, QCryptographicHash::Sha1);
+
+    CMakeFileContent content;
+    if (loadContent(cachePath, contentsHash, cleanFileName, &content)) {
+        return content;
+    }
+
+    content = readCMakeContents(contents, cleanFileName);
+    storeContent(cachePath, contentsHash, content);
+    return content;
+}
+
 }
 
 bool CMakeListsParser::readCMakeFunction(cmListFileLexer *lexer, CMakeFunctionDesc &func)
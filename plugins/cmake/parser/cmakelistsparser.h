@@ -121,6 +121,19 @@ using CMakeFileContent = QVector<CMakeFunctionDesc>;
 namespace CMakeListsParser
 {
     KDEVCMAKECOMMON_EXPORT CMakeFileContent readCMakeFile(const QString& fileName);
+
+    /**
+     * Parses @p contents, the contents of the file @p fileName
+     */
+    KDEVCMAKECOMMON_EXPORT CMakeFileContent readCMakeContents(const QByteArray& contents, const QString& fileName);
+
+    /**
+     * Like readCMakeContents(), but reuses the functions read by an earlier parse of
+     * the same contents of @p fileName, also by an earlier session.
+     *
+     * The functions are cached on disk per file, along with the hash of the contents.
+     */
+    KDEVCMAKECOMMON_EXPORT CMakeFileContent readCMakeContentsCached(const QByteArray& contents, const QString& fileName);
 }
 
 #endif
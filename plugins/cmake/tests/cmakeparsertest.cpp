@@ -20,6 +20,7 @@
 
 #include "cmakeparsertest.h"
 
+#include <QStandardPaths>
 #include <QTemporaryFile>
 #include "cmListFileLexer.h"
 #include "cmakelistsparser.h"
@@ -119,6 +120,54 @@ void CMakeParserTest::testParserWithBadData_data()
     QTest::newRow( "bad data 4" ) << "project(foo) set(mysrcs_SRCS foo.c)";
 }
 
+void CMakeParserTest::testCachedContents()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    const QString fileName = QStringLiteral("/cached/CMakeLists.txt");
+    const QByteArray contents = "project(foo)\n"
+                                "set(foobar_SRCS foo.h \"foo bar.c\")\n"
+                                "add_executable(foo ${foobar_SRCS})\n";
+    const CMakeFileContent read = CMakeListsParser::readCMakeContents(contents, fileName);
+    QCOMPARE(read.size(), 3);
+
+    // the first call fills the cache, the second one reads it
+    for (int i = 0; i < 2; ++i) {
+        const CMakeFileContent cached = CMakeListsParser::readCMakeContentsCached(contents, fileName);
+        QCOMPARE(cached, read);
+        for (int j = 0; j < read.size(); ++j) {
+            QCOMPARE(cached.at(j).filePath, fileName);
+            QCOMPARE(cached.at(j).range(), read.at(j).range());
+            QCOMPARE(cached.at(j).arguments.last().range(), read.at(j).arguments.last().range());
+        }
+    }
+
+    // changed contents of the same file are parsed again
+    const QByteArray changedContents = "project(bar)\n";
+    const CMakeFileContent changed = CMakeListsParser::readCMakeContentsCached(changedContents, fileName);
+    QCOMPARE(changed.size(), 1);
+    QCOMPARE(changed.first().arguments.first().value, QStringLiteral("bar"));
+}
+
+void CMakeParserTest::testContentsLikeFile()
+{
+    const QByteArray contents = "project(foo)\r\n"
+                                "\r\n"
+                                "add_executable(foo \"foo bar.c\")\r\n";
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), qint64(contents.size()));
+    file.close();
+
+    const CMakeFileContent fromFile = CMakeListsParser::readCMakeFile(file.fileName());
+    QCOMPARE(fromFile.size(), 2);
+    const CMakeFileContent fromContents = CMakeListsParser::readCMakeContents(contents, file.fileName());
+    QCOMPARE(fromContents, fromFile);
+    QCOMPARE(fromContents.last().line, quint32(3));
+    QCOMPARE(fromContents.last().range(), fromFile.last().range());
+    QCOMPARE(fromContents.last().arguments.last().value, QStringLiteral("foo bar.c"));
+}
+
 // void CMakeParserTest::testAstCreation()
 // {
 
@@ -46,6 +46,9 @@ private Q_SLOTS:
     void testParserWithBadData();
     void testParserWithBadData_data();
 
+    void testCachedContents();
+    void testContentsLikeFile();
+
     //void testAstCreation();
 
     // void testWhitespaceHandling();
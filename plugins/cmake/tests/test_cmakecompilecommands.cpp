@@ -0,0 +1,104 @@
+/* This file is part of KDevelop
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with this library; see the file COPYING.LIB.  If not, write to
+    the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#include <QTest>
+#include <QObject>
+#include <QBuffer>
+#include <QJsonObject>
+
+#include <cmakecompilecommands.h>
+
+class TestCMakeCompileCommands : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void testRead_data()
+    {
+        QTest::addColumn<QByteArray>("document");
+        QTest::addColumn<QStringList>("files");
+        QTest::addColumn<bool>("valid");
+
+        QTest::newRow("empty-array") << QByteArray("[]") << QStringList() << true;
+        QTest::newRow("entries") << QByteArray(R"([
+    {"directory": "/build", "command": "c++ -c a.cpp", "file": "a.cpp"},
+    {"directory": "/build", "arguments": ["c++", "-c", "b.cpp"], "file": "b.cpp"}
+])") << QStringList{QStringLiteral("a.cpp"), QStringLiteral("b.cpp")} << true;
+        QTest::newRow("brackets-in-strings") << QByteArray(R"([{"command": "c++ -DX=\"}]{\" -c a.cpp", "file": "a}.cpp"}])")
+                                             << QStringList{QStringLiteral("a}.cpp")} << true;
+        QTest::newRow("escaped-backslash") << QByteArray(R"([{"file": "a.cpp\\"}, {"file": "b.cpp"}])")
+                                           << QStringList{QStringLiteral("a.cpp\\"), QStringLiteral("b.cpp")} << true;
+        QTest::newRow("non-object-entries") << QByteArray(R"([{"file": "a.cpp"}, "b.cpp", 1, null, ["c.cpp"], {"file": "d.cpp"}])")
+                                            << QStringList{QStringLiteral("a.cpp"), QStringLiteral("d.cpp")} << true;
+        QTest::newRow("empty-document") << QByteArray() << QStringList() << false;
+        QTest::newRow("not-an-array") << QByteArray(R"({"file": "a.cpp"})") << QStringList() << false;
+        QTest::newRow("unterminated-entry") << QByteArray(R"([{"file": "a.cpp"}, {"file": )")
+                                            << QStringList{QStringLiteral("a.cpp")} << false;
+        QTest::newRow("unterminated-array") << QByteArray(R"([{"file": "a.cpp"})")
+                                            << QStringList{QStringLiteral("a.cpp")} << false;
+    }
+
+    void testRead()
+    {
+        QFETCH(QByteArray, document);
+        QFETCH(QStringList, files);
+        QFETCH(bool, valid);
+
+        QBuffer buffer(&document);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+        CMake::CompileCommands::Reader reader(&buffer);
+        QStringList readFiles;
+        QJsonObject entry;
+        while (reader.readNext(&entry)) {
+            readFiles << entry.value(QLatin1String("file")).toString();
+        }
+        QCOMPARE(readFiles, files);
+        QCOMPARE(reader.errorString().isEmpty(), valid);
+    }
+
+    void testReadLargeEntries()
+    {
+        // entries which are larger than the chunks the reader reads
+        const QString command = QStringLiteral("c++ ") + QStringLiteral("-DFOO ").repeated(500000);
+        QByteArray document = "[";
+        for (int i = 0; i < 3; ++i) {
+            if (i) {
+                document += ',';
+            }
+            document += R"({"command": ")" + command.toUtf8() + R"(", "file": ")" + QByteArray::number(i) + R"("})";
+        }
+        document += ']';
+
+        QBuffer buffer(&document);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+        CMake::CompileCommands::Reader reader(&buffer);
+        QJsonObject entry;
+        for (int i = 0; i < 3; ++i) {
+            QVERIFY(reader.readNext(&entry));
+            QCOMPARE(entry.value(QLatin1String("file")).toString(), QString::number(i));
+            QCOMPARE(entry.value(QLatin1String("command")).toString(), command);
+        }
+        QVERIFY(!reader.readNext(&entry));
+        QVERIFY(reader.errorString().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(TestCMakeCompileCommands)
+#include "test_cmakecompilecommands.moc"
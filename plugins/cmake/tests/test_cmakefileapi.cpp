@@ -24,6 +24,7 @@
 #include <QLoggingCategory>
 #include <QDir>
 #include <QJsonObject>
+#include <QStandardPaths>
 
 #include <tests/autotestshell.h>
 #include <tests/testcore.h>
@@ -102,7 +103,8 @@ private Q_SLOTS:
 
         QCOMPARE(projectData.compilationData.files.size(), 1);
         QVERIFY(projectData.compilationData.files.contains(fooSrcPath));
-        const auto srcInfo = projectData.compilationData.files[fooSrcPath];
+        QCOMPARE(projectData.compilationData.settings.size(), 1);
+        const auto srcInfo = *projectData.compilationData.file(fooSrcPath);
         QCOMPARE(srcInfo.language, QLatin1String("CXX"));
         QCOMPARE(srcInfo.includes.size(), 3);
         QVERIFY(srcInfo.includes.contains(buildPath));
@@ -111,6 +113,21 @@ private Q_SLOTS:
 
         QVERIFY(projectData.cmakeFiles.contains(Path(project->path(), "CMakeLists.txt")));
         QVERIFY(projectData.cmakeFiles.contains(Path(subDirPath, "CMakeLists.txt")));
+
+        // the first call parses and caches the code model, the second one reads it from the cache,
+        // which must neither be the cache of the user nor one left by an earlier run
+        QStandardPaths::setTestModeEnabled(true);
+        QVERIFY(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                     + QLatin1String("/cmakefileapi")).removeRecursively());
+        for (int i = 0; i < 2; ++i) {
+            const auto cachedData = CMake::FileApi::parseReplyIndexFileCached(index, project->path(), buildPath);
+            QVERIFY(cachedData.compilationData.isValid);
+            QCOMPARE(cachedData.targets, projectData.targets);
+            QCOMPARE(cachedData.compilationData.files, projectData.compilationData.files);
+            QCOMPARE(cachedData.compilationData.settings.size(), 1);
+            QCOMPARE(cachedData.compilationData.file(fooSrcPath)->includes, srcInfo.includes);
+            QCOMPARE(cachedData.cmakeFiles.size(), projectData.cmakeFiles.size());
+        }
     }
 };
 
@@ -0,0 +1,262 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#include "compileanalyzecache.h"
+
+// lib
+#include <debug.h>
+// KDevPlatform
+#include <language/duchain/duchain.h>
+#include <language/duchain/duchainlock.h>
+#include <language/duchain/parsingenvironment.h>
+#include <serialization/indexedstring.h>
+// Qt
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+namespace KDevelop
+{
+
+static QString hashName(const QString& text)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(text.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+static QStringList readLines(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QString content = QString::fromLocal8Bit(file.readAll());
+    if (content.endsWith(QLatin1Char('\n'))) {
+        content.chop(1);
+    }
+    return content.isEmpty() ? QStringList() : content.split(QLatin1Char('\n'));
+}
+
+static bool replaceFile(const QString& source, const QString& target)
+{
+    QFile::remove(target);
+    return QFile::rename(source, target);
+}
+
+CompileAnalyzeCache::CompileAnalyzeCache(const QString& cacheDirectory, const QByteArray& toolKey,
+                                         const QString& buildDirectory, const QStringList& configFileNames)
+    : m_cacheDirectory(cacheDirectory)
+    , m_toolKey(toolKey)
+    , m_configFileNames(configFileNames)
+{
+    m_valid = QDir().mkpath(m_cacheDirectory);
+    if (!m_valid) {
+        qCWarning(KDEV_COMPILEANALYZER) << "cannot create analysis cache directory" << m_cacheDirectory;
+        return;
+    }
+
+    // the entries are keyed by their file, the compilation database was already checked by the caller
+    QFile commandsFile(QDir(buildDirectory).filePath(QStringLiteral("compile_commands.json")));
+    if (!commandsFile.open(QFile::ReadOnly)) {
+        return;
+    }
+    const auto entries = QJsonDocument::fromJson(commandsFile.readAll()).array();
+    for (const auto& value : entries) {
+        const auto entry = value.toObject();
+        const QString file = entry.value(QLatin1String("file")).toString();
+        if (!file.isEmpty()) {
+            m_compileCommands.insert(file, QJsonDocument(entry).toJson(QJsonDocument::Compact));
+        }
+    }
+}
+
+CompileAnalyzeCache::~CompileAnalyzeCache() = default;
+
+QString CompileAnalyzeCache::defaultCacheDirectory(const QString& toolId, const QString& buildDirectory)
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + QLatin1String("/compileanalyzer/") + toolId + QLatin1Char('/') + hashName(buildDirectory);
+}
+
+QByteArray CompileAnalyzeCache::fileState(const QString& filePath)
+{
+    const QFileInfo info(filePath);
+    if (!info.exists()) {
+        return QByteArrayLiteral("-");
+    }
+    return QByteArray::number(info.size()) + ':' + QByteArray::number(info.lastModified().toMSecsSinceEpoch());
+}
+
+QByteArray CompileAnalyzeCache::cachedFileState(const QString& filePath)
+{
+    auto it = m_fileStates.constFind(filePath);
+    if (it == m_fileStates.constEnd()) {
+        it = m_fileStates.insert(filePath, fileState(filePath));
+    }
+    return *it;
+}
+
+QByteArray CompileAnalyzeCache::configState(const QString& directory)
+{
+    if (m_configFileNames.isEmpty()) {
+        return QByteArray();
+    }
+
+    auto it = m_configStates.constFind(directory);
+    if (it != m_configStates.constEnd()) {
+        return *it;
+    }
+
+    QByteArray state;
+    QDir dir(directory);
+    for (const QString& name : m_configFileNames) {
+        const QString filePath = dir.filePath(name);
+        if (QFileInfo::exists(filePath)) {
+            state += filePath.toUtf8() + '=' + cachedFileState(filePath) + '\n';
+        }
+    }
+    if (dir.cdUp()) {
+        state += configState(dir.absolutePath());
+    }
+
+    m_configStates.insert(directory, state);
+    return state;
+}
+
+bool CompileAnalyzeCache::dependencies(const QString& source, QStringList* dependencies) const
+{
+    DUChainReadLocker lock;
+
+    const auto files = DUChain::self()->allEnvironmentFiles(IndexedString(source));
+    if (files.isEmpty()) {
+        // not parsed, so what it includes is unknown
+        return false;
+    }
+
+    QSet<const ParsingEnvironmentFile*> visited;
+    QSet<IndexedString> urls;
+    QVector<ParsingEnvironmentFilePointer> pending;
+    pending.reserve(files.size());
+    for (const auto& file : files) {
+        pending.append(file);
+    }
+    while (!pending.isEmpty()) {
+        const auto file = pending.takeLast();
+        const auto imports = file->imports();
+        for (const auto& import : imports) {
+            if (import && !visited.contains(import.data())) {
+                visited.insert(import.data());
+                urls.insert(import->url());
+                pending.append(import);
+            }
+        }
+    }
+
+    dependencies->reserve(urls.size());
+    for (const auto& url : qAsConst(urls)) {
+        dependencies->append(url.str());
+    }
+    return true;
+}
+
+QByteArray CompileAnalyzeCache::key(const QString& source)
+{
+    if (!m_valid) {
+        return QByteArray();
+    }
+
+    QStringList includes;
+    if (!dependencies(source, &includes)) {
+        return QByteArray();
+    }
+    std::sort(includes.begin(), includes.end());
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_toolKey);
+    hash.addData(m_compileCommands.value(source));
+    hash.addData(cachedFileState(source));
+    for (const QString& include : qAsConst(includes)) {
+        hash.addData(include.toUtf8());
+        hash.addData(cachedFileState(include));
+    }
+    hash.addData(configState(QFileInfo(source).absolutePath()));
+    return hash.result().toHex();
+}
+
+QString CompileAnalyzeCache::entryPath(const QString& source) const
+{
+    return m_cacheDirectory + QLatin1Char('/') + hashName(source);
+}
+
+QString CompileAnalyzeCache::stdoutPartPath(const QString& source) const
+{
+    return entryPath(source) + QLatin1String(".stdout.part");
+}
+
+QString CompileAnalyzeCache::stderrPartPath(const QString& source) const
+{
+    return entryPath(source) + QLatin1String(".stderr.part");
+}
+
+bool CompileAnalyzeCache::contains(const QString& source, const QByteArray& key) const
+{
+    if (key.isEmpty()) {
+        return false;
+    }
+
+    QFile keyFile(entryPath(source) + QLatin1String(".key"));
+    return keyFile.open(QIODevice::ReadOnly) && keyFile.readAll() == key;
+}
+
+CompileAnalyzeCache::Entry CompileAnalyzeCache::load(const QString& source) const
+{
+    const QString path = entryPath(source);
+    return {readLines(path + QLatin1String(".stdout")), readLines(path + QLatin1String(".stderr"))};
+}
+
+bool CompileAnalyzeCache::store(const QString& source, const QByteArray& key)
+{
+    const QString path = entryPath(source);
+
+    // invalidate the old entry before its output gets replaced
+    QFile::remove(path + QLatin1String(".key"));
+    if (!replaceFile(stdoutPartPath(source), path + QLatin1String(".stdout"))
+        || !replaceFile(stderrPartPath(source), path + QLatin1String(".stderr"))) {
+        qCDebug(KDEV_COMPILEANALYZER) << "no output to cache for" << source;
+        return false;
+    }
+
+    QSaveFile keyFile(path + QLatin1String(".key"));
+    if (!keyFile.open(QIODevice::WriteOnly) || keyFile.write(key) != key.size() || !keyFile.commit()) {
+        qCWarning(KDEV_COMPILEANALYZER) << "failed to write analysis cache entry for" << source;
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ */
+
+#ifndef COMPILEANALYZER_COMPILEANALYZECACHE_H
+#define COMPILEANALYZER_COMPILEANALYZECACHE_H
+
+// lib
+#include <compileanalyzercommonexport.h>
+// Qt
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+namespace KDevelop
+{
+
+/**
+ * Persistent per-source store of the output of an analysis tool.
+ *
+ * An entry is only valid for the key it was stored with. The key covers
+ * everything the output depends on: the tool and its configuration, the
+ * compile command of the source, and the state of the source, the files
+ * it includes and the configuration files of the tool next to it.
+ *
+ * The output is written by the tool itself to the files given by
+ * @c stdoutPartPath and @c stderrPartPath, and only becomes an entry
+ * once @c store is called after the tool succeeded.
+ */
+class KDEVCOMPILEANALYZERCOMMON_EXPORT CompileAnalyzeCache
+{
+public:
+    struct Entry
+    {
+        QStringList stdoutLines;
+        QStringList stderrLines;
+    };
+
+    /**
+     * @param cacheDirectory where the entries are stored
+     * @param toolKey identifies the tool, its version and its configuration
+     * @param buildDirectory directory of the compilation database
+     * @param configFileNames files the tool reads from the directory of a source and its parents
+     */
+    CompileAnalyzeCache(const QString& cacheDirectory, const QByteArray& toolKey,
+                        const QString& buildDirectory, const QStringList& configFileNames);
+    virtual ~CompileAnalyzeCache();
+
+    /// Directory of the cache of the tool @p toolId for @p buildDirectory
+    static QString defaultCacheDirectory(const QString& toolId, const QString& buildDirectory);
+    /// Cheap identity of the current state of a file, changes with its size and modification time
+    static QByteArray fileState(const QString& filePath);
+
+    bool isValid() const { return m_valid; }
+
+    /// Key of the current inputs of @p source, empty if they are not known and it cannot be cached
+    QByteArray key(const QString& source);
+
+    bool contains(const QString& source, const QByteArray& key) const;
+    Entry load(const QString& source) const;
+    /// Turns the output written to the part files into the entry of @p source
+    bool store(const QString& source, const QByteArray& key);
+
+    QString stdoutPartPath(const QString& source) const;
+    QString stderrPartPath(const QString& source) const;
+
+protected:
+    /**
+     * Collects the files @p source includes, directly or not.
+     * @return false if they are not known
+     */
+    virtual bool dependencies(const QString& source, QStringList* dependencies) const;
+
+private:
+    QString entryPath(const QString& source) const;
+    QByteArray cachedFileState(const QString& filePath);
+    QByteArray configState(const QString& directory);
+
+private:
+    const QString m_cacheDirectory;
+    const QByteArray m_toolKey;
+    const QStringList m_configFileNames;
+    bool m_valid = false;
+
+    QHash<QString, QByteArray> m_compileCommands;
+    // memoized for the sources of one run, most of them share headers
+    QHash<QString, QByteArray> m_fileStates;
+    QHash<QString, QByteArray> m_configStates;
+};
+
+}
+
+#endif
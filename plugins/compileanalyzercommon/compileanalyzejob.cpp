@@ -22,10 +22,13 @@
 #include "compileanalyzejob.h"
 
 // lib
+#include "compileanalyzecache.h"
 #include <debug.h>
 // KF
+#include <KFormat>
 #include <KLocalizedString>
 // Qt
+#include <QLocale>
 #include <QTemporaryFile>
 
 namespace KDevelop
@@ -83,7 +86,77 @@ void CompileAnalyzeJob::setSources(const QStringList& sources)
     m_sources = sources;
 }
 
-void CompileAnalyzeJob::generateMakefile()
+void CompileAnalyzeJob::enableResultCache(const QString& toolId, const QString& executablePath,
+                                          const QString& configuration, const QStringList& configFileNames)
+{
+    m_cacheToolId = toolId;
+    m_cacheToolKey = executablePath.toUtf8() + '\n' + CompileAnalyzeCache::fileState(executablePath) + '\n'
+                   + configuration.toUtf8();
+    m_cacheConfigFileNames = configFileNames;
+}
+
+QString CompileAnalyzeJob::startedMessage(const QString& source) const
+{
+    return m_toolDisplayName + QLatin1String(" check started  for ") + source;
+}
+
+QString CompileAnalyzeJob::finishedMessage(const QString& source) const
+{
+    return m_toolDisplayName + QLatin1String(" check finished for ") + source;
+}
+
+QStringList CompileAnalyzeJob::sourcesToAnalyze()
+{
+    m_cachedSources.clear();
+    m_pendingCacheKeys.clear();
+    m_cache.reset();
+
+    if (m_cacheToolId.isEmpty()) {
+        return m_sources;
+    }
+
+    m_cache.reset(new CompileAnalyzeCache(CompileAnalyzeCache::defaultCacheDirectory(m_cacheToolId, m_buildDir),
+                                          m_cacheToolKey, m_buildDir, m_cacheConfigFileNames));
+    if (!m_cache->isValid()) {
+        m_cache.reset();
+        return m_sources;
+    }
+
+    QStringList sources;
+    for (const auto& source : qAsConst(m_sources)) {
+        const QByteArray key = m_cache->key(source);
+        if (m_cache->contains(source, key)) {
+            m_cachedSources.append(source);
+            continue;
+        }
+        sources.append(source);
+        if (!key.isEmpty()) {
+            m_pendingCacheKeys.insert(source, key);
+        }
+    }
+
+    qCDebug(KDEV_COMPILEANALYZER) << "reusing cached results for" << m_cachedSources.size() << "of" << m_sources.size() << "files";
+    return sources;
+}
+
+void CompileAnalyzeJob::replayCachedSources()
+{
+    for (const auto& source : qAsConst(m_cachedSources)) {
+        const auto entry = m_cache->load(source);
+        // the markers let parseProgress count the file as done
+        postProcessStdout({startedMessage(source)});
+        if (!entry.stdoutLines.isEmpty()) {
+            postProcessStdout(entry.stdoutLines);
+        }
+        if (!entry.stderrLines.isEmpty()) {
+            postProcessStderr(entry.stderrLines);
+        }
+        postProcessStdout({finishedMessage(source)});
+    }
+    m_cachedSources.clear();
+}
+
+void CompileAnalyzeJob::generateMakefile(const QStringList& sources)
 {
     QTemporaryFile makefile(m_buildDir + QLatin1String("/kdevcompileanalyzerXXXXXX.makefile"));
     makefile.setAutoRemove(false);
@@ -93,7 +166,7 @@ void CompileAnalyzeJob::generateMakefile()
     QTextStream scriptStream(&makefile);
 
     scriptStream << QStringLiteral("SOURCES =");
-    for (const auto& source : qAsConst(m_sources)) {
+    for (const auto& source : sources) {
         scriptStream << QLatin1String(" \\\n\t") << spaceEscapedString(source);
     }
     scriptStream << QLatin1Char('\n');
@@ -106,20 +179,46 @@ void CompileAnalyzeJob::generateMakefile()
 
     scriptStream << QLatin1String(".PHONY: all $(SOURCES)\n");
     scriptStream << QLatin1String("all: $(SOURCES)\n");
-    scriptStream << QLatin1String("$(SOURCES):\n");
 
-    scriptStream << QLatin1String("\t@echo '") << m_toolDisplayName << QLatin1String(" check started  for $@'\n");
-    // Wrap filename ($@) with quotas to handle "whitespaced" file names.
-    scriptStream << QLatin1String("\t$(COMMAND) '$@'\n");
-    scriptStream << QLatin1String("\t@echo '") << m_toolDisplayName << QLatin1String(" check finished for $@'\n");
+    if (m_pendingCacheKeys.isEmpty()) {
+        scriptStream << QLatin1String("$(SOURCES):\n");
+
+        scriptStream << QLatin1String("\t@echo '") << startedMessage(QStringLiteral("$@")) << QLatin1String("'\n");
+        // Wrap filename ($@) with quotas to handle "whitespaced" file names.
+        scriptStream << QLatin1String("\t$(COMMAND) '$@'\n");
+        scriptStream << QLatin1String("\t@echo '") << finishedMessage(QStringLiteral("$@")) << QLatin1String("'\n");
+    } else {
+        const auto makeEscaped = [](QString path) {
+            return path.replace(QLatin1Char('$'), QLatin1String("$$"));
+        };
+
+        // One rule per file, which also keeps the output for the cache and then passes it on.
+        // It only gets stored once the finished marker shows that the tool succeeded.
+        for (const auto& source : sources) {
+            scriptStream << spaceEscapedString(source) << QLatin1String(":\n");
+            scriptStream << QLatin1String("\t@echo '") << startedMessage(QStringLiteral("$@")) << QLatin1String("'\n");
+            if (m_pendingCacheKeys.contains(source)) {
+                const QString out = makeEscaped(m_cache->stdoutPartPath(source));
+                const QString err = makeEscaped(m_cache->stderrPartPath(source));
+                scriptStream << QLatin1String("\t$(COMMAND) '$@' >'") << out << QLatin1String("' 2>'") << err
+                             << QLatin1String("'; status=$$?; cat '") << out << QLatin1String("'; cat '") << err
+                             << QLatin1String("' >&2; exit $$status\n");
+            } else {
+                scriptStream << QLatin1String("\t$(COMMAND) '$@'\n");
+            }
+            scriptStream << QLatin1String("\t@echo '") << finishedMessage(QStringLiteral("$@")) << QLatin1String("'\n");
+        }
+    }
 
     makefile.close();
 }
 
 void CompileAnalyzeJob::start()
 {
+    const QStringList sources = sourcesToAnalyze();
+
     // TODO: check success of creation
-    generateMakefile();
+    generateMakefile(sources);
 
     *this << QStringList{
         QStringLiteral("make"),
@@ -137,6 +236,26 @@ void CompileAnalyzeJob::start()
     setPercent(0);
 
     KDevelop::OutputExecuteJob::start();
+
+    replayCachedSources();
+
+    // replayed results would make the throughput look better than it is
+    m_replayedCount = m_finishedCount;
+    m_timer.start();
+}
+
+QString CompileAnalyzeJob::progressMessage(const QString& source) const
+{
+    const int analyzedCount = m_finishedCount - m_replayedCount;
+    if (!m_timer.isValid() || analyzedCount <= 0 || m_totalCount <= m_finishedCount) {
+        return source;
+    }
+
+    const qint64 elapsed = qMax<qint64>(m_timer.elapsed(), 1);
+    const double filesPerSecond = analyzedCount * 1000.0 / elapsed;
+    const qint64 remaining = elapsed * (m_totalCount - m_finishedCount) / analyzedCount;
+    return i18nc("@info:progress %1 file name, %2 number of files, %3 duration", "%1 (%2 files/s, %3 left)",
+                 source, QLocale().toString(filesPerSecond, 'f', 1), KFormat().formatDuration(remaining));
 }
 
 void CompileAnalyzeJob::parseProgress(const QStringList& lines)
@@ -144,12 +263,17 @@ void CompileAnalyzeJob::parseProgress(const QStringList& lines)
     for (const auto& line : lines) {
         const auto startedMatch = m_fileStartedRegex.match(line);
         if (startedMatch.hasMatch()) {
-            emit infoMessage(this, startedMatch.captured(1));
+            emit infoMessage(this, progressMessage(startedMatch.captured(1)));
             continue;
         }
 
         const auto finishedMatch = m_fileFinishedRegex.match(line);
         if (finishedMatch.hasMatch()) {
+            const auto cacheKey = m_pendingCacheKeys.take(finishedMatch.captured(1));
+            if (!cacheKey.isEmpty()) {
+                m_cache->store(finishedMatch.captured(1), cacheKey);
+            }
+
             ++m_finishedCount;
             setPercent(static_cast<double>(m_finishedCount)/m_totalCount * 100);
             continue;
@@ -28,10 +28,14 @@
 #include <interfaces/iproblem.h>
 #include <outputview/outputexecutejob.h>
 // Qt
+#include <QElapsedTimer>
+#include <QHash>
 #include <QRegularExpression>
+#include <QScopedPointer>
 
 namespace KDevelop
 {
+class CompileAnalyzeCache;
 
 class KDEVCOMPILEANALYZERCOMMON_EXPORT CompileAnalyzeJob : public KDevelop::OutputExecuteJob
 {
@@ -54,6 +58,18 @@ public:
     void setToolDisplayName(const QString& toolDisplayName);
     void setSources(const QStringList& sources);
 
+    /**
+     * Enables reusing the output of earlier runs for the sources whose inputs did not change.
+     * Their output is replayed through postProcessStdout and postProcessStderr when the job starts.
+     *
+     * @param toolId name of the cache of the tool
+     * @param executablePath the tool, its version is part of the inputs
+     * @param configuration anything else affecting the output, e.g. the enabled checks
+     * @param configFileNames files the tool reads from the directory of a source and its parents
+     */
+    void enableResultCache(const QString& toolId, const QString& executablePath,
+                           const QString& configuration, const QStringList& configFileNames = QStringList());
+
 Q_SIGNALS:
     void problemsDetected(const QVector<KDevelop::IProblem::Ptr>& problems);
 
@@ -65,7 +81,13 @@ protected:
     void parseProgress(const QStringList& lines);
 
 private:
-    void generateMakefile();
+    void generateMakefile(const QStringList& sources);
+    QStringList sourcesToAnalyze();
+    void replayCachedSources();
+    QString startedMessage(const QString& source) const;
+    QString finishedMessage(const QString& source) const;
+    /// @p source with the throughput so far and an estimate of the time left
+    QString progressMessage(const QString& source) const;
 
 private:
     QString m_makeFilePath;
@@ -78,6 +100,16 @@ private:
 
     int m_finishedCount = 0;
     int m_totalCount = 0;
+    int m_replayedCount = 0;
+    QElapsedTimer m_timer;
+
+    QString m_cacheToolId;
+    QByteArray m_cacheToolKey;
+    QStringList m_cacheConfigFileNames;
+    QScopedPointer<CompileAnalyzeCache> m_cache;
+    QStringList m_cachedSources;
+    /// keys of the sources being analyzed, to store their output once done
+    QHash<QString, QByteArray> m_pendingCacheKeys;
 
     QRegularExpression m_fileStartedRegex;
     QRegularExpression m_fileFinishedRegex;
@@ -38,6 +38,10 @@ CompileAnalyzeProblemModel::CompileAnalyzeProblemModel(const QString& toolName,
     , m_toolName(toolName)
     , m_pathLocation(KDevelop::DocumentRange::invalid())
 {
+    // the store inserts the nodes of all of the batch at once
+    connect(&m_batcher, &ProblemBatcher::problemsAdded, this, [this](const QVector<KDevelop::IProblem::Ptr>& problems) {
+        ProblemModel::addProblems(problems);
+    });
 }
 
 CompileAnalyzeProblemModel::~CompileAnalyzeProblemModel() = default;
@@ -52,53 +56,17 @@ void CompileAnalyzeProblemModel::setMessage(const QString& message)
     setPlaceholderText(message, m_pathLocation, m_toolName);
 }
 
-// The code is adapted version of cppcheck::ProblemModel::problemExists()
-// TODO Add into KDevelop::ProblemModel class ?
-bool CompileAnalyzeProblemModel::problemExists(KDevelop::IProblem::Ptr newProblem)
-{
-    for (const auto& problem : qAsConst(m_problems)) {
-        if (newProblem->source() == problem->source() &&
-            newProblem->sourceString() == problem->sourceString() &&
-            newProblem->severity() == problem->severity() &&
-            newProblem->finalLocation() == problem->finalLocation() &&
-            newProblem->description() == problem->description() &&
-            newProblem->explanation() == problem->explanation())
-            return true;
-    }
-
-    return false;
-}
-
-// The code is adapted version of cppcheck::ProblemModel::addProblems()
-// TODO Add into KDevelop::ProblemModel class ?
 void CompileAnalyzeProblemModel::addProblems(const QVector<KDevelop::IProblem::Ptr>& problems)
 {
-    if (m_problems.isEmpty()) {
-        m_maxProblemDescriptionLength = 0;
-    }
-
-    for (const auto& problem : problems) {
-        if (problemExists(problem)) {
-            continue;
-        }
-
-        m_problems.append(problem);
-        addProblem(problem);
-
-        // This performs adjusting of columns width in the ProblemsView
-        if (m_maxProblemDescriptionLength < problem->description().length()) {
-            m_maxProblemDescriptionLength = problem->description().length();
-            setProblems(m_problems);
-        }
-    }
+    m_batcher.addProblems(problems);
 }
 
 void CompileAnalyzeProblemModel::finishAddProblems()
 {
-    if (m_problems.isEmpty()) {
+    m_batcher.flush();
+
+    if (m_batcher.problems().isEmpty()) {
         setMessage(i18n("Analysis completed, no problems detected."));
-    } else {
-        setProblems(m_problems);
     }
 }
 
@@ -115,7 +83,7 @@ void CompileAnalyzeProblemModel::reset(KDevelop::IProject* project, const QUrl&
     m_pathLocation.document = KDevelop::IndexedString(path.toLocalFile());
 
     clearProblems();
-    m_problems.clear();
+    m_batcher.clear();
 
     QString tooltip;
     if (m_project) {
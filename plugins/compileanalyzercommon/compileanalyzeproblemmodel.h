@@ -23,6 +23,7 @@
 #define COMPILEANALYZER_COMPILEANALYZEPROBLEMMODEL_H
 
 // KDevPlatfrom
+#include <shell/problembatcher.h>
 #include <shell/problemmodel.h>
 // Qt
 #include <QUrl>
@@ -44,6 +45,7 @@ public: // KDevelop::ProblemModel API
     void forceFullUpdate() override;
 
 public:
+    /// Queues @p problems, they are shown in batches while the analysis goes on
     void addProblems(const QVector<KDevelop::IProblem::Ptr>& problems);
 
     void finishAddProblems();
@@ -58,7 +60,6 @@ Q_SIGNALS:
 
 private:
     void setMessage(const QString& message);
-    bool problemExists(KDevelop::IProblem::Ptr newProblem);
 
 private:
     const QString m_toolName;
@@ -67,8 +68,7 @@ private:
     bool m_allFiles = false;
     KDevelop::DocumentRange m_pathLocation;
 
-    QVector<KDevelop::IProblem::Ptr> m_problems;
-    int m_maxProblemDescriptionLength = 0;
+    KDevelop::ProblemBatcher m_batcher;
 };
 
 }
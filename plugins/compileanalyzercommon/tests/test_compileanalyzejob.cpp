@@ -21,11 +21,15 @@
 
 #include "test_compileanalyzejob.h"
 
+#include "compileanalyzecache.h"
 #include "compileanalyzejob.h"
 
 #include <tests/autotestshell.h>
 #include <tests/testcore.h>
 
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
 #include <QTest>
 
 using namespace KDevelop;
@@ -72,6 +76,33 @@ private:
     QVector<QString> m_started;
 };
 
+class CacheTester : public CompileAnalyzeCache
+{
+public:
+    CacheTester(const QString& cacheDirectory, const QString& buildDirectory, const QStringList& includes)
+        : CompileAnalyzeCache(cacheDirectory, "tool", buildDirectory, {QStringLiteral(".analyzer")})
+        , m_includes(includes)
+    {
+    }
+
+protected:
+    bool dependencies(const QString&, QStringList* dependencies) const override
+    {
+        *dependencies = m_includes;
+        return true;
+    }
+
+private:
+    const QStringList m_includes;
+};
+
+static void writeFile(const QString& filePath, const QByteArray& content)
+{
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(content);
+}
+
 void TestCompileAnalyzeJob::initTestCase()
 {
     AutoTestShell::init();
@@ -141,6 +172,64 @@ void TestCompileAnalyzeJob::testJob()
     QCOMPARE(jobTester.started().at(3), QStringLiteral("source4.cpp"));
 }
 
+void TestCompileAnalyzeJob::testResultCache()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QDir root(dir.path());
+    const QString cacheDir = root.filePath(QStringLiteral("cache"));
+    const QString source = root.filePath(QStringLiteral("source.cpp"));
+    const QString header = root.filePath(QStringLiteral("header.h"));
+    writeFile(source, "#include \"header.h\"\n");
+    writeFile(header, "int i;\n");
+    writeFile(root.filePath(QStringLiteral("compile_commands.json")),
+              "[{\"directory\": \"/\", \"command\": \"cc -c source.cpp\", \"file\": \"" + source.toUtf8() + "\"}]");
+
+    QByteArray key;
+    {
+        CacheTester cache(cacheDir, dir.path(), {header});
+        QVERIFY(cache.isValid());
+        key = cache.key(source);
+        QVERIFY(!key.isEmpty());
+        QVERIFY(!cache.contains(source, key));
+
+        // the tool wrote no output, e.g. because it failed
+        QVERIFY(!cache.store(source, key));
+        QVERIFY(!cache.contains(source, key));
+
+        writeFile(cache.stdoutPartPath(source), "warning one\nwarning two\n");
+        writeFile(cache.stderrPartPath(source), "");
+        QVERIFY(cache.store(source, key));
+        QVERIFY(cache.contains(source, key));
+        QVERIFY(!QFile::exists(cache.stdoutPartPath(source)));
+    }
+
+    {
+        // a new run with the same inputs
+        CacheTester cache(cacheDir, dir.path(), {header});
+        QCOMPARE(cache.key(source), key);
+        QVERIFY(cache.contains(source, key));
+        const auto entry = cache.load(source);
+        QCOMPARE(entry.stdoutLines, QStringList({QStringLiteral("warning one"), QStringLiteral("warning two")}));
+        QVERIFY(entry.stderrLines.isEmpty());
+    }
+
+    // changing an include or a config file of the tool changes the key
+    writeFile(header, "int i;\nint j;\n");
+    {
+        CacheTester cache(cacheDir, dir.path(), {header});
+        const QByteArray headerKey = cache.key(source);
+        QVERIFY(headerKey != key);
+        QVERIFY(!cache.contains(source, headerKey));
+        key = headerKey;
+    }
+    writeFile(root.filePath(QStringLiteral(".analyzer")), "Checks: '*'\n");
+    {
+        CacheTester cache(cacheDir, dir.path(), {header});
+        QVERIFY(cache.key(source) != key);
+    }
+}
+
 QTEST_GUILESS_MAIN(TestCompileAnalyzeJob)
 
 #include "test_compileanalyzejob.moc"
@@ -29,6 +29,7 @@
 
 #include <QAction>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QLayout>
 #include <QMenu>
 #include <QTimer>
@@ -59,6 +60,7 @@
 #include <language/highlighting/colorcache.h>
 
 #include <language/duchain/duchain.h>
+#include <language/duchain/topducontext.h>
 #include <language/duchain/ducontext.h>
 #include <language/duchain/declaration.h>
 #include <language/duchain/use.h>
@@ -97,6 +99,10 @@ QWidget* masterWidget(QWidget* w)
 namespace {
 const unsigned int highlightingTimeout = 150;
 const float highlightingZDepth = -5000;
+// Uses are highlighted in steps taking at most this many milliseconds, so that the editor stays responsive
+const qint64 highlightingUsesBudget = 10;
+// Uses of declarations like QString are not worth highlighting all
+const int maxHighlightedUses = 1000;
 const int maxHistoryLength = 30;
 
 // Helper that determines the context to use for highlighting at a specific position
@@ -321,6 +327,10 @@ ContextBrowserPlugin::ContextBrowserPlugin(QObject* parent, const QVariantList&)
     m_updateTimer->setSingleShot(true);
     connect(m_updateTimer, &QTimer::timeout, this, &ContextBrowserPlugin::updateViews);
 
+    m_highlightUsesTimer = new QTimer(this);
+    m_highlightUsesTimer->setSingleShot(true);
+    connect(m_highlightUsesTimer, &QTimer::timeout, this, &ContextBrowserPlugin::highlightPendingUses);
+
     //Needed global action for the context-menu extensions
     m_findUses = new QAction(i18nc("@action", "Find Uses"), this);
     connect(m_findUses, &QAction::triggered, this, &ContextBrowserPlugin::findUses);
@@ -768,18 +778,33 @@ void ContextBrowserPlugin::addHighlight(View* view, KDevelop::Declaration* decl)
     highlights.highlights.back()->setAttribute(highlightedUseAttribute(view));
     highlights.highlights.back()->setZDepth(highlightingZDepth);
 
-    // Highlight uses
+    // Highlight uses, only the open documents can show them. Loading the top-contexts of all the
+    // uses could take seconds, so they are highlighted step by step, starting with the own document.
     {
-        const auto currentRevisionUses = decl->usesCurrentRevision();
-        for (auto fileIt = currentRevisionUses.constBegin(); fileIt != currentRevisionUses.constEnd(); ++fileIt) {
-            const auto& document = fileIt.key();
-            const auto& documentUses = fileIt.value();
-            for (auto& use : documentUses) {
-                highlights.highlights << PersistentMovingRange::Ptr(new PersistentMovingRange(use, document));
-                highlights.highlights.back()->setAttribute(highlightedUseAttribute(view));
-                highlights.highlights.back()->setZDepth(highlightingZDepth);
+        QSet<IndexedString> openDocuments;
+        const auto documents = core()->documentController()->openDocuments();
+        for (IDocument* document : documents) {
+            openDocuments.insert(IndexedString(document->url()));
+        }
+
+        highlights.usesDeclaration = IndexedDeclaration(decl);
+        highlights.pendingUseContexts.clear();
+        highlights.pendingUseContexts << IndexedTopDUContext(decl->topContext());
+        highlights.highlightedUses = 0;
+
+        const DeclarationId id = decl->id();
+        KDevVarLengthArray<IndexedTopDUContext> useContexts = DUChain::uses()->uses(id);
+        if (!id.isDirect()) { // also check uses based on direct IDs
+            KDevVarLengthArray<IndexedTopDUContext> directUseContexts = DUChain::uses()->uses(decl->id(true));
+            useContexts.append(directUseContexts.data(), directUseContexts.size());
+        }
+        for (const IndexedTopDUContext& context : qAsConst(useContexts)) {
+            if (openDocuments.contains(context.url()) && !highlights.pendingUseContexts.contains(context)) {
+                highlights.pendingUseContexts << context;
             }
         }
+
+        m_highlightUsesTimer->start(0); // triggers highlightPendingUses()
     }
 
     if (FunctionDefinition* def = FunctionDefinition::definition(decl)) {
@@ -789,6 +814,56 @@ void ContextBrowserPlugin::addHighlight(View* view, KDevelop::Declaration* decl)
     }
 }
 
+void ContextBrowserPlugin::highlightPendingUses()
+{
+    KDevelop::DUChainReadLocker lock(DUChain::lock(), 100);
+    if (!lock.locked()) {
+        qCDebug(PLUGIN_CONTEXTBROWSER) << "Failed to lock du-chain in time";
+        m_highlightUsesTimer->start(highlightingTimeout);
+        return;
+    }
+
+    QElapsedTimer budget;
+    budget.start();
+
+    for (auto it = m_highlightedRanges.begin(); it != m_highlightedRanges.end(); ++it) {
+        View* view = it.key();
+        ViewHighlights& highlights = *it;
+
+        Declaration* decl = highlights.usesDeclaration.data();
+        if (!decl) {
+            highlights.pendingUseContexts.clear();
+            continue;
+        }
+
+        while (!highlights.pendingUseContexts.isEmpty()) {
+            if (budget.elapsed() > highlightingUsesBudget) {
+                // Continue after the events which came in meanwhile, cursor moves cancel the rest
+                m_highlightUsesTimer->start(0);
+                return;
+            }
+
+            TopDUContext* context = highlights.pendingUseContexts.takeFirst().data();
+            if (!context)
+                continue;
+
+            const auto uses = allUses(context, decl);
+            for (const RangeInRevision& use : uses) {
+                if (highlights.highlightedUses == maxHighlightedUses) {
+                    highlights.pendingUseContexts.clear();
+                    break;
+                }
+                ++highlights.highlightedUses;
+
+                highlights.highlights << PersistentMovingRange::Ptr(
+                    new PersistentMovingRange(context->transformFromLocalRevision(use), context->url()));
+                highlights.highlights.back()->setAttribute(highlightedUseAttribute(view));
+                highlights.highlights.back()->setZDepth(highlightingZDepth);
+            }
+        }
+    }
+}
+
 Declaration* ContextBrowserPlugin::findDeclaration(View* view, const KTextEditor::Cursor& position, bool mouseHighlight)
 {
     Q_UNUSED(mouseHighlight);
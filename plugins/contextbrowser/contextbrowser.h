@@ -35,6 +35,7 @@
 #include <language/duchain/duchainpointer.h>
 #include <language/duchain/declaration.h>
 #include <language/duchain/indexedducontext.h>
+#include <language/duchain/indexedtopducontext.h>
 #include <language/duchain/problem.h>
 #include <language/editor/persistentmovingrange.h>
 #include <language/interfaces/iquickopen.h>
@@ -93,6 +94,12 @@ struct ViewHighlights
     KDevelop::IndexedDeclaration declaration;
     // Highlighted ranges. Those may also be contained by different views.
     QList<KDevelop::PersistentMovingRange::Ptr> highlights;
+    // The declaration whose uses are highlighted
+    KDevelop::IndexedDeclaration usesDeclaration;
+    // Top-contexts of open documents whose uses are not highlighted yet, see highlightPendingUses()
+    QVector<KDevelop::IndexedTopDUContext> pendingUseContexts;
+    // The number of highlighted uses, at most maxHighlightedUses
+    int highlightedUses = 0;
 };
 
 class ContextBrowserPlugin
@@ -188,6 +195,8 @@ private:
     void clearMouseHover();
 
     void addHighlight(KTextEditor::View* view, KDevelop::Declaration* decl);
+    /// Highlights the pending uses of the views, until the time budget is used up
+    void highlightPendingUses();
 
     /** helper for updateBrowserView().
      *  Tries to find a 'specialLanguageObject' (eg macro) in @p view under cursor @c.
@@ -220,6 +229,7 @@ private:
 
     void showToolTip(KTextEditor::View* view, KTextEditor::Cursor position);
     QTimer* m_updateTimer;
+    QTimer* m_highlightUsesTimer;
 
     //Contains the range, the old attribute, and the attribute it was replaced with
     QSet<KTextEditor::View*> m_updateViews;
@@ -34,12 +34,15 @@
 #include <interfaces/icore.h>
 #include <interfaces/iuicontroller.h>
 #include <sublime/message.h>
+#include <util/kdevstringhandler.h>
 #include <shell/problem.h>
 // KF
+#include <KFormat>
 #include <KLocalizedString>
 // Qt
 #include <QApplication>
 #include <QElapsedTimer>
+#include <QLocale>
 #include <QRegularExpression>
 
 namespace cppcheck
@@ -75,16 +78,22 @@ void Job::postProcessStdout(const QStringList& lines)
 {
     static const auto fileNameRegex = QRegularExpression(QStringLiteral("Checking ([^:]*)\\.{3}"));
     static const auto percentRegex  = QRegularExpression(QStringLiteral("(\\d+)% done"));
+    static const auto filesRegex    = QRegularExpression(QStringLiteral("(\\d+)/\\d+ files checked"));
 
     QRegularExpressionMatch match;
 
     for (const QString& line : lines) {
         match = fileNameRegex.match(line);
         if (match.hasMatch()) {
-            emit infoMessage(this, match.captured(1));
+            emit infoMessage(this, progressMessage(match.captured(1)));
             continue;
         }
 
+        match = filesRegex.match(line);
+        if (match.hasMatch()) {
+            m_checkedCount = match.capturedRef(1).toInt();
+        }
+
         match = percentRegex.match(line);
         if (match.hasMatch()) {
             setPercent(match.capturedRef(1).toULong());
@@ -92,7 +101,7 @@ void Job::postProcessStdout(const QStringList& lines)
         }
     }
 
-    m_standardOutput << lines;
+    KDevelop::appendKeepingLast(m_standardOutput, lines);
 
     if (status() == KDevelop::OutputExecuteJob::JobStatus::JobRunning) {
         KDevelop::OutputExecuteJob::postProcessStdout(lines);
@@ -113,7 +122,7 @@ void Job::postProcessStderr(const QStringList& lines)
         // Therefore we must 'move' such messages to m_standardOutput.
 
         if (line.indexOf(xmlStartRegex) != -1) { // the line contains XML
-            m_xmlOutput << line;
+            KDevelop::appendKeepingLast(m_xmlOutput, {line});
 
             m_parser->addData(line);
 
@@ -131,7 +140,7 @@ void Job::postProcessStderr(const QStringList& lines)
             emitProblems();
 
             if (m_showXmlOutput) {
-                m_standardOutput << line;
+                KDevelop::appendKeepingLast(m_standardOutput, {line});
             } else {
                 postProcessStdout({line});
             }
@@ -147,6 +156,7 @@ void Job::start()
 {
     m_standardOutput.clear();
     m_xmlOutput.clear();
+    m_checkedCount = 0;
 
     qCDebug(KDEV_CPPCHECK) << "executing:" << commandLine().join(QLatin1Char(' '));
 
@@ -154,6 +164,21 @@ void Job::start()
     KDevelop::OutputExecuteJob::start();
 }
 
+QString Job::progressMessage(const QString& file) const
+{
+    const unsigned long done = percent();
+    if (!m_timer->isValid() || done == 0 || done >= 100 || m_checkedCount == 0) {
+        return file;
+    }
+
+    // cppcheck reports the percentage of the total size of the files checked
+    const qint64 elapsed = qMax<qint64>(m_timer->elapsed(), 1);
+    const double filesPerSecond = m_checkedCount * 1000.0 / elapsed;
+    const qint64 remaining = elapsed * (100 - done) / done;
+    return i18nc("@info:progress %1 file name, %2 number of files, %3 duration", "%1 (%2 files/s, %3 left)",
+                 file, QLocale().toString(filesPerSecond, 'f', 1), KFormat().formatDuration(remaining));
+}
+
 void Job::childProcessError(QProcess::ProcessError e)
 {
     QString messageText;
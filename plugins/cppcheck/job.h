@@ -60,14 +60,18 @@ protected Q_SLOTS:
 
 protected:
     void emitProblems();
+    /// @p file with the throughput so far and an estimate of the time left
+    QString progressMessage(const QString& file) const;
 
     QScopedPointer<QElapsedTimer> m_timer;
 
     QScopedPointer<CppcheckParser> m_parser;
     QVector<KDevelop::IProblem::Ptr> m_problems;
 
+    // only the last lines, for debugging a failed run
     QStringList m_standardOutput;
     QStringList m_xmlOutput;
+    int m_checkedCount = 0;
 
     bool m_showXmlOutput;
 
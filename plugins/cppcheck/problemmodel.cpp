@@ -50,6 +50,10 @@ ProblemModel::ProblemModel(Plugin* plugin)
     , m_pathLocation(KDevelop::DocumentRange::invalid())
 {
     setFeatures(CanDoFullUpdate | ScopeFilter | SeverityFilter | Grouping | CanByPassScopeFilter);
+    // the store inserts the nodes of all of the batch at once
+    connect(&m_batcher, &KDevelop::ProblemBatcher::problemsAdded, this, [this](const QVector<KDevelop::IProblem::Ptr>& problems) {
+        KDevelop::ProblemModel::addProblems(problems);
+    });
     reset();
     problemModelSet()->addModel(Strings::problemModelId(), i18n("Cppcheck"), this);
 }
@@ -80,20 +84,6 @@ void ProblemModel::fixProblemFinalLocation(KDevelop::IProblem::Ptr problem)
     }
 }
 
-bool ProblemModel::problemExists(KDevelop::IProblem::Ptr newProblem)
-{
-    for (auto problem : qAsConst(m_problems)) {
-        if (newProblem->source() == problem->source() &&
-            newProblem->severity() == problem->severity() &&
-            newProblem->finalLocation() == problem->finalLocation() &&
-            newProblem->description() == problem->description() &&
-            newProblem->explanation() == problem->explanation())
-            return true;
-    }
-
-    return false;
-}
-
 void ProblemModel::setMessage(const QString& message)
 {
     setPlaceholderText(message, m_pathLocation, i18n("Cppcheck"));
@@ -101,34 +91,19 @@ void ProblemModel::setMessage(const QString& message)
 
 void ProblemModel::addProblems(const QVector<KDevelop::IProblem::Ptr>& problems)
 {
-    static int maxLength = 0;
-
-    if (m_problems.isEmpty()) {
-        maxLength = 0;
-    }
-
-    for (auto problem : problems) {
+    for (const auto& problem : problems) {
         fixProblemFinalLocation(problem);
-
-        if (problemExists(problem)) {
-            continue;
-        }
-
-        m_problems.append(problem);
-        addProblem(problem);
-
-        // This performs adjusting of columns width in the ProblemsView
-        if (maxLength < problem->description().length()) {
-            maxLength = problem->description().length();
-            setProblems(m_problems);
-        }
     }
+
+    m_batcher.addProblems(problems);
 }
 
 void ProblemModel::setProblems()
 {
+    m_batcher.flush();
+
+    // only shown if no batch added problems
     setMessage(i18n("Analysis completed, no problems detected."));
-    setProblems(m_problems);
 }
 
 void ProblemModel::reset()
@@ -144,7 +119,7 @@ void ProblemModel::reset(KDevelop::IProject* project, const QString& path)
     m_pathLocation.document = KDevelop::IndexedString(m_path);
 
     clearProblems();
-    m_problems.clear();
+    m_batcher.clear();
 
     QString tooltip;
     if (m_project) {
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <shell/problembatcher.h>
 #include <shell/problemmodel.h>
 
 namespace KDevelop
@@ -41,6 +42,7 @@ public:
 
     KDevelop::IProject* project() const;
 
+    /// Queues @p problems, they are shown in batches while the analysis goes on
     void addProblems(const QVector<KDevelop::IProblem::Ptr>& problems);
 
     void setProblems();
@@ -54,7 +56,6 @@ public:
 
 private:
     void fixProblemFinalLocation(KDevelop::IProblem::Ptr problem);
-    bool problemExists(KDevelop::IProblem::Ptr newProblem);
     void setMessage(const QString& message);
 
     using KDevelop::ProblemModel::setProblems;
@@ -66,7 +67,7 @@ private:
     QString m_path;
     KDevelop::DocumentRange m_pathLocation;
 
-    QVector<KDevelop::IProblem::Ptr> m_problems;
+    KDevelop::ProblemBatcher m_batcher;
 };
 
 }
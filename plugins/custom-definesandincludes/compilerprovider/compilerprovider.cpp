@@ -114,18 +114,22 @@ QString parserArguments( const ConfigEntry& config, Utils::LanguageType language
 
 ProjectTargetItem* findCompiledTarget(ProjectBaseItem* item)
 {
-    const auto targets = item->targetList();
-    for (auto* item : targets) {
-        if (item->type() == ProjectBaseItem::ExecutableTarget || item->type() == ProjectBaseItem::LibraryTarget) {
-            return item;
+    // walk the children directly, targetList() and folderList() would build lists on each level
+    const int rowCount = item->rowCount();
+    for (int i = 0; i < rowCount; ++i) {
+        auto* child = item->child(i);
+        if (child->type() == ProjectBaseItem::ExecutableTarget || child->type() == ProjectBaseItem::LibraryTarget) {
+            return child->target();
         }
     }
 
-    const auto folders = item->folderList();
-    for (auto* folder: folders) {
-        auto target = findCompiledTarget(folder);
-        if (target)
-            return target;
+    for (int i = 0; i < rowCount; ++i) {
+        auto* child = item->child(i);
+        if (child->folder()) {
+            auto target = findCompiledTarget(child);
+            if (target)
+                return target;
+        }
     }
     return nullptr;
 }
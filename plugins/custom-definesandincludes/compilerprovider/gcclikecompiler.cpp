@@ -23,10 +23,17 @@
 
 #include "gcclikecompiler.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
 #include <QFileInfo>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QMap>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <interfaces/iruntime.h>
 #include <interfaces/iruntimecontroller.h>
 
@@ -37,6 +44,12 @@ using namespace KDevelop;
 namespace
 {
 
+/// Changes whenever what is stored for a probe changes
+const quint32 ProbeCacheVersion = 1;
+
+/// Time a compiler gets to start and to finish a probe, in ms
+const int ProbeTimeout = 2000;
+
 QString languageOption(Utils::LanguageType type)
 {
     switch (type) {
@@ -82,73 +95,60 @@ QString languageStandard(const QString& arguments, Utils::LanguageType type)
     }
 }
 
-}
-
-Defines GccLikeCompiler::defines(Utils::LanguageType type, const QString& arguments) const
+/// The arguments of the probes, only these of @p arguments matter for the results
+QStringList probeArguments(Utils::LanguageType type, const QString& arguments)
 {
-    auto& data = m_definesIncludes[type][arguments];
-    if (!data.definedMacros.isEmpty() ) {
-        return data.definedMacros;
-    }
-
-    // #define a 1
-    // #define a
-    QRegExp defineExpression(QStringLiteral("#define\\s+(\\S+)(?:\\s+(.*)\\s*)?"));
-
-    const auto rt = ICore::self()->runtimeController()->currentRuntime();
-    QProcess proc;
-    proc.setProcessChannelMode( QProcess::MergedChannels );
-
     // TODO: what about -mXXX or -target= flags, some of these change search paths/defines
-    QStringList compilerArguments{
+    QStringList probeArguments{
         languageOption(type),
         languageStandard(arguments, type),
-        QStringLiteral("-dM"),
-        QStringLiteral("-E"),
-        QStringLiteral("-"),
     };
 
     if (arguments.contains(QStringLiteral("-fshort-wchar")))
     {
-        compilerArguments << QStringLiteral("-fshort-wchar");
+        probeArguments << QStringLiteral("-fshort-wchar");
     }
 
-    proc.setStandardInputFile(QProcess::nullDevice());
-    proc.setProgram(path());
-    proc.setArguments(compilerArguments);
-    rt->startProcess(&proc);
+    return probeArguments;
+}
 
-    if ( !proc.waitForStarted( 2000 ) || !proc.waitForFinished( 2000 ) ) {
-        qCDebug(DEFINESANDINCLUDES) <<  "Unable to read standard macro definitions from "<< path() << compilerArguments;
-        return {};
+bool waitForProbe(QProcess* proc, const char* what)
+{
+    if ( !proc->waitForStarted( ProbeTimeout ) || !proc->waitForFinished( ProbeTimeout ) ) {
+        qCDebug(DEFINESANDINCLUDES) << "Unable to read standard" << what << "from" << proc->program() << proc->arguments();
+        return false;
     }
 
-    if (proc.exitCode() != 0) {
-        qCWarning(DEFINESANDINCLUDES) <<  "error while fetching defines for the compiler:" << path() << compilerArguments << proc.readAll();
-        return {};
+    if (proc->exitCode() != 0) {
+        qCWarning(DEFINESANDINCLUDES) << "error while fetching" << what << "for the compiler:" << proc->program() << proc->arguments() << proc->readAll();
+        return false;
     }
 
-    while ( proc.canReadLine() ) {
-        auto line = proc.readLine();
+    return true;
+}
+
+Defines parseDefines(QProcess* proc)
+{
+    Defines definedMacros;
+
+    // #define a 1
+    // #define a
+    QRegExp defineExpression(QStringLiteral("#define\\s+(\\S+)(?:\\s+(.*)\\s*)?"));
+
+    while ( proc->canReadLine() ) {
+        auto line = proc->readLine();
 
         if ( defineExpression.indexIn(QString::fromUtf8(line)) != -1 ) {
-            data.definedMacros[defineExpression.cap( 1 )] = defineExpression.cap( 2 ).trimmed();
+            definedMacros[defineExpression.cap( 1 )] = defineExpression.cap( 2 ).trimmed();
         }
     }
 
-    return data.definedMacros;
+    return definedMacros;
 }
 
-Path::List GccLikeCompiler::includes(Utils::LanguageType type, const QString& arguments) const
+Path::List parseIncludes(QProcess* proc, const IRuntime* rt)
 {
-    auto& data = m_definesIncludes[type][arguments];
-    if ( !data.includePaths.isEmpty() ) {
-        return data.includePaths;
-    }
-
-    const auto rt = ICore::self()->runtimeController()->currentRuntime();
-    QProcess proc;
-    proc.setProcessChannelMode( QProcess::MergedChannels );
+    Path::List includePaths;
 
     // The following command will spit out a bunch of information we don't care
     // about before spitting out the include paths.  The parts we care about
@@ -163,29 +163,6 @@ Path::List GccLikeCompiler::includes(Utils::LanguageType type, const QString& ar
     //  /usr/include
     // End of search list.
 
-    const QStringList compilerArguments{
-        languageOption(type),
-        languageStandard(arguments, type),
-        QStringLiteral("-E"),
-        QStringLiteral("-v"),
-        QStringLiteral("-"),
-    };
-
-    proc.setStandardInputFile(QProcess::nullDevice());
-    proc.setProgram(path());
-    proc.setArguments(compilerArguments);
-    rt->startProcess(&proc);
-
-    if ( !proc.waitForStarted( 2000 ) || !proc.waitForFinished( 2000 ) ) {
-        qCDebug(DEFINESANDINCLUDES) <<  "Unable to read standard include paths from " << path();
-        return {};
-    }
-
-    if (proc.exitCode() != 0) {
-        qCWarning(DEFINESANDINCLUDES) <<  "error while fetching includes for the compiler:" << path() << proc.readAll();
-        return {};
-    }
-
     // We'll use the following constants to know what we're currently parsing.
     enum Status {
         Initial,
@@ -195,7 +172,7 @@ Path::List GccLikeCompiler::includes(Utils::LanguageType type, const QString& ar
     };
     Status mode = Initial;
 
-    const auto output = QString::fromLocal8Bit( proc.readAllStandardOutput() );
+    const auto output = QString::fromLocal8Bit( proc->readAllStandardOutput() );
     const auto lines = output.splitRef(QLatin1Char('\n'));
     for (const auto& line : lines) {
         switch ( mode ) {
@@ -219,7 +196,7 @@ Path::List GccLikeCompiler::includes(Utils::LanguageType type, const QString& ar
                     auto hostPath = rt->pathInHost(Path(QFileInfo(line.trimmed().toString()).canonicalFilePath()));
                     // but skip folders with compiler builtins, we cannot parse these with clang
                     if (!QFile::exists(hostPath.toLocalFile() + QLatin1String("/cpuid.h"))) {
-                        data.includePaths << Path(QFileInfo(hostPath.toLocalFile()).canonicalFilePath());
+                        includePaths << Path(QFileInfo(hostPath.toLocalFile()).canonicalFilePath());
                     }
                 }
                 break;
@@ -231,11 +208,165 @@ Path::List GccLikeCompiler::includes(Utils::LanguageType type, const QString& ar
         }
     }
 
-    return data.includePaths;
+    return includePaths;
+}
+
+QString probeCachePath(const QByteArray& key)
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+        + QLatin1String("/compilerprobes/") + QString::fromLatin1(key);
+}
+
+}
+
+GccLikeCompiler::DefinesIncludes GccLikeCompiler::definesIncludes(Utils::LanguageType type, const QString& arguments) const
+{
+    // many arguments lead to the same probe, so the results are shared by those
+    auto& probeKey = m_probeKeys[type][arguments];
+    if (probeKey.isEmpty()) {
+        probeKey = probeArguments(type, arguments).join(QLatin1Char(' '));
+    }
+
+    auto it = m_definesIncludes.constFind(probeKey);
+    if (it == m_definesIncludes.constEnd()) {
+        it = m_definesIncludes.insert(probeKey, probe(probeArguments(type, arguments)));
+    }
+    return *it;
+}
+
+GccLikeCompiler::DefinesIncludes GccLikeCompiler::probe(const QStringList& arguments) const
+{
+    DefinesIncludes data;
+
+    const auto rt = ICore::self()->runtimeController()->currentRuntime();
+    const QByteArray key = probeCacheKey(rt, arguments);
+    if (!key.isEmpty() && loadProbe(key, &data)) {
+        return data;
+    }
+
+    // the probes are independent, so they run at the same time
+    QProcess definesProc;
+    QProcess includesProc;
+    for (QProcess* proc : {&definesProc, &includesProc}) {
+        proc->setProcessChannelMode( QProcess::MergedChannels );
+        proc->setStandardInputFile(QProcess::nullDevice());
+        proc->setProgram(path());
+    }
+    definesProc.setArguments(arguments + QStringList{QStringLiteral("-dM"), QStringLiteral("-E"), QStringLiteral("-")});
+    includesProc.setArguments(arguments + QStringList{QStringLiteral("-E"), QStringLiteral("-v"), QStringLiteral("-")});
+    rt->startProcess(&definesProc);
+    rt->startProcess(&includesProc);
+
+    const bool definesRead = waitForProbe(&definesProc, "macro definitions");
+    const bool includesRead = waitForProbe(&includesProc, "include paths");
+    if (definesRead) {
+        data.definedMacros = parseDefines(&definesProc);
+    }
+    if (includesRead) {
+        data.includePaths = parseIncludes(&includesProc, rt);
+    }
+
+    if (definesRead && includesRead && !key.isEmpty()) {
+        storeProbe(key, data);
+    }
+    return data;
+}
+
+QByteArray GccLikeCompiler::probeCacheKey(const IRuntime* rt, const QStringList& arguments) const
+{
+    QString executable = path();
+    if (!QFileInfo(executable).isAbsolute()) {
+        executable = rt->findExecutable(executable);
+    }
+    const QFileInfo info(rt->pathInHost(Path(executable)).toLocalFile());
+    if (executable.isEmpty() || !info.exists()) {
+        return {};
+    }
+
+    // the compiler is identified by its file, replacing it gives new results
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(rt->name().toUtf8() + '\n');
+    hash.addData(executable.toUtf8() + '\n');
+    hash.addData(QByteArray::number(info.size()) + ':' + QByteArray::number(info.lastModified().toMSecsSinceEpoch()) + '\n');
+    hash.addData(arguments.join(QLatin1Char(' ')).toUtf8() + '\n');
+    // these add to the include paths the compiler reports
+    for (const char* variable : {"CPATH", "C_INCLUDE_PATH", "CPLUS_INCLUDE_PATH", "OBJC_INCLUDE_PATH"}) {
+        hash.addData(rt->getenv(variable) + '\n');
+    }
+    return hash.result().toHex();
+}
+
+bool GccLikeCompiler::loadProbe(const QByteArray& key, DefinesIncludes* data)
+{
+    QFile file(probeCachePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 version = 0;
+    QStringList includePaths;
+    stream >> version;
+    if (version != ProbeCacheVersion) {
+        return false;
+    }
+    stream >> data->definedMacros >> includePaths;
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    // e.g. a compiler wrapper stays the same while the compiler behind it gets updated
+    data->includePaths.clear();
+    data->includePaths.reserve(includePaths.size());
+    for (const QString& includePath : qAsConst(includePaths)) {
+        if (!QFileInfo(includePath).isDir()) {
+            qCDebug(DEFINESANDINCLUDES) << "outdated compiler probe cache, missing" << includePath;
+            data->definedMacros.clear();
+            data->includePaths.clear();
+            return false;
+        }
+        data->includePaths << Path(includePath);
+    }
+    return true;
+}
+
+void GccLikeCompiler::storeProbe(const QByteArray& key, const DefinesIncludes& data)
+{
+    const QString filePath = probeCachePath(key);
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath())) {
+        return;
+    }
+
+    QStringList includePaths;
+    includePaths.reserve(data.includePaths.size());
+    for (const Path& includePath : data.includePaths) {
+        includePaths << includePath.toLocalFile();
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream << ProbeCacheVersion << data.definedMacros << includePaths;
+    if (!file.commit()) {
+        qCWarning(DEFINESANDINCLUDES) << "failed to store the compiler probe in" << filePath;
+    }
+}
+
+Defines GccLikeCompiler::defines(Utils::LanguageType type, const QString& arguments) const
+{
+    return definesIncludes(type, arguments).definedMacros;
+}
+
+Path::List GccLikeCompiler::includes(Utils::LanguageType type, const QString& arguments) const
+{
+    return definesIncludes(type, arguments).includePaths;
 }
 
 void GccLikeCompiler::invalidateCache()
 {
+    m_probeKeys.clear();
     m_definesIncludes.clear();
 }
 
@@ -26,6 +26,10 @@
 
 #include "icompiler.h"
 
+namespace KDevelop {
+class IRuntime;
+}
+
 class GccLikeCompiler : public QObject, public ICompiler
 {
     Q_OBJECT
@@ -44,8 +48,19 @@ private:
         KDevelop::Path::List includePaths;
     };
 
-    /// List of defines/includes per arguments
-    mutable QHash<Utils::LanguageType, QHash<QString, DefinesIncludes>> m_definesIncludes;
+    DefinesIncludes definesIncludes(Utils::LanguageType type, const QString& arguments) const;
+    /// Runs the compiler with @p arguments to find its defines and includes, unless they are on disk already
+    DefinesIncludes probe(const QStringList& arguments) const;
+
+    /// Key of the probe with @p arguments on disk, empty if the compiler file is not found
+    QByteArray probeCacheKey(const KDevelop::IRuntime* rt, const QStringList& arguments) const;
+    static bool loadProbe(const QByteArray& key, DefinesIncludes* data);
+    static void storeProbe(const QByteArray& key, const DefinesIncludes& data);
+
+    /// The arguments of the probe per language and arguments
+    mutable QHash<Utils::LanguageType, QHash<QString, QString>> m_probeKeys;
+    /// Defines/includes per arguments of the probe, also when it failed
+    mutable QHash<QString, DefinesIncludes> m_definesIncludes;
 };
 
 #endif // GCCLIKECOMPILER_H
@@ -64,6 +64,11 @@ const Value& Value::operator[](int) const
     throw type_error();
 }
 
+QVector<const Value*> Value::allFields(const QString&) const
+{
+    throw type_error();
+}
+
 QString StringLiteralValue::literal() const
 {
     return literal_;
@@ -96,6 +101,16 @@ const Value& TupleValue::operator[](const QString& variable) const
     return *result->value;
 }
 
+QVector<const Value*> TupleValue::allFields(const QString& variable) const
+{
+    QVector<const Value*> ret;
+    for (const Result* result : results) {
+        if (result->variable == variable && result->value)
+            ret.append(result->value);
+    }
+    return ret;
+}
+
 ListValue::~ListValue()
 {
     qDeleteAll(results);
@@ -124,3 +139,164 @@ const Value& ListValue::operator[](int index) const
 
 
 
+
+QString KDevMI::MI::decodeStringLiteral(const char* data, int size)
+{
+    const QString message = QString::fromUtf8(data, size);
+
+    int length = message.length();
+    QString message2;
+    message2.reserve(length);
+    // The [1,length-1] range removes quotes without extra
+    // call to 'mid'
+    for(int i = 1, e = length-1; i < e; ++i)
+    {
+        int translated = -1;
+        if (message[i] == QLatin1Char('\\')) {
+            if (i+1 < length)
+            {
+                // TODO: implement all the other escapes, maybe
+                if (message[i+1] == QLatin1Char('n')) {
+                    translated = '\n';
+                }
+                else if (message[i+1] == QLatin1Char('\\')) {
+                    translated = '\\';
+                }
+                else if (message[i+1] == QLatin1Char('"')) {
+                    translated = '"';
+                }
+                else if (message[i+1] == QLatin1Char('t')) {
+                    translated = '\t';
+                }
+                else if (message[i+1] == QLatin1Char('r')) {
+                    translated = '\r';
+                }
+            }
+        }
+
+        if (translated != -1)
+        {
+            message2.append(QLatin1Char(translated));
+            ++i;
+        }
+        else
+        {
+            message2.append(message[i]);
+        }
+    }
+
+    return message2;
+}
+
+ValueArena::~ValueArena()
+{
+    // Values in the arena hold no resources, skipping their
+    // destructors is fine.
+    for (char* block : qAsConst(m_blocks)) {
+        delete[] block;
+    }
+}
+
+void* ValueArena::allocate(size_t size, size_t alignment)
+{
+    // Most records are small, a single block usually holds all of them
+    static const size_t blockSize = 4096;
+
+    size_t padding = (alignment - reinterpret_cast<quintptr>(m_pos) % alignment) % alignment;
+    if (padding + size > m_left) {
+        const size_t newSize = qMax(blockSize, size + alignment);
+        m_pos = new char[newSize];
+        m_blocks.append(m_pos);
+        m_left = newSize;
+        padding = 0;
+    }
+
+    m_pos += padding;
+    void* ret = m_pos;
+    m_pos += size;
+    m_left -= padding + size;
+    return ret;
+}
+
+QString StringViewValue::literal() const
+{
+    return decodeStringLiteral(data_, size_);
+}
+
+int StringViewValue::toInt(int base) const
+{
+    bool ok;
+    int result = literal().toInt(&ok, base);
+    if (!ok)
+        throw type_error();
+    return result;
+}
+
+const ViewField* TupleViewValue::find(const QString& variable) const
+{
+    // Tuples are small, and like results_by_name the last one
+    // of repeated names wins.
+    for (int i = count - 1; i >= 0; --i) {
+        const ViewField& field = fields[i];
+        if (field.value && QLatin1String(field.name, field.nameSize) == variable)
+            return &field;
+    }
+    return nullptr;
+}
+
+bool TupleViewValue::hasField(const QString& variable) const
+{
+    return find(variable);
+}
+
+const Value& TupleViewValue::operator[](const QString& variable) const
+{
+    const ViewField* field = find(variable);
+    if (!field)
+        throw type_error();
+    return *field->value;
+}
+
+QVector<const Value*> TupleViewValue::allFields(const QString& variable) const
+{
+    QVector<const Value*> ret;
+    for (int i = 0; i < count; ++i) {
+        const ViewField& field = fields[i];
+        if (field.value && QLatin1String(field.name, field.nameSize) == variable)
+            ret.append(field.value);
+    }
+    return ret;
+}
+
+bool ListViewValue::empty() const
+{
+    return count == 0;
+}
+
+int ListViewValue::size() const
+{
+    return count;
+}
+
+const Value& ListViewValue::operator[](int index) const
+{
+    if (index >= 0 && index < count && items[index].value)
+        return *items[index].value;
+    else
+        throw type_error();
+}
+
+bool TupleRecord::hasField(const QString& variable) const
+{
+    return view ? view->hasField(variable) : TupleValue::hasField(variable);
+}
+
+const Value& TupleRecord::operator[](const QString& variable) const
+{
+    return view ? (*view)[variable] : TupleValue::operator[](variable);
+}
+
+QVector<const Value*> TupleRecord::allFields(const QString& variable) const
+{
+    return view ? view->allFields(variable) : TupleValue::allFields(variable);
+}
@@ -26,8 +26,13 @@
 
 #include <QString>
 #include <QMap>
+#include <QVector>
 
+#include <memory>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 /**
 @author Roberto Raggi
@@ -130,6 +135,7 @@ namespace KDevMI { namespace MI {
         VarListChildren,
         VarSetFormat,
         VarSetFrozen,
+        VarSetUpdateRange,
         VarShowAttributes,
         VarShowFormat,
         VarUpdate
@@ -226,6 +232,12 @@ namespace KDevMI { namespace MI {
         */
         virtual const Value& operator[](const QString& variable) const;
 
+        /** If this value is a tuple, returns all fields named 'variable',
+            in order. Unlike operator[], this sees repeated names, which
+            some MI implementations emit. Otherwise, throws type_error.
+        */
+        virtual QVector<const Value*> allFields(const QString& variable) const;
+
         /** If this value is a list, returns true if the list is empty.
             If this value is not a list, throws 'type_error'.
         */
@@ -283,6 +295,8 @@ namespace KDevMI { namespace MI {
         using Value::operator[];
         const Value& operator[](const QString& variable) const override;
 
+        QVector<const Value*> allFields(const QString& variable) const override;
+
         QList<Result*> results;
         QMap<QString, Result*> results_by_name;
     };
@@ -302,6 +316,118 @@ namespace KDevMI { namespace MI {
         QList<Result*> results;
     };
 
+    /** Strips the quotes of the raw MI string literal 'data' and
+        processes the C escape sequences in it.
+    */
+    QString decodeStringLiteral(const char* data, int size);
+
+    /** @internal
+        Bump allocator owning all values of a record parsed with
+        MIParser::ViewValues. Values created here are never destroyed
+        individually, so they must not own any resources.
+    */
+    class ValueArena
+    {
+    public:
+        ValueArena() = default;
+        ~ValueArena();
+
+        template<typename T, typename... Args>
+        T* create(Args&&... args)
+        {
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        template<typename T>
+        T* createArray(int count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "arena arrays are never destroyed");
+            return count ? static_cast<T*>(allocate(sizeof(T) * count, alignof(T))) : nullptr;
+        }
+
+    private:
+        void* allocate(size_t size, size_t alignment);
+
+        Q_DISABLE_COPY(ValueArena)
+
+        QVector<char*> m_blocks;
+        char* m_pos = nullptr;
+        size_t m_left = 0;
+    };
+
+    /** @internal
+        Name-value pair of a view tuple or list. 'name' points into
+        the raw record and is not null terminated.
+    */
+    struct ViewField
+    {
+        const char* name;
+        int nameSize;
+        const Value* value;
+    };
+
+    /** String literal that refers to the raw MI record instead of
+        copying it. The escape sequences are only decoded when the
+        literal is accessed.
+    */
+    struct StringViewValue : public Value
+    {
+        StringViewValue(const char* data, int size)
+            : Value(StringLiteral)
+            , data_(data)
+            , size_(size)
+        {}
+
+    public: // Value overrides
+        QString literal() const override;
+        int toInt(int base) const override;
+
+    private:
+        const char* data_;
+        int size_;
+    };
+
+    struct TupleViewValue : public Value
+    {
+        TupleViewValue(const ViewField* fields, int count)
+            : Value(Tuple)
+            , fields(fields)
+            , count(count)
+        {}
+
+        bool hasField(const QString&) const override;
+
+        using Value::operator[];
+        const Value& operator[](const QString& variable) const override;
+
+        QVector<const Value*> allFields(const QString& variable) const override;
+
+        const ViewField* fields;
+        const int count;
+
+    private:
+        const ViewField* find(const QString& variable) const;
+    };
+
+    struct ListViewValue : public Value
+    {
+        ListViewValue(const ViewField* items, int count)
+            : Value(List)
+            , items(items)
+            , count(count)
+        {}
+
+        bool empty() const override;
+
+        int size() const override;
+
+        using Value::operator[];
+        const Value& operator[](int index) const override;
+
+        const ViewField* items;
+        const int count;
+    };
+
     struct Record
     {
         enum Kind {
@@ -327,6 +453,21 @@ namespace KDevMI { namespace MI {
 
     struct TupleRecord : public Record, public TupleValue
     {
+        bool hasField(const QString&) const override;
+
+        using Value::operator[];
+        const Value& operator[](const QString& variable) const override;
+
+        QVector<const Value*> allFields(const QString& variable) const override;
+
+        /** Set when the record was parsed with MIParser::ViewValues.
+            The fields are then not in 'results' but in 'view', which
+            refers to 'raw' and lives in 'arena'.
+        */
+        QByteArray raw;
+        std::unique_ptr<ValueArena> arena;
+        const TupleViewValue* view = nullptr;
+
     protected:
         explicit TupleRecord(Record::Kind k) : Record(k) {}
     };
@@ -396,4 +537,6 @@ namespace KDevMI { namespace MI {
 } // end of namespace MI
 } // end of namespace KDevMI
 
+Q_DECLARE_TYPEINFO(KDevMI::MI::ViewField, Q_PRIMITIVE_TYPE);
+
 #endif
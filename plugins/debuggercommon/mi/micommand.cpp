@@ -35,6 +35,56 @@ void FunctionCommandHandler::handle(const ResultRecord& r)
 }
 
 
+namespace {
+
+/// Invokes the handlers of commands collapsed into one, in the order they were queued
+class ChainedCommandHandler : public MICommandHandler
+{
+public:
+    ChainedCommandHandler(MICommandHandler* first, MICommandHandler* second)
+        : m_first(first)
+        , m_second(second)
+    {}
+
+    ~ChainedCommandHandler() override
+    {
+        // only reached with handlers left if the command never got a reply
+        if (m_first && m_first->autoDelete())
+            delete m_first;
+        if (m_second && m_second->autoDelete())
+            delete m_second;
+    }
+
+    void handle(const ResultRecord& r) override
+    {
+        invoke(m_first, r);
+        invoke(m_second, r);
+    }
+
+    bool handlesError() override
+    {
+        return m_first->handlesError();
+    }
+
+private:
+    static void invoke(MICommandHandler*& handler, const ResultRecord& r)
+    {
+        //ask before calling handler as it might deleted itself in handler
+        bool autoDelete = handler->autoDelete();
+
+        handler->handle(r);
+        if (autoDelete) {
+            delete handler;
+        }
+        handler = nullptr;
+    }
+
+    MICommandHandler* m_first;
+    MICommandHandler* m_second;
+};
+
+}
+
 MICommand::MICommand(CommandType type, const QString& command, CommandFlags flags)
     : type_(type)
     , flags_(flags)
@@ -134,6 +184,75 @@ bool MICommand::handlesError() const
     return commandHandler_ ? commandHandler_->handlesError() : false;
 }
 
+bool MICommand::isPipelinable() const
+{
+    if (flags_ & (CmdMaybeStartsRunning | CmdImmediately | CmdInterrupt))
+        return false;
+
+    switch (type_) {
+        // These change the state of variable objects only, which later
+        // commands see since the debugger processes them in order.
+        case VarCreate:
+        case VarDelete:
+        case VarListChildren:
+        case VarSetFormat:
+        case VarSetUpdateRange:
+        case VarUpdate:
+            return true;
+        // The handler selects the current thread, which the commands
+        // after it are sent for.
+        case ThreadInfo:
+            return false;
+        default:
+            return isQuery();
+    }
+}
+
+bool MICommand::isQuery() const
+{
+    switch (type_) {
+        case BreakInfo:
+        case BreakList:
+        case DataListChangedRegisters:
+        case DataListRegisterNames:
+        case DataListRegisterValues:
+        case DataReadMemory:
+        case StackInfoDepth:
+        case StackInfoFrame:
+        case StackListArguments:
+        case StackListFrames:
+        case StackListLocals:
+        case ThreadInfo:
+        case ThreadListIds:
+        case VarEvaluateExpression:
+        case VarInfoPathExpression:
+        case VarInfoNumChildren:
+        case VarInfoType:
+        case VarShowAttributes:
+        case VarShowFormat:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MICommand::mergeHandler(MICommand* other)
+{
+    if (handlesError() != other->handlesError())
+        return false;
+
+    MICommandHandler* otherHandler = other->commandHandler_;
+    other->commandHandler_ = nullptr;
+    if (!otherHandler)
+        return true;
+
+    if (commandHandler_)
+        commandHandler_ = new ChainedCommandHandler(commandHandler_, otherHandler);
+    else
+        commandHandler_ = otherHandler;
+    return true;
+}
+
 UserCommand::UserCommand(CommandType type, const QString& s)
     : MICommand(type, s, CmdMaybeStartsRunning)
 {
@@ -320,6 +439,8 @@ QString MICommand::miCommand() const
             return QStringLiteral("-var-set-format");
         case VarSetFrozen:
             return QStringLiteral("-var-set-frozen");
+        case VarSetUpdateRange:
+            return QStringLiteral("-var-set-update-range");
         case VarShowAttributes:
             return QStringLiteral("-var-show-attributes");
         case VarShowFormat:
@@ -182,6 +182,25 @@ public:
     // on MI errors.
     bool handlesError() const;
 
+    /**
+     * Whether the command may be sent while earlier commands still await their
+     * results. True for queries and variable object commands, which neither resume
+     * the inferior nor change the context later commands are evaluated in.
+     */
+    bool isPipelinable() const;
+
+    /**
+     * Whether the command only reads the debugger state without side effects,
+     * so that a queued duplicate can be served by the reply to the first one.
+     */
+    bool isQuery() const;
+
+    /**
+     * Takes over the handler of @p other, so that the reply to this command
+     * serves both. Returns false if the handlers can't be combined.
+     */
+    bool mergeHandler(MICommand* other);
+
     // Called by debuggercontroller for each new output string
     // debugger emits for this command. In MI mode, this includes
     // all "stream" messages, but does not include MI responses.
@@ -21,6 +21,9 @@
 #include "micommand.h"
 #include "debuglog.h"
 
+#include <algorithm>
+#include <typeinfo>
+
 using namespace KDevMI::MI;
 
 CommandQueue::CommandQueue()
@@ -32,7 +35,7 @@ CommandQueue::~CommandQueue()
     qDeleteAll(m_commandList);
 }
 
-void CommandQueue::enqueue(MICommand* command)
+bool CommandQueue::enqueue(MICommand* command)
 {
     ++m_tokenCounter;
     if (m_tokenCounter == 0)
@@ -42,6 +45,11 @@ void CommandQueue::enqueue(MICommand* command)
     // take the time when this command was added to the command queue
     command->markAsEnqueued();
 
+    if (collapseDuplicate(command)) {
+        dumpQueue();
+        return false;
+    }
+
     m_commandList.append(command);
 
     if (command->flags() & (CmdImmediately | CmdInterrupt))
@@ -49,6 +57,7 @@ void CommandQueue::enqueue(MICommand* command)
 
     rationalizeQueue(command);
     dumpQueue();
+    return true;
 }
 
 void CommandQueue::dumpQueue() const
@@ -61,6 +70,37 @@ void CommandQueue::dumpQueue() const
     }
 }
 
+bool CommandQueue::collapseDuplicate(MICommand* command)
+{
+    // CliCommand handlers read the stream output of their own command
+    if (!command->isQuery() || !command->isPipelinable() || dynamic_cast<CliCommand*>(command))
+        return false;
+
+    // Look for the same query since the last command that changes
+    // the debugger state, its reply will answer both.
+    for (int i = m_commandList.size() - 1; i >= 0; --i) {
+        MICommand* queued = m_commandList.at(i);
+        if (!queued->isQuery())
+            return false;
+
+        if (queued->type() == command->type()
+            && queued->command() == command->command()
+            && queued->thread() == command->thread()
+            && queued->frame() == command->frame()
+            && queued->stateReloading() == command->stateReloading()
+            && queued->isPipelinable()
+            && typeid(*queued) == typeid(*command)
+            && queued->mergeHandler(command))
+        {
+            qCDebug(DEBUGGERCOMMON) << "Collapsed" << command->initialString()
+                                    << "into" << queued->initialString();
+            delete command;
+            return true;
+        }
+    }
+    return false;
+}
+
 void CommandQueue::rationalizeQueue(MICommand* command)
 {
     if ((command->type() >= ExecAbort && command->type() <= ExecUntil) &&
@@ -126,6 +166,17 @@ bool CommandQueue::haveImmediateCommand() const
     return m_immediatelyCounter > 0;
 }
 
+bool CommandQueue::haveStateReloadingCommand() const
+{
+    return std::any_of(m_commandList.begin(), m_commandList.end(),
+                       [](const MICommand* command) { return command->stateReloading(); });
+}
+
+const MICommand* CommandQueue::peekNextCommand() const
+{
+    return m_commandList.isEmpty() ? nullptr : m_commandList.first();
+}
+
 MICommand* CommandQueue::nextCommand()
 {
     if (m_commandList.isEmpty())
@@ -32,8 +32,12 @@ public:
     CommandQueue();
     ~CommandQueue();
 
-    /// CommandQueue takes ownership of @p command.
-    void enqueue(MICommand* command);
+    /**
+     * CommandQueue takes ownership of @p command.
+     * Returns @c false if @p command was merged into an identical queued query
+     * and deleted, it must not be used after the call then.
+     */
+    bool enqueue(MICommand* command);
 
     bool isEmpty() const;
     int count() const;
@@ -42,6 +46,9 @@ public:
     /// Whether the queue contains a command with CmdImmediately or CmdInterrupt flags.
     bool haveImmediateCommand() const;
 
+    /// Whether the queue contains a command issued during the state reload.
+    bool haveStateReloadingCommand() const;
+
     /**
      * Retrieve and remove the next command from the list.
      * Ownership of the command is transferred to the caller.
@@ -49,7 +56,14 @@ public:
      */
     MICommand* nextCommand();
 
+    /**
+     * The command nextCommand() would return, without removing it.
+     * Returns @c nullptr if the list is empty.
+     */
+    const MICommand* peekNextCommand() const;
+
 private:
+    bool collapseDuplicate(MICommand* command);
     void rationalizeQueue(MICommand* command);
     void removeVariableUpdates();
     void removeStackListUpdates();
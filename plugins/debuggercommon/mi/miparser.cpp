@@ -22,6 +22,8 @@
 #include "miparser.h"
 #include "tokens.h"
 
+#include <algorithm>
+
 using namespace KDevMI::MI;
 
 #define MATCH(tok) \
@@ -56,6 +58,16 @@ MIParser::~MIParser()
 {
 }
 
+void MIParser::setValueStorage(ValueStorage storage)
+{
+    m_valueStorage = storage;
+}
+
+MIParser::ValueStorage MIParser::valueStorage() const
+{
+    return m_valueStorage;
+}
+
 std::unique_ptr<Record> MIParser::parse(FileSymbol *file)
 {
     m_lex = nullptr;
@@ -164,8 +176,12 @@ std::unique_ptr<Record> MIParser::parseResultOrAsyncRecord()
     if (m_lex->lookAhead() == ',') {
         m_lex->nextToken();
 
-        if (!parseCSV(*result))
+        if (m_valueStorage == ViewValues) {
+            if (!parseRecordView(*result))
+                return {};
+        } else if (!parseCSV(*result)) {
             return {};
+        }
     }
 
     return result;
@@ -322,51 +338,116 @@ bool MIParser::parseCSV(TupleValue& value,
 
 QString MIParser::parseStringLiteral()
 {
-    QByteArray messageByteArray = m_lex->currentTokenText();
-    QString message = QString::fromUtf8(messageByteArray.constData());
-
-    int length = message.length();
-    QString message2;
-    message2.reserve(length);
-    // The [1,length-1] range removes quotes without extra
-    // call to 'mid'
-    for(int i = 1, e = length-1; i != e; ++i)
-    {
-        int translated = -1;
-        if (message[i] == QLatin1Char('\\')) {
-            if (i+1 < length)
-            {
-                // TODO: implement all the other escapes, maybe
-                if (message[i+1] == QLatin1Char('n')) {
-                    translated = '\n';
-                }
-                else if (message[i+1] == QLatin1Char('\\')) {
-                    translated = '\\';
-                }
-                else if (message[i+1] == QLatin1Char('"')) {
-                    translated = '"';
-                }
-                else if (message[i+1] == QLatin1Char('t')) {
-                    translated = '\t';
-                }
-                else if (message[i+1] == QLatin1Char('r')) {
-                    translated = '\r';
-                }
-            }
-        }
+    const Token& token = *m_lex->m_currentToken;
+    QString message = decodeStringLiteral(m_lex->m_contents.constData() + token.position, token.length);
 
-        if (translated != -1)
-        {
-            message2.append(translated);
-            ++i;
-        }
-        else
-        {
-            message2.append(message[i]);
+    m_lex->nextToken();
+    return message;
+}
+
+bool MIParser::parseRecordView(TupleRecord& record)
+{
+    // The views point into the token stream's copy of the line, which
+    // shares its data with 'raw'
+    record.raw = m_lex->m_contents;
+    record.arena.reset(new ValueArena);
+
+    m_arena = record.arena.get();
+    m_fieldStack.clear();
+
+    const Value *fields = nullptr;
+    const bool ok = parseViewCSV(fields, Value::Tuple);
+    m_arena = nullptr;
+    if (!ok)
+        return false;
+
+    record.view = static_cast<const TupleViewValue*>(fields);
+    return true;
+}
+
+bool MIParser::parseViewResult(ViewField& field)
+{
+    // as lenient as parseResult
+    field = ViewField{nullptr, 0, nullptr};
+
+    if (m_lex->lookAhead() == Token_identifier) {
+        const Token& token = *m_lex->m_currentToken;
+        field.name = m_lex->m_contents.constData() + token.position;
+        field.nameSize = token.length;
+        m_lex->nextToken();
+
+        if (m_lex->lookAhead() != '=')
+            return true;
+
+        m_lex->nextToken();
+    }
+
+    return parseViewValue(field.value);
+}
+
+bool MIParser::parseViewValue(const Value *&value)
+{
+    value = nullptr;
+
+    switch (m_lex->lookAhead()) {
+        case Token_string_literal: {
+            const Token& token = *m_lex->m_currentToken;
+            value = m_arena->create<StringViewValue>(m_lex->m_contents.constData() + token.position,
+                                                     token.length);
+            m_lex->nextToken();
         }
+        return true;
+
+        case '{':
+            return parseViewCSV(value, Value::Tuple, '{', '}');
+
+        case '[':
+            return parseViewCSV(value, Value::List, '[', ']');
+
+        default:
+            break;
     }
 
-    m_lex->nextToken();
-    return message2;
+    return false;
 }
 
+bool MIParser::parseViewCSV(const Value *&value, Value::Kind kind,
+                            char start, char end)
+{
+    if (start)
+        ADVANCE(start);
+
+    // Nested values push their fields on top of ours and pop them
+    // once they are copied into the arena.
+    const int first = m_fieldStack.size();
+
+    int tok = m_lex->lookAhead();
+    while (tok) {
+        if (end && tok == end)
+            break;
+
+        ViewField field;
+        if (!parseViewResult(field))
+            return false;
+        m_fieldStack.append(field);
+
+        if (m_lex->lookAhead() == ',')
+            m_lex->nextToken();
+
+        tok = m_lex->lookAhead();
+    }
+
+    if (end)
+        ADVANCE(end);
+
+    const int count = m_fieldStack.size() - first;
+    auto *fields = m_arena->createArray<ViewField>(count);
+    std::copy(m_fieldStack.constBegin() + first, m_fieldStack.constEnd(), fields);
+    m_fieldStack.resize(first);
+
+    if (kind == Value::List)
+        value = m_arena->create<ListViewValue>(fields, count);
+    else
+        value = m_arena->create<TupleViewValue>(fields, count);
+    return true;
+}
@@ -35,9 +35,20 @@ namespace KDevMI { namespace MI {
 class MIParser
 {
 public:
+    enum ValueStorage {
+        /// Every value is a heap object owning its decoded string
+        OwningValues,
+        /// Values of result and async records are views into the raw
+        /// line, allocated from an arena owned by the record
+        ViewValues
+    };
+
     MIParser();
     ~MIParser();
 
+    void setValueStorage(ValueStorage storage);
+    ValueStorage valueStorage() const;
+
     std::unique_ptr<Record> parse(FileSymbol *file);
 
 protected: // rules
@@ -74,9 +85,24 @@ protected: // rules
     */
     QString parseStringLiteral();
 
+    /** Zero-copy counterparts of the rules above, used for
+        ViewValues. All values are created in m_arena.
+    */
+    bool parseRecordView(TupleRecord& record);
+    bool parseViewResult(ViewField& field);
+    bool parseViewValue(const Value *&value);
+    bool parseViewCSV(const Value *&value, Value::Kind kind,
+                      char start = 0, char end = 0);
+
 private:
     MILexer m_lexer;
     TokenStream *m_lex = nullptr;
+
+    ValueStorage m_valueStorage = OwningValues;
+    ValueArena *m_arena = nullptr;
+    // Fields of the tuples and lists still being parsed, reused
+    // between records
+    QVector<ViewField> m_fieldStack;
 };
 
 } // end of namespace MI
@@ -37,8 +37,8 @@
 #include <QString>
 #include <QStringList>
 
+#include <algorithm>
 #include <csignal>
-
 #include <memory>
 #include <stdexcept>
 #include <sstream>
@@ -65,6 +65,10 @@ MIDebugger::MIDebugger(QObject* parent)
             this, &MIDebugger::processFinished);
     connect(m_process, &QProcess::errorOccurred,
             this, &MIDebugger::processErrored);
+
+    // Large replies like -stack-list-frames are mostly never looked
+    // at completely, don't decode and copy every field up front.
+    m_parser.setValueStorage(MI::MIParser::ViewValues);
 }
 
 MIDebugger::~MIDebugger()
@@ -76,12 +80,16 @@ MIDebugger::~MIDebugger()
         m_process->kill();
         m_process->waitForFinished(10);
     }
+    qDeleteAll(m_pipelinedCmds);
 }
 
 void MIDebugger::execute(MICommand* command)
 {
-    m_currentCmd = command;
-    QString commandText = m_currentCmd->cmdToSend();
+    if (m_currentCmd)
+        m_pipelinedCmds.append(command);
+    else
+        m_currentCmd = command;
+    QString commandText = command->cmdToSend();
 
     qCDebug(DEBUGGERCOMMON) << "SEND:" << commandText.trimmed();
 
@@ -90,11 +98,11 @@ void MIDebugger::execute(MICommand* command)
     m_process->write(commandUtf8);
     command->markAsSubmitted();
 
-    QString prettyCmd = m_currentCmd->cmdToSend();
+    QString prettyCmd = command->cmdToSend();
     prettyCmd.remove(QRegExp(QStringLiteral("set prompt \032.\n")));
     prettyCmd = QLatin1String("(gdb) ") + prettyCmd;
 
-    if (m_currentCmd->isUserCommand())
+    if (command->isUserCommand())
         emit userCommandOutput(prettyCmd);
     else
         emit internalCommandOutput(prettyCmd);
@@ -105,6 +113,20 @@ bool MIDebugger::isReady() const
     return m_currentCmd == nullptr;
 }
 
+bool MIDebugger::canPipeline(int maxDepth) const
+{
+    if (!m_currentCmd)
+        return true;
+
+    // Only pipelinable commands are ever sent after m_currentCmd
+    return m_currentCmd->isPipelinable() && pendingCommandCount() < maxDepth;
+}
+
+int MIDebugger::pendingCommandCount() const
+{
+    return (m_currentCmd ? 1 : 0) + m_pipelinedCmds.size();
+}
+
 void MIDebugger::interrupt()
 {
 #ifndef Q_OS_WIN
@@ -124,6 +146,15 @@ MICommand* MIDebugger::currentCommand() const
     return m_currentCmd;
 }
 
+bool MIDebugger::haveStateReloadingCommand() const
+{
+    if (m_currentCmd && m_currentCmd->stateReloading())
+        return true;
+
+    return std::any_of(m_pipelinedCmds.begin(), m_pipelinedCmds.end(),
+                       [](const MICommand* command) { return command->stateReloading(); });
+}
+
 void MIDebugger::kill()
 {
     m_process->kill();
@@ -247,7 +278,7 @@ void MIDebugger::processLine(const QByteArray& line)
             }
 
             delete m_currentCmd;
-            m_currentCmd = nullptr;
+            m_currentCmd = m_pipelinedCmds.isEmpty() ? nullptr : m_pipelinedCmds.takeFirst();
             emit ready();
             break;
         }
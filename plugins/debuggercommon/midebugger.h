@@ -53,19 +53,36 @@ public:
     virtual bool start(KConfigGroup& config, const QStringList& extraArguments = {}) = 0;
 
     /** Executes a command.  This method may be called at
-        most once each time 'ready' is emitted.  When the
+        most once each time 'ready' is emitted, unless
+        canPipeline() allows to send the command while others
+        are still awaiting their results.  When the
         debugger instance is just constructed, one should wait
         for 'ready' as well.
 
         The ownership of 'command' is transferred to the debugger.  */
     void execute(MI::MICommand* command);
 
-    /** Returns true if 'execute' can be called immediately.  */
+    /** Returns true if 'execute' can be called immediately, i.e.
+        no command is awaiting its result.  */
     bool isReady() const;
 
-    /** FIXME: temporary, to be eliminated.  */
+    /** Returns true if a pipelinable command may be executed right
+        away: only pipelinable commands await their results, and
+        fewer than 'maxDepth' of them.  */
+    bool canPipeline(int maxDepth) const;
+
+    /** The number of commands sent that await their results.  */
+    int pendingCommandCount() const;
+
+    /** The oldest command awaiting its result, which the next
+        result record and stream output belong to.
+        FIXME: temporary, to be eliminated.  */
     MI::MICommand* currentCommand() const;
 
+    /** Whether a command sent as part of the state reload
+        awaits its result.  */
+    bool haveStateReloadingCommand() const;
+
     /** Arrange to debugger to stop doing whatever it's doing,
         and start waiting for a command.
         FIXME: probably should make sure that 'ready' is
@@ -76,8 +93,9 @@ public:
     void kill();
 
 Q_SIGNALS:
-    /** Emitted when debugger becomes ready -- i.e. when
-        isReady call will return true.  */
+    /** Emitted when debugger has processed a command and can
+        accept the next one. isReady() is false if pipelined
+        commands still await their results.  */
     void ready();
 
     /** Emitted when the debugger itself exits. This could happen because
@@ -139,6 +157,9 @@ protected:
     KProcess* m_process = nullptr;
 
     MI::MICommand* m_currentCmd = nullptr;
+    /** Commands sent after m_currentCmd, in order. The debugger
+        answers in order, so each becomes m_currentCmd in turn. */
+    QList<MI::MICommand*> m_pipelinedCmds;
     MI::MIParser m_parser;
 
     /** The unprocessed output from debugger. Output is
@@ -62,6 +62,12 @@ using namespace KDevelop;
 using namespace KDevMI;
 using namespace KDevMI::MI;
 
+namespace {
+// Upper bound of commands awaiting their results when pipelining,
+// keeps the queue responsive to commands enqueued at the front later
+const int maxPipelineDepth = 8;
+}
+
 MIDebugSession::MIDebugSession(MIDebuggerPlugin *plugin)
     : m_procLineMaker(new ProcessLineMaker(this))
     , m_commandQueue(new CommandQueue)
@@ -781,11 +787,8 @@ void MIDebugSession::queueCmd(MICommand *cmd)
     if (m_stateReloadInProgress)
         cmd->setStateReloading(true);
 
-    m_commandQueue->enqueue(cmd);
-
     qCDebug(DEBUGGERCOMMON) << "QUEUE: " << cmd->initialString()
-                            << (m_stateReloadInProgress ? "(state reloading)" : "")
-                            << m_commandQueue->count() << "pending";
+                            << (m_stateReloadInProgress ? "(state reloading)" : "");
 
     bool varCommandWithContext= (cmd->type() >= MI::VarAssign
                                  && cmd->type() <= MI::VarUpdate
@@ -802,6 +805,13 @@ void MIDebugSession::queueCmd(MICommand *cmd)
             qCDebug(DEBUGGERCOMMON) << "\t--frame will be added on execution";
     }
 
+    // The queue may merge cmd into a queued duplicate and delete it
+    const bool kept = m_commandQueue->enqueue(cmd);
+    cmd = nullptr;
+
+    qCDebug(DEBUGGERCOMMON) << (kept ? "\tqueued," : "\tcollapsed,")
+                            << m_commandQueue->count() << "pending";
+
     setDebuggerStateOn(s_dbgBusy);
     raiseEvent(debugger_busy);
 
@@ -819,8 +829,15 @@ void MIDebugSession::executeCmd()
         ensureDebuggerListening();
     }
 
-    if (!m_debugger->isReady())
-        return;
+    if (!m_debugger->isReady()) {
+        // Send further independent commands without waiting for
+        // the results of those in flight
+        if (!m_commandPipelining)
+            return;
+        const MICommand* next = m_commandQueue->peekNextCommand();
+        if (!next || !next->isPipelinable() || !m_debugger->canPipeline(maxPipelineDepth))
+            return;
+    }
 
     MICommand* currentCmd = m_commandQueue->nextCommand();
     if (!currentCmd)
@@ -895,6 +912,9 @@ void MIDebugSession::executeCmd()
     }
 
     m_debugger->execute(currentCmd);
+
+    if (m_commandPipelining && currentCmd->isPipelinable())
+        executeCmd();
 }
 
 void MIDebugSession::ensureDebuggerListening()
@@ -932,11 +952,17 @@ void MIDebugSession::raiseEvent(event_t e)
 
     IDebugSession::raiseEvent(e);
 
-    if (e == program_state_changed) {
+    if (e == program_state_changed && !hasStateReloadingCommand()) {
         m_stateReloadInProgress = false;
     }
 }
 
+bool MIDebugSession::hasStateReloadingCommand() const
+{
+    return m_commandQueue->haveStateReloadingCommand()
+        || (m_debugger && m_debugger->haveStateReloadingCommand());
+}
+
 bool KDevMI::MIDebugSession::hasCrashed() const
 {
     return m_hasCrashed;
@@ -946,7 +972,10 @@ void MIDebugSession::slotDebuggerReady()
 {
     Q_ASSERT(m_debugger);
 
-    m_stateReloadInProgress = false;
+    // Pipelined or queued commands may still belong to the state reload,
+    // commands their handlers add are part of it as well
+    if (!hasStateReloadingCommand())
+        m_stateReloadInProgress = false;
 
     executeCmd();
     if (m_debugger->isReady()) {
@@ -1306,3 +1335,8 @@ void MIDebugSession::setSourceInitFile(bool enable)
 {
     m_sourceInitFile = enable;
 }
+
+void MIDebugSession::setCommandPipelining(bool enable)
+{
+    m_commandPipelining = enable;
+}
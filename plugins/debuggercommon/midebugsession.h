@@ -258,10 +258,14 @@ protected:
 
     /** Try to execute next command in the queue.  If GDB is not
         busy with previous command, and there's a command in the
-        queue, sends it.  */
+        queue, sends it.  With command pipelining enabled, also sends
+        independent commands while earlier ones await their results.  */
     void executeCmd();
     void destroyCmds();
 
+    /** Whether a command of the state reload is queued or awaits its result.  */
+    bool hasStateReloadingCommand() const;
+
     virtual void ensureDebuggerListening();
 
     /**
@@ -328,6 +332,11 @@ protected:
     // configurable option
     void setSourceInitFile(bool enable);
 
+    /** Whether independent queries and varobj commands may be sent
+        before the results of the previous commands arrive. Requires
+        a debugger that answers commands strictly in order.  */
+    void setCommandPipelining(bool enable);
+
 private Q_SLOTS:
     void handleTargetAttach(const MI::ResultRecord& r);
     // Pops up a dialog box with some hopefully
@@ -354,6 +363,7 @@ protected:
 
     bool m_hasCrashed = false;
     bool m_sourceInitFile = true;
+    bool m_commandPipelining = false;
 
     // Map from GDB varobj name to MIVariable.
     QMap<QString, MIVariable*> m_allVariables;
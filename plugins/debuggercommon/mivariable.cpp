@@ -57,7 +57,8 @@ MIVariable *MIVariable::createChild(const Value& child)
     auto var = static_cast<MIVariable*>(m_debugSession->variableController()->createVariable(model(), this, child[QStringLiteral("exp")].literal()));
     var->setTopLevel(false);
     var->setVarobj(child[QStringLiteral("name")].literal());
-    bool hasMore = child[QStringLiteral("numchild")].toInt() != 0 || ( child.hasField(QStringLiteral("dynamic")) && child[QStringLiteral("dynamic")].toInt()!=0 );
+    var->m_dynamic = child.hasField(QStringLiteral("dynamic")) && child[QStringLiteral("dynamic")].toInt() != 0;
+    bool hasMore = child[QStringLiteral("numchild")].toInt() != 0 || var->m_dynamic;
     var->setHasMoreInitial(hasMore);
 
     // *this must be parent's child before we can set type and value
@@ -121,6 +122,9 @@ public:
             variable->setShowError(true);
         } else {
             variable->setVarobj(r[QStringLiteral("name")].literal());
+            variable->m_dynamic = r.hasField(QStringLiteral("dynamic")) && r[QStringLiteral("dynamic")].toInt();
+            // children of a previous varobj are gone, don't wait for them
+            variable->m_fetchInProgress = false;
 
             bool hasMore = false;
             if (r.hasField(QStringLiteral("has_more")) && r[QStringLiteral("has_more")].toInt())
@@ -196,6 +200,16 @@ public:
 
         MIVariable* variable = m_variable.data();
 
+        if (r.reason == QLatin1String("error")) {
+            // Keep hasMore and the "..." item, so that the page is requested
+            // again the next time the item scrolls into view.
+            if (m_activeCommands == 0) {
+                variable->childrenFetched();
+                delete this;
+            }
+            return;
+        }
+
         if (r.hasField(QStringLiteral("children")))
         {
             const Value& children = r[QStringLiteral("children")];
@@ -224,13 +238,13 @@ public:
 
         variable->setHasMore(hasMore);
         if (m_activeCommands == 0) {
-            variable->emitAllChildrenFetched();
+            variable->childrenFetched();
             delete this;
         }
     }
     bool handlesError() override {
-        // FIXME: handle error?
-        return false;
+        // An error just ends this page, see handle()
+        return true;
     }
     bool autoDelete() override {
         // we delete ourselve
@@ -245,10 +259,16 @@ private:
 
 void MIVariable::fetchMoreChildren()
 {
+    // The view asks for the next page whenever the "..." item is
+    // visible, so ignore the requests while one is still in flight.
+    if (m_fetchInProgress)
+        return;
+
     int c = childItems.size();
     // FIXME: should not even try this if app is not started.
     // Probably need to disable open, or something
     if (sessionIsAlive()) {
+        m_fetchInProgress = true;
         m_debugSession->addCommand(VarListChildren,
                                  QStringLiteral("--all-values \"%1\" %2 %3")
                                  //   fetch    from ..    to ..
@@ -257,12 +277,27 @@ void MIVariable::fetchMoreChildren()
     }
 }
 
+void MIVariable::childrenFetched()
+{
+    m_fetchInProgress = false;
+
+    // Without an update range, -var-update reports every child a pretty
+    // printer provides, including those the user never looked at.
+    if (m_dynamic && sessionIsAlive()) {
+        m_debugSession->addCommand(VarSetUpdateRange,
+                                   QStringLiteral("\"%1\" 0 %2").arg(m_varobj).arg(childItems.size()));
+    }
+
+    emitAllChildrenFetched();
+}
+
 void MIVariable::handleUpdate(const Value& var)
 {
     if (var.hasField(QStringLiteral("type_changed"))
         && var[QStringLiteral("type_changed")].literal() == QLatin1String("true"))
     {
         deleteChildren();
+        m_fetchInProgress = false;
         // FIXME: verify that this check is right.
         setHasMore(var[QStringLiteral("new_num_children")].toInt() != 0);
         fetchMoreChildren();
@@ -280,11 +315,7 @@ void MIVariable::handleUpdate(const Value& var)
             int nc = var[QStringLiteral("new_num_children")].toInt();
             Q_ASSERT(nc != -1);
             setHasMore(false);
-            while (childCount() > nc) {
-                TreeItem *c = child(childCount()-1);
-                removeChild(childCount()-1);
-                delete c;
-            }
+            deleteChildren(nc);
         }
 
         if (var.hasField(QStringLiteral("new_children")))
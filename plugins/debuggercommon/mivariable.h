@@ -78,15 +78,26 @@ protected: // Internal
 
     void setVarobj(const QString& v);
 
+    /**
+     * Called once a page of children requested by fetchMoreChildren() has
+     * arrived. Limits -var-update of dynamic varobjs to the fetched range.
+     */
+    void childrenFetched();
+
 protected:
     QPointer<MIDebugSession> m_debugSession;
 
 private:
     QString m_varobj;
+    // varobj children are provided by a pretty printer
+    bool m_dynamic = false;
+    // a -var-list-children page is in flight
+    bool m_fetchInProgress = false;
 
     // How many children should be fetched in one
-    // increment.
-    static const int s_fetchStep = 5;
+    // increment. The view requests the next page
+    // as soon as the "..." item becomes visible.
+    static const int s_fetchStep = 50;
 };
 } // end of KDevMI
 
@@ -0,0 +1,115 @@
+/* This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+ */
+
+#include "bench_miparser.h"
+
+// SUT
+#include <mi/miparser.h>
+// Qt
+#include <QFile>
+#include <QTest>
+
+using namespace KDevMI::MI;
+
+namespace {
+QList<QByteArray> readTranscript(const QString& fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+
+    QList<QByteArray> lines;
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        line.chop(1);
+        if (!line.isEmpty())
+            lines << line;
+    }
+    return lines;
+}
+
+// What the controllers typically look at: a few fields of each frame
+int touchFields(const Record& record)
+{
+    if (record.kind != Record::Result)
+        return 0;
+
+    const auto& result = static_cast<const ResultRecord&>(record);
+    if (!result.hasField(QStringLiteral("stack")))
+        return 0;
+
+    const Value& frames = result[QStringLiteral("stack")];
+    int lines = 0;
+    for (int i = 0; i < frames.size(); ++i) {
+        lines += frames[i][QStringLiteral("line")].toInt();
+    }
+    return lines;
+}
+}
+
+void BenchMIParser::benchParse_data()
+{
+    QTest::addColumn<QString>("transcript");
+    QTest::addColumn<int>("storage");
+    QTest::addColumn<bool>("touch");
+
+    const struct {
+        const char* name;
+        const char* file;
+    } transcripts[] = {
+        {"gdb", "transcripts/gdb-stepping.mi"},
+        {"lldb-mi", "transcripts/lldb-mi-stepping.mi"},
+    };
+
+    for (const auto& transcript : transcripts) {
+        const QString fileName = QFINDTESTDATA(transcript.file);
+        const QByteArray name(transcript.name);
+        QTest::newRow((name + "-owning").constData()) << fileName << int(MIParser::OwningValues) << false;
+        QTest::newRow((name + "-view").constData()) << fileName << int(MIParser::ViewValues) << false;
+        QTest::newRow((name + "-owning-access").constData()) << fileName << int(MIParser::OwningValues) << true;
+        QTest::newRow((name + "-view-access").constData()) << fileName << int(MIParser::ViewValues) << true;
+    }
+}
+
+void BenchMIParser::benchParse()
+{
+    QFETCH(QString, transcript);
+    QFETCH(int, storage);
+    QFETCH(bool, touch);
+
+    const auto lines = readTranscript(transcript);
+    QVERIFY(!lines.isEmpty());
+
+    MIParser parser;
+    parser.setValueStorage(static_cast<MIParser::ValueStorage>(storage));
+
+    int checksum = 0;
+    QBENCHMARK {
+        for (const auto& line : lines) {
+            FileSymbol file;
+            file.contents = line;
+            std::unique_ptr<Record> record(parser.parse(&file));
+            QVERIFY(record);
+            if (touch)
+                checksum += touchFields(*record);
+        }
+    }
+    Q_UNUSED(checksum);
+}
+
+QTEST_GUILESS_MAIN(BenchMIParser)
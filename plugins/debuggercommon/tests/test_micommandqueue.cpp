@@ -28,6 +28,7 @@
 #include <QSignalSpy>
 
 Q_DECLARE_METATYPE(KDevMI::MI::CommandFlags)
+Q_DECLARE_METATYPE(KDevMI::MI::CommandType)
 
 class TestDummyCommand : public QObject, public KDevMI::MI::MICommand
 {
@@ -142,6 +143,130 @@ void TestMICommandQueue::clearQueue()
     QCOMPARE(command2Spy.count(), 1);
 }
 
+void TestMICommandQueue::collapseDuplicateQueries()
+{
+    KDevMI::MI::CommandQueue commandQueue;
+
+    // prepare
+    int handled1 = 0;
+    int handled2 = 0;
+    auto* command1 = new TestDummyCommand(KDevMI::MI::StackListLocals, QStringLiteral("--simple-values"));
+    command1->setHandler([&handled1](const KDevMI::MI::ResultRecord&) { ++handled1; });
+    auto* command2 = new TestDummyCommand(KDevMI::MI::StackListLocals, QStringLiteral("--simple-values"));
+    command2->setHandler([&handled2](const KDevMI::MI::ResultRecord&) { ++handled2; });
+    auto* command3 = new TestDummyCommand(KDevMI::MI::StackListLocals, QStringLiteral("--all-values"));
+
+    QSignalSpy command2Spy(command2, &QObject::destroyed);
+
+    // execute
+    QVERIFY(commandQueue.enqueue(command1));
+    QVERIFY(!commandQueue.enqueue(command2));
+    QVERIFY(commandQueue.enqueue(command3));
+
+    // check
+    QCOMPARE(command2Spy.count(), 1);
+    QCOMPARE(commandQueue.count(), 2);
+
+    auto* nextCommand = commandQueue.nextCommand();
+    QCOMPARE(nextCommand, command1);
+    KDevMI::MI::ResultRecord result(QStringLiteral("done"));
+    QVERIFY(nextCommand->invokeHandler(result));
+    QCOMPARE(handled1, 1);
+    QCOMPARE(handled2, 1);
+    delete nextCommand;
+
+    QCOMPARE(commandQueue.nextCommand(), command3);
+    delete command3;
+}
+
+void TestMICommandQueue::noCollapseWithSideEffects_data()
+{
+    QTest::addColumn<KDevMI::MI::CommandType>("type");
+    QTest::addColumn<bool>("pipelinable");
+
+    // may call functions of the inferior
+    QTest::newRow("data-evaluate-expression")
+        << KDevMI::MI::DataEvaluateExpression << false;
+    // create the varobjs of the children
+    QTest::newRow("var-list-children")
+        << KDevMI::MI::VarListChildren << true;
+    // resets the changed state of the varobjs
+    QTest::newRow("var-update")
+        << KDevMI::MI::VarUpdate << true;
+}
+
+void TestMICommandQueue::noCollapseWithSideEffects()
+{
+    QFETCH(KDevMI::MI::CommandType, type);
+    QFETCH(bool, pipelinable);
+
+    KDevMI::MI::CommandQueue commandQueue;
+
+    // prepare
+    auto* command1 = new TestDummyCommand(type, QStringLiteral("var1"));
+    auto* command2 = new TestDummyCommand(type, QStringLiteral("var1"));
+
+    // execute
+    commandQueue.enqueue(command1);
+    commandQueue.enqueue(command2);
+
+    // check
+    QCOMPARE(commandQueue.count(), 2);
+    QCOMPARE(command1->isQuery(), false);
+    QCOMPARE(command1->isPipelinable(), pipelinable);
+}
+
+void TestMICommandQueue::noCollapseAcrossStateChange_data()
+{
+    QTest::addColumn<KDevMI::MI::CommandType>("type");
+    QTest::addColumn<KDevMI::MI::CommandFlags>("flags");
+    QTest::addColumn<bool>("pipelinable");
+
+    QTest::newRow("var-assign")
+        << KDevMI::MI::VarAssign << KDevMI::MI::CommandFlags() << false;
+    QTest::newRow("var-create")
+        << KDevMI::MI::VarCreate << KDevMI::MI::CommandFlags() << true;
+    QTest::newRow("var-set-format")
+        << KDevMI::MI::VarSetFormat << KDevMI::MI::CommandFlags() << true;
+    QTest::newRow("var-update")
+        << KDevMI::MI::VarUpdate << KDevMI::MI::CommandFlags() << true;
+    QTest::newRow("data-evaluate-expression")
+        << KDevMI::MI::DataEvaluateExpression << KDevMI::MI::CommandFlags() << false;
+}
+
+void TestMICommandQueue::noCollapseAcrossStateChange()
+{
+    QFETCH(KDevMI::MI::CommandType, type);
+    QFETCH(KDevMI::MI::CommandFlags, flags);
+    QFETCH(bool, pipelinable);
+
+    KDevMI::MI::CommandQueue commandQueue;
+
+    // prepare
+    auto* command1 = new TestDummyCommand(KDevMI::MI::StackListLocals, QStringLiteral("--simple-values"));
+    auto* command2 = new TestDummyCommand(type, QString(), flags);
+    auto* command3 = new TestDummyCommand(KDevMI::MI::StackListLocals, QStringLiteral("--simple-values"));
+
+    // execute
+    commandQueue.enqueue(command1);
+    commandQueue.enqueue(command2);
+    commandQueue.enqueue(command3);
+
+    // check
+    QCOMPARE(commandQueue.count(), 3);
+    QCOMPARE(command1->isPipelinable(), true);
+    QCOMPARE(command3->isPipelinable(), true);
+    QCOMPARE(command2->isPipelinable(), pipelinable);
+}
+
+void TestMICommandQueue::threadInfoIsNotPipelinable()
+{
+    // its handler selects the thread the following commands are sent for
+    TestDummyCommand command(KDevMI::MI::ThreadInfo);
+    QVERIFY(command.isQuery());
+    QVERIFY(!command.isPipelinable());
+}
+
 QTEST_GUILESS_MAIN(TestMICommandQueue)
 
 #include "test_micommandqueue.moc"
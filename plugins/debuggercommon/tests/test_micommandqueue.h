@@ -33,6 +33,12 @@ private Q_SLOTS:
     void addAndTake_data();
     void addAndTake();
     void clearQueue();
+    void collapseDuplicateQueries();
+    void noCollapseWithSideEffects_data();
+    void noCollapseWithSideEffects();
+    void noCollapseAcrossStateChange_data();
+    void noCollapseAcrossStateChange();
+    void threadInfoIsNotPipelinable();
 };
 
 #endif
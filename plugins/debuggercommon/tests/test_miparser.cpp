@@ -168,54 +168,89 @@ void TestMIParser::testParseLine()
     QFETCH(int, recordKind);
     QFETCH(QVariant, recordData);
 
-    KDevMI::MI::MIParser m_parser;
+    for (auto storage : {KDevMI::MI::MIParser::OwningValues, KDevMI::MI::MIParser::ViewValues}) {
+        KDevMI::MI::MIParser m_parser;
+        m_parser.setValueStorage(storage);
 
-    KDevMI::MI::FileSymbol file;
-    file.contents = line;
+        std::unique_ptr<KDevMI::MI::Record> record;
+        {
+            KDevMI::MI::FileSymbol file;
+            file.contents = line;
 
-    std::unique_ptr<KDevMI::MI::Record> record(m_parser.parse(&file));
-    QVERIFY(record != nullptr);
-    QCOMPARE((int)record->kind, recordKind);
-
-    switch(recordKind) {
-    case KDevMI::MI::Record::Result: {
-        const auto& resultRecord = static_cast<KDevMI::MI::ResultRecord&>(*record);
-        const auto resultData = recordData.value<ResultRecordData>();
-
-        QCOMPARE(resultRecord.token, resultData.token);
-        QCOMPARE(resultRecord.reason, resultData.reason);
-
-        for (const auto& result : resultData.results) {
-            QVERIFY(resultRecord.hasField(result.name));
-            doTestResult(resultRecord[result.name], result.value);
+            record = m_parser.parse(&file);
+            // views must not depend on the token stream of the line
         }
-        break;
-    }
-    case KDevMI::MI::Record::Async: {
-        const auto& asyncRecord = static_cast<KDevMI::MI::AsyncRecord&>(*record);
-        const auto asyncData = recordData.value<AsyncRecordData>();
-
-        QCOMPARE((int)asyncRecord.subkind, asyncData.subkind);
-        QCOMPARE(asyncRecord.reason, asyncData.reason);
+        QVERIFY(record != nullptr);
+        QCOMPARE((int)record->kind, recordKind);
+
+        switch(recordKind) {
+        case KDevMI::MI::Record::Result: {
+            const auto& resultRecord = static_cast<KDevMI::MI::ResultRecord&>(*record);
+            const auto resultData = recordData.value<ResultRecordData>();
+
+            QCOMPARE(resultRecord.token, resultData.token);
+            QCOMPARE(resultRecord.reason, resultData.reason);
+
+            for (const auto& result : resultData.results) {
+                QVERIFY(resultRecord.hasField(result.name));
+                doTestResult(resultRecord[result.name], result.value);
+            }
+            break;
+        }
+        case KDevMI::MI::Record::Async: {
+            const auto& asyncRecord = static_cast<KDevMI::MI::AsyncRecord&>(*record);
+            const auto asyncData = recordData.value<AsyncRecordData>();
+
+            QCOMPARE((int)asyncRecord.subkind, asyncData.subkind);
+            QCOMPARE(asyncRecord.reason, asyncData.reason);
+
+            for (const auto& result : asyncData.results) {
+                QVERIFY(asyncRecord.hasField(result.name));
+                doTestResult(asyncRecord[result.name], result.value);
+            }
+            break;
+        }
+        case KDevMI::MI::Record::Stream: {
+            const auto& streamRecord = static_cast<KDevMI::MI::StreamRecord&>(*record);
+            const auto streamData = recordData.value<StreamRecordData>();
 
-        for (const auto& result : asyncData.results) {
-            QVERIFY(asyncRecord.hasField(result.name));
-            doTestResult(asyncRecord[result.name], result.value);
+            QCOMPARE((int)streamRecord.subkind, streamData.subkind);
+            QCOMPARE(streamRecord.message, streamData.message);
+            break;
+        }
+        case KDevMI::MI::Record::Prompt:
+            break;
         }
-        break;
     }
-    case KDevMI::MI::Record::Stream: {
-        const auto& streamRecord = static_cast<KDevMI::MI::StreamRecord&>(*record);
-        const auto streamData = recordData.value<StreamRecordData>();
+}
 
-        QCOMPARE((int)streamRecord.subkind, streamData.subkind);
-        QCOMPARE(streamRecord.message, streamData.message);
-        break;
-    }
-    case KDevMI::MI::Record::Prompt:
-        break;
+void TestMIParser::testRepeatedFields()
+{
+    // lldb-mi reports all frames of a thread as separate "frame" fields
+    const QByteArray line("^done,threads=[{id=\"1\",frame={level=\"2\"},frame={level=\"0\"},frame={level=\"1\"}}]");
+
+    for (auto storage : {KDevMI::MI::MIParser::OwningValues, KDevMI::MI::MIParser::ViewValues}) {
+        KDevMI::MI::MIParser parser;
+        parser.setValueStorage(storage);
+
+        KDevMI::MI::FileSymbol file;
+        file.contents = line;
+
+        std::unique_ptr<KDevMI::MI::Record> record(parser.parse(&file));
+        QVERIFY(record != nullptr);
+        QCOMPARE((int)record->kind, (int)KDevMI::MI::Record::Result);
+
+        const auto& result = static_cast<KDevMI::MI::ResultRecord&>(*record);
+        const auto& thread = result[QStringLiteral("threads")][0];
+        const auto frames = thread.allFields(QStringLiteral("frame"));
+        QCOMPARE(frames.size(), 3);
+        QCOMPARE((*frames[0])[QStringLiteral("level")].toInt(), 2);
+        QCOMPARE((*frames[2])[QStringLiteral("level")].toInt(), 1);
+        // like a map, the last of repeated fields is found by name
+        QCOMPARE(thread[QStringLiteral("frame")][QStringLiteral("level")].toInt(), 1);
+        QCOMPARE(thread[QStringLiteral("id")].literal(), QStringLiteral("1"));
+        QVERIFY(!thread.hasField(QStringLiteral("fram")));
     }
-
 }
 
 QTEST_GUILESS_MAIN(TestMIParser)
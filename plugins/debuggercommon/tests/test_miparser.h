@@ -33,6 +33,7 @@ class TestMIParser : public QObject
 private Q_SLOTS:
     void testParseLine_data();
     void testParseLine();
+    void testRepeatedFields();
 
 private:
     void doTestResult(const KDevMI::MI::Value& actualValue, const QVariant& expectedValue);
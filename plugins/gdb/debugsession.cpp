@@ -64,6 +64,9 @@ DebugSession::DebugSession(CppDebuggerPlugin *plugin)
     m_variableController = new VariableController(this);
     m_frameStackModel = new GdbFrameStackModel(this);
 
+    // GDB answers MI commands strictly in order
+    setCommandPipelining(true);
+
     if (m_plugin) m_plugin->setupToolViews();
 }
 
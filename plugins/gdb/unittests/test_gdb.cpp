@@ -24,6 +24,7 @@
 #include "mi/micommand.h"
 #include "mi/milexer.h"
 #include "mi/miparser.h"
+#include "mivariable.h"
 #include "tests/debuggers-tests-config.h"
 #include "tests/testhelper.h"
 
@@ -1215,6 +1216,40 @@ void GdbTest::testVariablesWatches()
     WAIT_FOR_STATE(session, DebugSession::EndedState);
 }
 
+void GdbTest::testVariablesFetchChildrenError()
+{
+    auto *session = new TestDebugSession;
+    KDevelop::ICore::self()->debugController()->variableCollection()->variableWidgetShown();
+
+    TestLaunchConfiguration cfg;
+
+    breakpoints()->addCodeBreakpoint(QUrl::fromLocalFile(debugeeFileName), 39);
+    QVERIFY(session->startDebugging(&cfg, m_iface));
+    WAIT_FOR_STATE(session, DebugSession::PausedState);
+
+    variableCollection()->watches()->add(QStringLiteral("ts"));
+    QTest::qWait(300);
+
+    QModelIndex i = variableCollection()->index(0, 0);
+    QModelIndex ts = variableCollection()->index(0, 0, i);
+    auto* variable = dynamic_cast<KDevMI::MIVariable*>(variableCollection()->itemForIndex(ts));
+    QVERIFY(variable);
+    COMPARE_DATA(variableCollection()->index(0, 0, ts), "...");
+
+    // fetching the children of a varobj that GDB no longer knows fails
+    session->addCommand(MI::VarDelete, QStringLiteral("\"%1\"").arg(variable->varobj()));
+    variableCollection()->expanded(ts);
+    QTest::qWait(300);
+
+    // the "..." item stays, so the children can be requested again
+    QVERIFY(variable->hasMore());
+    QCOMPARE(variableCollection()->rowCount(ts), 1);
+    COMPARE_DATA(variableCollection()->index(0, 0, ts), "...");
+
+    session->run();
+    WAIT_FOR_STATE(session, DebugSession::EndedState);
+}
+
 void GdbTest::testVariablesWatchesQuotes()
 {
     auto *session = new TestDebugSession;
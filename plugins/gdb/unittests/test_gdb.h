@@ -68,6 +68,7 @@ private Q_SLOTS:
     void testVariablesLocals();
     void testVariablesLocalsStruct();
     void testVariablesWatches();
+    void testVariablesFetchChildrenError();
     void testVariablesWatchesQuotes();
     void testVariablesWatchesTwoSessions();
     void testVariablesStopDebugger();
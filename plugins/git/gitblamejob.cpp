@@ -0,0 +1,165 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "gitblamejob.h"
+
+#include "debug.h"
+
+#include <vcs/vcsrevision.h>
+
+#include <QDateTime>
+
+#include <algorithm>
+
+using namespace KDevelop;
+
+namespace {
+
+// git blame reports lines that are not committed yet with an all-zero hash
+bool isUncommitted(const QByteArray& hash)
+{
+    return std::all_of(hash.begin(), hash.end(), [](char c) { return c == '0'; });
+}
+
+}
+
+GitBlameJob::GitBlameJob(const QDir& workingDir, const QUrl& localLocation,
+                         GitCommitInfoCache* commitInfoCache, IPlugin* parent)
+    : GitJob(workingDir, parent, OutputJob::Silent)
+    , m_commitInfoCache(commitInfoCache)
+{
+    setType(VcsJob::Annotate);
+    *this << "git" << "blame" << "--incremental" << "-w";
+    *this << "--" << localLocation;
+
+    // the last line might come without a newline
+    connect(this, &DVcsJob::readyForParsing, this, [this] {
+        parseLines(true);
+    });
+}
+
+QVariant GitBlameJob::fetchResults()
+{
+    std::sort(m_pendingLines.begin(), m_pendingLines.end(),
+              [](const VcsAnnotationLine& a, const VcsAnnotationLine& b) {
+        return a.lineNumber() < b.lineNumber();
+    });
+
+    QVariantList results;
+    results.reserve(m_pendingLines.size());
+    for (const VcsAnnotationLine& line : qAsConst(m_pendingLines)) {
+        results += QVariant::fromValue(line);
+    }
+    m_pendingLines.clear();
+    return results;
+}
+
+void GitBlameJob::receivedStdout(const QByteArray& output)
+{
+    m_buffer += output;
+    parseLines(false);
+
+    if (!m_pendingLines.isEmpty()) {
+        emit resultsReady(this);
+    }
+}
+
+void GitBlameJob::parseLines(bool flush)
+{
+    int start = 0;
+    for (int end = m_buffer.indexOf('\n'); end != -1; end = m_buffer.indexOf('\n', start)) {
+        parseLine(m_buffer.mid(start, end - start));
+        start = end + 1;
+    }
+    m_buffer.remove(0, start);
+
+    if (flush && !m_buffer.isEmpty()) {
+        parseLine(m_buffer);
+        m_buffer.clear();
+    }
+}
+
+void GitBlameJob::parseLine(const QByteArray& line)
+{
+    if (line.isEmpty())
+        return;
+
+    if (m_hash.isEmpty()) {
+        // "<hash> <source line> <result line> <number of lines>"
+        const QList<QByteArray> values = line.split(' ');
+        if (values.size() < 4) {
+            qCWarning(PLUGIN_GIT) << "unexpected blame entry" << line;
+            return;
+        }
+        m_hash = values[0];
+        m_firstLine = values[2].toInt() - 1;
+        m_lineCount = values[3].toInt();
+
+        auto it = m_commits.constFind(m_hash);
+        m_commitKnown = (it != m_commits.constEnd());
+        if (m_commitKnown) {
+            m_commit = *it;
+        } else if (const VcsAnnotationLine* cached = isUncommitted(m_hash) ? nullptr : m_commitInfoCache->object(m_hash)) {
+            m_commit = *cached;
+            m_commitKnown = true;
+        } else {
+            m_commit = VcsAnnotationLine();
+            VcsRevision rev;
+            rev.setRevisionValue(QString::fromLatin1(m_hash.left(8)), VcsRevision::GlobalNumber);
+            m_commit.setRevision(rev);
+        }
+        return;
+    }
+
+    const int space = line.indexOf(' ');
+    const QByteArray name = line.left(space);
+    if (name == "filename") {
+        // ends the entry
+        if (!m_commits.contains(m_hash)) {
+            m_commits.insert(m_hash, m_commit);
+        }
+        // the info of uncommitted lines changes with every edit, so it is never cached
+        if (!m_commitKnown && !isUncommitted(m_hash)) {
+            m_commitInfoCache->insert(m_hash, new VcsAnnotationLine(m_commit));
+        }
+
+        for (int i = 0; i < m_lineCount; ++i) {
+            VcsAnnotationLine annotation = m_commit;
+            annotation.setLineNumber(m_firstLine + i);
+            m_pendingLines += annotation;
+        }
+        m_hash.clear();
+        return;
+    }
+
+    if (m_commitKnown || space < 0) {
+        return;
+    }
+
+    const QByteArray value = line.mid(space + 1);
+    if (name == "author") {
+        m_commit.setAuthor(QString::fromLocal8Bit(value));
+    } else if (name == "author-time") {
+        m_commit.setDate(QDateTime::fromSecsSinceEpoch(value.toUInt(), Qt::LocalTime));
+    } else if (name == "summary") {
+        m_commit.setCommitMessage(QString::fromLocal8Bit(value));
+    }
+    // the author e-mail and time zone, the committer, "previous" and
+    // "boundary" are not shown
+}
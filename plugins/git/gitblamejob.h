@@ -0,0 +1,72 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_PLUGIN_GITBLAMEJOB_H
+#define KDEVPLATFORM_PLUGIN_GITBLAMEJOB_H
+
+#include "gitjob.h"
+
+#include <vcs/vcsannotation.h>
+
+#include <QCache>
+#include <QHash>
+#include <QVector>
+
+/// Commit metadata by full hash, shared by all annotations of a plugin
+using GitCommitInfoCache = QCache<QByteArray, KDevelop::VcsAnnotationLine>;
+
+/**
+ * Runs "git blame --incremental" and parses its output while it arrives.
+ *
+ * Git reports ranges of lines as soon as it has attributed them, so
+ * resultsReady is emitted many times. Each fetchResults call returns the
+ * lines annotated since the previous call, ordered by line number.
+ */
+class GitBlameJob : public GitJob
+{
+    Q_OBJECT
+public:
+    GitBlameJob(const QDir& workingDir, const QUrl& localLocation,
+                GitCommitInfoCache* commitInfoCache, KDevelop::IPlugin* parent);
+
+    QVariant fetchResults() override;
+
+protected:
+    void receivedStdout(const QByteArray& output) override;
+
+private:
+    void parseLines(bool flush);
+    void parseLine(const QByteArray& line);
+
+    GitCommitInfoCache* m_commitInfoCache;
+    QByteArray m_buffer;
+    QVector<KDevelop::VcsAnnotationLine> m_pendingLines;
+
+    // commits of this blame, shared by all their lines
+    QHash<QByteArray, KDevelop::VcsAnnotationLine> m_commits;
+
+    // the entry being parsed
+    QByteArray m_hash;
+    KDevelop::VcsAnnotationLine m_commit;
+    bool m_commitKnown = false;
+    int m_firstLine = -1;
+    int m_lineCount = 0;
+};
+
+#endif // KDEVPLATFORM_PLUGIN_GITBLAMEJOB_H
@@ -0,0 +1,295 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "gitcatfilepool.h"
+
+#include "debug.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QProcess>
+#include <QTimer>
+
+#include <limits>
+
+namespace
+{
+
+/// Repositories which keep a git process at the same time
+const int MAX_PROCESSES = 4;
+
+/// Time after which an unused git process is stopped, in ms
+const int IDLE_TIMEOUT = 30000;
+
+/// Time queryNow waits for an answer, in ms
+const int QUERY_TIMEOUT = 5000;
+
+/// Every repository knows the empty tree of its object format, even when it does not store it
+const QByteArray EMPTY_TREE_SHA1 = QByteArrayLiteral("4b825dc642cb6eb9a060e54bf8d69288fbee4904");
+const QByteArray EMPTY_TREE_SHA256 = QByteArrayLiteral("6ef19b41225c5369f1c104d45d8d85efa9b057b53b14b4b9b939dd74decc5321");
+
+GitObjectInfo parseAnswer(const QByteArray& line)
+{
+    GitObjectInfo info;
+    // "<object> missing" or "<object> ambiguous", the object name may contain spaces
+    if (line.endsWith(" missing") || line.endsWith(" ambiguous")) {
+        return info;
+    }
+
+    // "<id> <type> <size>"
+    const QList<QByteArray> parts = line.split(' ');
+    if (parts.size() != 3) {
+        qCWarning(PLUGIN_GIT) << "unexpected answer of git cat-file:" << line;
+        return info;
+    }
+    info.id = parts.at(0);
+    info.type = parts.at(1);
+    info.size = parts.at(2).toLongLong();
+    return info;
+}
+
+QByteArray hashBlob(const QByteArray& objectFormat, const QByteArray& content)
+{
+    QCryptographicHash::Algorithm algorithm;
+    if (objectFormat == "sha1") {
+        algorithm = QCryptographicHash::Sha1;
+    } else if (objectFormat == "sha256") {
+        algorithm = QCryptographicHash::Sha256;
+    } else {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(algorithm);
+    hash.addData("blob " + QByteArray::number(content.size()) + '\0');
+    hash.addData(content);
+    return hash.result().toHex();
+}
+
+}
+
+GitCatFilePool::GitCatFilePool(QObject* parent)
+    : QObject(parent)
+{
+}
+
+GitCatFilePool::~GitCatFilePool()
+{
+    // the processes and timers are children, they go away with us
+    qDeleteAll(m_processes);
+}
+
+void GitCatFilePool::query(const QDir& repository, const QByteArray& object, QObject* context,
+                           const Callback& callback)
+{
+    // git reads one name per line
+    if (object.isEmpty() || object.contains('\n')) {
+        callback(GitObjectInfo());
+        return;
+    }
+
+    BatchProcess* batch = processFor(repository.absolutePath());
+    batch->idleTimer->stop();
+
+    QVector<Waiter>& waiters = batch->waiters[object];
+    waiters.append({context, callback});
+    if (waiters.size() == 1) {
+        batch->inFlight.enqueue(object);
+        batch->process->write(object + '\n');
+    }
+}
+
+GitObjectInfo GitCatFilePool::queryNow(const QDir& repository, const QByteArray& object)
+{
+    // guards the callback, which captures locals, once we returned
+    QObject context;
+    GitObjectInfo result;
+    bool done = false;
+    query(repository, object, &context, [&result, &done](const GitObjectInfo& info) {
+        result = info;
+        done = true;
+    });
+
+    const QString path = repository.absolutePath();
+    while (!done) {
+        BatchProcess* batch = m_processes.value(path);
+        if (!batch) {
+            break;
+        }
+        // answers are read and dispatched from within, failures stop the process
+        if (!batch->process->waitForReadyRead(QUERY_TIMEOUT) && !done) {
+            qCWarning(PLUGIN_GIT) << "no answer from git cat-file for" << object << "in" << path;
+            stopProcess(path);
+            break;
+        }
+    }
+    return result;
+}
+
+void GitCatFilePool::blobId(const QDir& repository, const QByteArray& content, QObject* context,
+                            const IdCallback& callback)
+{
+    const QString path = repository.absolutePath();
+    const auto it = m_objectFormats.constFind(path);
+    if (it != m_objectFormats.constEnd()) {
+        callback(hashBlob(*it, content));
+        return;
+    }
+
+    // ask the running cat-file instead of starting `git config`, the
+    // repository resolves only the empty tree id of its own format
+    query(repository, EMPTY_TREE_SHA1, context, [=](const GitObjectInfo& sha1Tree) {
+        if (sha1Tree.isValid()) {
+            m_objectFormats.insert(path, QByteArrayLiteral("sha1"));
+            callback(hashBlob(QByteArrayLiteral("sha1"), content));
+            return;
+        }
+        query(repository, EMPTY_TREE_SHA256, context, [=](const GitObjectInfo& sha256Tree) {
+            if (sha256Tree.isValid()) {
+                m_objectFormats.insert(path, QByteArrayLiteral("sha256"));
+                callback(hashBlob(QByteArrayLiteral("sha256"), content));
+                return;
+            }
+            // an unknown format, or git could not be run, which may change
+            callback(QByteArray());
+        });
+    });
+}
+
+GitCatFilePool::BatchProcess* GitCatFilePool::processFor(const QString& repository)
+{
+    if (BatchProcess* batch = m_processes.value(repository)) {
+        batch->lastUse = ++m_useCounter;
+        return batch;
+    }
+
+    if (m_processes.size() >= MAX_PROCESSES) {
+        QString leastRecentlyUsed;
+        quint64 lastUse = std::numeric_limits<quint64>::max();
+        for (auto it = m_processes.constBegin(); it != m_processes.constEnd(); ++it) {
+            if (it.value()->inFlight.isEmpty() && it.value()->lastUse < lastUse) {
+                leastRecentlyUsed = it.key();
+                lastUse = it.value()->lastUse;
+            }
+        }
+        if (!leastRecentlyUsed.isEmpty()) {
+            stopProcess(leastRecentlyUsed);
+        }
+    }
+
+    auto* batch = new BatchProcess;
+    batch->lastUse = ++m_useCounter;
+
+    batch->process = new QProcess(this);
+    batch->process->setWorkingDirectory(repository);
+    QProcess* process = batch->process;
+    // a later process for the same repository must not be stopped by the signals of this one
+    auto stopIfCurrent = [this, repository, process]() {
+        BatchProcess* current = m_processes.value(repository);
+        if (current && current->process == process) {
+            stopProcess(repository);
+        }
+    };
+    connect(process, &QProcess::readyReadStandardOutput, this, [this, repository]() {
+        readAnswers(repository);
+    });
+    connect(process, &QProcess::errorOccurred, this, stopIfCurrent);
+    connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, stopIfCurrent);
+
+    batch->idleTimer = new QTimer(this);
+    batch->idleTimer->setSingleShot(true);
+    batch->idleTimer->setInterval(IDLE_TIMEOUT);
+    connect(batch->idleTimer, &QTimer::timeout, this, [this, repository]() {
+        stopProcess(repository);
+    });
+
+    m_processes.insert(repository, batch);
+    // writes are buffered until git is running
+    process->start(QStringLiteral("git"), {QStringLiteral("cat-file"), QStringLiteral("--batch-check")});
+    return batch;
+}
+
+void GitCatFilePool::readAnswers(const QString& repository)
+{
+    BatchProcess* batch = m_processes.value(repository);
+    if (!batch) {
+        return;
+    }
+
+    batch->buffer += batch->process->readAllStandardOutput();
+
+    QVector<QPair<QVector<Waiter>, GitObjectInfo>> answered;
+    int start = 0;
+    int end;
+    while ((end = batch->buffer.indexOf('\n', start)) != -1) {
+        const QByteArray line = batch->buffer.mid(start, end - start);
+        start = end + 1;
+        if (batch->inFlight.isEmpty()) {
+            qCWarning(PLUGIN_GIT) << "unexpected output of git cat-file:" << line;
+            continue;
+        }
+        const QByteArray object = batch->inFlight.dequeue();
+        answered.append({batch->waiters.take(object), parseAnswer(line)});
+    }
+    batch->buffer.remove(0, start);
+
+    if (batch->inFlight.isEmpty()) {
+        batch->idleTimer->start();
+    }
+
+    // callbacks may query again, so the state is updated before
+    for (const auto& answer : qAsConst(answered)) {
+        for (const Waiter& waiter : answer.first) {
+            if (waiter.context) {
+                waiter.callback(answer.second);
+            }
+        }
+    }
+}
+
+void GitCatFilePool::stopProcess(const QString& repository)
+{
+    BatchProcess* batch = m_processes.take(repository);
+    if (!batch) {
+        return;
+    }
+
+    batch->process->disconnect(this);
+    if (batch->process->state() != QProcess::NotRunning) {
+        // git exits once its input is closed
+        connect(batch->process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                batch->process, &QObject::deleteLater);
+        batch->process->closeWriteChannel();
+    } else {
+        batch->process->deleteLater();
+    }
+    // we may be called from its timeout
+    batch->idleTimer->deleteLater();
+
+    const auto waiters = batch->waiters;
+    delete batch;
+
+    // nobody will answer anymore
+    for (const QVector<Waiter>& objectWaiters : waiters) {
+        for (const Waiter& waiter : objectWaiters) {
+            if (waiter.context) {
+                waiter.callback(GitObjectInfo());
+            }
+        }
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_PLUGIN_GITCATFILEPOOL_H
+#define KDEVPLATFORM_PLUGIN_GITCATFILEPOOL_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QVector>
+
+#include <functional>
+
+class QDir;
+class QProcess;
+class QTimer;
+
+/**
+ * What git knows about an object name, as reported by `git cat-file --batch-check`.
+ */
+struct GitObjectInfo
+{
+    /// Full object id, empty if the name does not resolve to an object
+    QByteArray id;
+    /// "blob", "tree", "commit" or "tag"
+    QByteArray type;
+    qint64 size = -1;
+
+    bool isValid() const { return !id.isEmpty(); }
+};
+
+/**
+ * Answers read-only object queries through long-lived `git cat-file --batch-check`
+ * processes, one per repository, instead of starting a git process per query.
+ *
+ * Queries may be object ids or any revision expression git understands,
+ * e.g. "refs/stash" or "HEAD:path/to/file". Identical queries that are
+ * in flight at the same time are sent to git only once.
+ *
+ * Processes are stopped after being idle for a while, and only a few
+ * repositories keep one at the same time.
+ */
+class GitCatFilePool : public QObject
+{
+    Q_OBJECT
+public:
+    using Callback = std::function<void(const GitObjectInfo&)>;
+    using IdCallback = std::function<void(const QByteArray&)>;
+
+    explicit GitCatFilePool(QObject* parent = nullptr);
+    ~GitCatFilePool() override;
+
+    /**
+     * Looks up @p object in @p repository and calls @p callback with the answer,
+     * unless @p context was destroyed meanwhile.
+     *
+     * If git cannot be run, the callback gets an invalid info.
+     */
+    void query(const QDir& repository, const QByteArray& object, QObject* context, const Callback& callback);
+
+    /// Like @c query, but blocks until the answer arrives
+    GitObjectInfo queryNow(const QDir& repository, const QByteArray& object);
+
+    /**
+     * Computes the id git gives a blob with @p content in @p repository, like
+     * `git hash-object --stdin`, which does not apply any filters, and calls
+     * @p callback with it, unless @p context was destroyed meanwhile.
+     *
+     * The id is empty if the object format of the repository is not known here.
+     */
+    void blobId(const QDir& repository, const QByteArray& content, QObject* context, const IdCallback& callback);
+
+    /// Number of running git processes
+    int processCount() const { return m_processes.size(); }
+
+private:
+    struct Waiter
+    {
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    struct BatchProcess
+    {
+        QProcess* process = nullptr;
+        QTimer* idleTimer = nullptr;
+        /// Queries written to git, in the order of the answers
+        QQueue<QByteArray> inFlight;
+        QHash<QByteArray, QVector<Waiter>> waiters;
+        QByteArray buffer;
+        /// For evicting the least recently used process
+        quint64 lastUse = 0;
+    };
+
+    BatchProcess* processFor(const QString& repository);
+    void readAnswers(const QString& repository);
+    void stopProcess(const QString& repository);
+
+    QHash<QString, BatchProcess*> m_processes;
+    /// Object formats of the repositories, fixed when they are created
+    QHash<QString, QByteArray> m_objectFormats;
+    quint64 m_useCounter = 0;
+};
+
+#endif // KDEVPLATFORM_PLUGIN_GITCATFILEPOOL_H
@@ -56,6 +56,8 @@
 #include <KTextEditor/Document>
 
 #include "gitjob.h"
+#include "gitblamejob.h"
+#include "gitcatfilepool.h"
 #include "gitmessagehighlighter.h"
 #include "gitplugincheckinrepositoryjob.h"
 #include "gitnameemaildialog.h"
@@ -78,6 +80,9 @@ QVariant runSynchronously(KDevelop::VcsJob* job)
 namespace
 {
 
+/// Number of commits whose metadata is kept for annotations
+const int COMMIT_INFO_CACHE_SIZE = 10000;
+
 QDir dotGitDirectory(const QUrl& dirPath)
 {
     const QFileInfo finfo(dirPath.toLocalFile());
@@ -181,6 +186,8 @@ QDir urlDir(const QList<QUrl>& urls) { return urlDir(urls.first()); } //TODO: co
 
 GitPlugin::GitPlugin( QObject *parent, const QVariantList & )
     : DistributedVersionControlPlugin(parent, QStringLiteral("kdevgit")), m_oldVersion(false), m_usePrefix(true)
+    , m_catFilePool(new GitCatFilePool(this))
+    , m_commitInfoCache(new GitCommitInfoCache(COMMIT_INFO_CACHE_SIZE))
 {
     if (QStandardPaths::findExecutable(QStringLiteral("git")).isEmpty()) {
         setErrorDescription(i18n("Unable to find git executable. Is it installed on the system?"));
@@ -211,9 +218,13 @@ bool emptyOutput(DVcsJob* job)
     return false;
 }
 
-bool GitPlugin::hasStashes(const QDir& repository)
+void GitPlugin::hasStashes(const QDir& repository, QObject* context, const std::function<void(bool)>& callback)
 {
-    return !emptyOutput(gitStash(repository, QStringList(QStringLiteral("list")), KDevelop::OutputJob::Silent));
+    // the stash list is non-empty exactly when the stash ref exists
+    const QDir root = dotGitDirectory(QUrl::fromLocalFile(repository.absolutePath()));
+    m_catFilePool->query(root, QByteArrayLiteral("refs/stash"), context, [callback](const GitObjectInfo& info) {
+        callback(info.isValid());
+    });
 }
 
 bool GitPlugin::hasModifications(const QDir& d)
@@ -231,13 +242,20 @@ void GitPlugin::additionalMenuEntries(QMenu* menu, const QList<QUrl>& urls)
     m_urls = urls;
 
     QDir dir=urlDir(urls);
-    bool hasSt = hasStashes(dir);
 
     menu->addAction(i18nc("@action:inmenu", "Rebase"), this, SLOT(ctxRebase()));
     menu->addSeparator()->setText(i18nc("@title:menu", "Git Stashes"));
-    menu->addAction(i18nc("@action:inmenu", "Stash Manager"), this, SLOT(ctxStashManager()))->setEnabled(hasSt);
+    QAction* stashManager = menu->addAction(i18nc("@action:inmenu", "Stash Manager"), this, SLOT(ctxStashManager()));
     menu->addAction(i18nc("@action:inmenu", "Push Stash"), this, SLOT(ctxPushStash()));
-    menu->addAction(i18nc("@action:inmenu", "Pop Stash"), this, SLOT(ctxPopStash()))->setEnabled(hasSt);
+    QAction* popStash = menu->addAction(i18nc("@action:inmenu", "Pop Stash"), this, SLOT(ctxPopStash()));
+
+    // enabled once git answered, the menu must not wait for it
+    stashManager->setEnabled(false);
+    popStash->setEnabled(false);
+    hasStashes(dir, menu, [stashManager, popStash](bool hasSt) {
+        stashManager->setEnabled(hasSt);
+        popStash->setEnabled(hasSt);
+    });
 }
 
 void GitPlugin::ctxRebase()
@@ -632,73 +650,41 @@ VcsJob* GitPlugin::log(const QUrl& localLocation, const KDevelop::VcsRevision& r
     return job;
 }
 
-KDevelop::VcsJob* GitPlugin::annotate(const QUrl &localLocation, const KDevelop::VcsRevision&)
+VcsJob* GitPlugin::logPage(const QUrl& localLocation, const KDevelop::VcsRevision& rev,
+                           unsigned long skip, unsigned long limit)
 {
     DVcsJob* job = new GitJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
-    job->setType(VcsJob::Annotate);
-    *job << "git" << "blame" << "--porcelain" << "-w";
+    job->setType(VcsJob::Log);
+    // without --name-status git only has to read the commits, not to diff their trees
+    *job << "git" << "log" << "--date=raw" << "--follow";
+    QString revStr = toRevisionName(rev, QString());
+    if(!revStr.isEmpty())
+        *job << revStr;
+    if (skip > 0)
+        *job << QStringLiteral("--skip=%1").arg(skip);
+    if(limit>0)
+        *job << QStringLiteral("-%1").arg(limit);
+
     *job << "--" << localLocation;
-    connect(job, &DVcsJob::readyForParsing, this, &GitPlugin::parseGitBlameOutput);
+    connect(job, &DVcsJob::readyForParsing, this, &GitPlugin::parseGitLogOutput);
     return job;
 }
 
-void GitPlugin::parseGitBlameOutput(DVcsJob *job)
+VcsJob* GitPlugin::logItems(const QUrl& localLocation, const KDevelop::VcsRevision& rev)
 {
-    QVariantList results;
-    VcsAnnotationLine* annotation = nullptr;
-    const auto output = job->output();
-    const auto lines = output.splitRef(QLatin1Char('\n'));
-
-    bool skipNext=false;
-    QMap<QString, VcsAnnotationLine> definedRevisions;
-    for (auto& line : lines) {
-        if(skipNext) {
-            skipNext=false;
-            results += QVariant::fromValue(*annotation);
-
-            continue;
-        }
-
-        if (line.isEmpty())
-            continue;
-
-        QStringRef name = line.left(line.indexOf(QLatin1Char(' ')));
-        QStringRef value = line.mid(name.size()+1);
-
-        if(name==QLatin1String("author"))
-            annotation->setAuthor(value.toString());
-        else if(name==QLatin1String("author-mail")) {} //TODO: do smth with the e-mail?
-        else if(name==QLatin1String("author-tz")) {} //TODO: does it really matter?
-        else if(name==QLatin1String("author-time"))
-            annotation->setDate(QDateTime::fromSecsSinceEpoch(value.toUInt(), Qt::LocalTime));
-        else if(name==QLatin1String("summary"))
-            annotation->setCommitMessage(value.toString());
-        else if(name.startsWith(QLatin1String("committer"))) {} //We will just store the authors
-        else if(name==QLatin1String("previous")) {} //We don't need that either
-        else if(name==QLatin1String("filename")) { skipNext=true; }
-        else if(name==QLatin1String("boundary")) {
-            definedRevisions.insert(QStringLiteral("boundary"), VcsAnnotationLine());
-        }
-        else
-        {
-            const auto values = value.split(QLatin1Char(' '));
-
-            VcsRevision rev;
-            rev.setRevisionValue(name.left(8).toString(), KDevelop::VcsRevision::GlobalNumber);
-
-            skipNext = definedRevisions.contains(name.toString());
-
-            if(!skipNext)
-                definedRevisions.insert(name.toString(), VcsAnnotationLine());
-
-            annotation = &definedRevisions[name.toString()];
-            annotation->setLineNumber(values[1].toInt() - 1);
-            annotation->setRevision(rev);
-        }
-    }
-    job->setResults(results);
+    DVcsJob* job = new GitJob(dotGitDirectory(localLocation), this, KDevelop::OutputJob::Silent);
+    job->setType(VcsJob::Log);
+    // all files of the commit: with --follow the location may have had another name back then
+    *job << "git" << "diff-tree" << "-r" << "--root" << "--no-commit-id" << "--name-status" << "-M80%"
+         << rev.revisionValue().toString();
+    connect(job, &DVcsJob::readyForParsing, this, &GitPlugin::parseGitLogItemsOutput);
+    return job;
 }
 
+KDevelop::VcsJob* GitPlugin::annotate(const QUrl &localLocation, const KDevelop::VcsRevision&)
+{
+    return new GitBlameJob(dotGitDirectory(localLocation), localLocation, m_commitInfoCache.data(), this);
+}
 
 DVcsJob* GitPlugin::lsFiles(const QDir &repository, const QStringList &args,
                             OutputJob::OutputJobVerbosity verbosity)
@@ -1120,14 +1106,30 @@ VcsItemEvent::Actions actionsFromString(char c)
     return VcsItemEvent::Modified;
 }
 
-void GitPlugin::parseGitLogOutput(DVcsJob * job)
+static bool parseModification(const QString& line, VcsItemEvent* itemEvent)
 {
-    static QRegExp commitRegex(QStringLiteral("^commit (\\w{8})\\w{32}"));
-    static QRegExp infoRegex(QStringLiteral("^(\\w+):(.*)"));
     static QRegExp modificationsRegex(QStringLiteral("^([A-Z])[0-9]*\t([^\t]+)\t?(.*)"), Qt::CaseSensitive, QRegExp::RegExp2);
     //R099    plugins/git/kdevgit.desktop     plugins/git/kdevgit.desktop.cmake
     //M       plugins/grepview/CMakeLists.txt
 
+    if (!modificationsRegex.exactMatch(line)) {
+        return false;
+    }
+
+    VcsItemEvent::Actions a = actionsFromString(modificationsRegex.cap(1).at(0).toLatin1());
+    itemEvent->setActions(a);
+    itemEvent->setRepositoryLocation(modificationsRegex.cap(2));
+    if(a==VcsItemEvent::Replaced) {
+        itemEvent->setRepositoryCopySourceLocation(modificationsRegex.cap(3));
+    }
+    return true;
+}
+
+void GitPlugin::parseGitLogOutput(DVcsJob * job)
+{
+    static QRegExp commitRegex(QStringLiteral("^commit (\\w{8})\\w{32}"));
+    static QRegExp infoRegex(QStringLiteral("^(\\w+):(.*)"));
+
     QList<QVariant> commits;
 
     QString contents = job->output();
@@ -1141,6 +1143,7 @@ void GitPlugin::parseGitLogOutput(DVcsJob * job)
     QTextStream s(&contents);
 
     VcsEvent item;
+    VcsItemEvent itemEvent;
     QString message;
     bool pushCommit = false;
 
@@ -1166,19 +1169,9 @@ void GitPlugin::parseGitLogOutput(DVcsJob * job)
             } else if (cap1 == QLatin1String("Date")) {
                 item.setDate(QDateTime::fromSecsSinceEpoch(infoRegex.cap(2).trimmed().split(QLatin1Char(' '))[0].toUInt(), Qt::LocalTime));
             }
-        } else if (modificationsRegex.exactMatch(line)) {
-            VcsItemEvent::Actions a = actionsFromString(modificationsRegex.cap(1).at(0).toLatin1());
-            QString filenameA = modificationsRegex.cap(2);
-
-            VcsItemEvent itemEvent;
-            itemEvent.setActions(a);
-            itemEvent.setRepositoryLocation(filenameA);
-            if(a==VcsItemEvent::Replaced) {
-                QString filenameB = modificationsRegex.cap(3);
-                itemEvent.setRepositoryCopySourceLocation(filenameB);
-            }
-
+        } else if (parseModification(line, &itemEvent)) {
             item.addItem(itemEvent);
+            itemEvent = VcsItemEvent();
         } else if (line.startsWith(QLatin1String("    "))) {
             message += line.midRef(4) + QLatin1Char('\n');
         }
@@ -1189,6 +1182,27 @@ void GitPlugin::parseGitLogOutput(DVcsJob * job)
     job->setResults(commits);
 }
 
+void GitPlugin::parseGitLogItemsOutput(DVcsJob* job)
+{
+    QList<QVariant> items;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    const QStringList lines = job->output().split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+#else
+    const QStringList lines = job->output().split(QLatin1Char('\n'), QString::SkipEmptyParts);
+#endif
+    items.reserve(lines.size());
+    VcsItemEvent itemEvent;
+    for (const QString& line : lines) {
+        if (parseModification(line, &itemEvent)) {
+            items.append(QVariant::fromValue(itemEvent));
+            itemEvent = VcsItemEvent();
+        }
+    }
+
+    job->setResults(items);
+}
+
 void GitPlugin::parseGitDiffOutput(DVcsJob* job)
 {
     VcsDiff diff;
@@ -1581,7 +1595,8 @@ void GitPlugin::delayedBranchChanged()
 
 CheckInRepositoryJob* GitPlugin::isInRepository(KTextEditor::Document* document)
 {
-    CheckInRepositoryJob* job = new GitPluginCheckInRepositoryJob(document, repositoryRoot(document->url()).path());
+    CheckInRepositoryJob* job = new GitPluginCheckInRepositoryJob(document, repositoryRoot(document->url()).path(),
+                                                                  m_catFilePool);
     job->start();
     return job;
 }
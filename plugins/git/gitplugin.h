@@ -24,16 +24,24 @@
 
 #include <vcs/interfaces/idistributedversioncontrol.h>
 #include <vcs/interfaces/icontentawareversioncontrol.h>
+#include <vcs/interfaces/ipagedhistoryversioncontrol.h>
 #include <vcs/dvcs/dvcsplugin.h>
 #include <vcs/vcsstatusinfo.h>
 #include <outputview/outputjob.h>
 #include <vcs/vcsjob.h>
 
+#include <QCache>
+#include <QScopedPointer>
+
+#include <functional>
+
 class KDirWatch;
 class QDir;
+class GitCatFilePool;
 
 namespace KDevelop
 {
+    class VcsAnnotationLine;
     class VcsJob;
     class VcsRevision;
 }
@@ -64,10 +72,12 @@ class StandardJob : public KDevelop::VcsJob
  * It implements the DVCS dependent things not implemented in KDevelop::DistributedVersionControlPlugin
  * @author Evgeniy Ivanov <powerfox@kde.ru>
  */
-class GitPlugin: public KDevelop::DistributedVersionControlPlugin, public KDevelop::IContentAwareVersionControl
+class GitPlugin: public KDevelop::DistributedVersionControlPlugin, public KDevelop::IContentAwareVersionControl,
+                 public KDevelop::IPagedHistoryVersionControl
 {
     Q_OBJECT
-    Q_INTERFACES(KDevelop::IBasicVersionControl KDevelop::IDistributedVersionControl KDevelop::IContentAwareVersionControl)
+    Q_INTERFACES(KDevelop::IBasicVersionControl KDevelop::IDistributedVersionControl KDevelop::IContentAwareVersionControl
+                 KDevelop::IPagedHistoryVersionControl)
     friend class GitInitTest;
 public:
     explicit GitPlugin(QObject *parent, const QVariantList & args = QVariantList() );
@@ -111,6 +121,11 @@ public:
     KDevelop::VcsJob* annotate(const QUrl &localLocation, const KDevelop::VcsRevision &rev) override;
     KDevelop::VcsJob* revert(const QList<QUrl>& localLocations, RecursionMode recursion) override;
 
+    // Begin:  KDevelop::IPagedHistoryVersionControl
+    KDevelop::VcsJob* logPage(const QUrl& localLocation, const KDevelop::VcsRevision& rev,
+                              unsigned long skip, unsigned long limit) override;
+    KDevelop::VcsJob* logItems(const QUrl& localLocation, const KDevelop::VcsRevision& rev) override;
+
     // Begin:  KDevelop::IDistributedVersionControl
     KDevelop::VcsJob* init(const QUrl & directory) override;
 
@@ -136,7 +151,8 @@ public:
     
     KDevelop::DVcsJob* gitStash(const QDir& repository, const QStringList& args, KDevelop::OutputJob::OutputJobVerbosity verbosity);
     
-    bool hasStashes(const QDir& repository);
+    /// Calls @p callback with whether @p repository has stashes, unless @p context was destroyed meanwhile
+    void hasStashes(const QDir& repository, QObject* context, const std::function<void(bool)>& callback);
     bool hasModifications(const QDir& repository);
     bool hasModifications(const QDir& repo, const QUrl& file);
 
@@ -175,8 +191,8 @@ protected:
                          KDevelop::OutputJob::OutputJobVerbosity verbosity = KDevelop::OutputJob::Silent);
 
 private Q_SLOTS:
-    void parseGitBlameOutput(KDevelop::DVcsJob *job);
     void parseGitLogOutput(KDevelop::DVcsJob *job);
+    void parseGitLogItemsOutput(KDevelop::DVcsJob *job);
     void parseGitDiffOutput(KDevelop::DVcsJob* job);
     void parseGitRepoLocationOutput(KDevelop::DVcsJob* job);
     void parseGitStatusOutput(KDevelop::DVcsJob* job);
@@ -218,6 +234,12 @@ private:
     KDirWatch* m_watcher;
     QList<QUrl> m_branchesChange;
     bool m_usePrefix;
+
+    /// Answers read-only object queries without starting a git process each
+    GitCatFilePool* m_catFilePool;
+
+    /// Commit metadata of annotations, kept for re-annotating files
+    const QScopedPointer<QCache<QByteArray, KDevelop::VcsAnnotationLine>> m_commitInfoCache;
 };
 
 QVariant runSynchronously(KDevelop::VcsJob* job);
@@ -19,18 +19,20 @@
  ***************************************************************************/
 
 #include "gitplugincheckinrepositoryjob.h"
+#include "gitcatfilepool.h"
 #include "debug.h"
 
 #include <KTextEditor/Document>
 
+#include <QProcess>
 #include <QTextCodec>
 #include <QDir>
 
 GitPluginCheckInRepositoryJob::GitPluginCheckInRepositoryJob(KTextEditor::Document* document,
-                                                             const QString& rootDirectory)
+                                                             const QString& rootDirectory,
+                                                             GitCatFilePool* catFilePool)
     : CheckInRepositoryJob(document)
-    , m_hashjob(nullptr)
-    , m_findjob(nullptr)
+    , m_catFilePool(catFilePool)
     , m_rootDirectory(rootDirectory)
 {}
 
@@ -44,50 +46,53 @@ void GitPluginCheckInRepositoryJob::start()
         return;
     }
 
-    m_findjob = new QProcess(this);
-    m_findjob->setWorkingDirectory(m_rootDirectory);
-
-    m_hashjob = new QProcess(this);
-    m_hashjob->setWorkingDirectory(m_rootDirectory);
-    m_hashjob->setStandardOutputProcess(m_findjob);
-
-    connect(m_findjob, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &GitPluginCheckInRepositoryJob::repositoryQueryFinished);
-    connect(m_hashjob, &QProcess::errorOccurred, this, &GitPluginCheckInRepositoryJob::processFailed);
-    connect(m_findjob, &QProcess::errorOccurred, this, &GitPluginCheckInRepositoryJob::processFailed);
-
-    m_hashjob->start(QStringLiteral("git"), QStringList{QStringLiteral("hash-object"), QStringLiteral("--stdin")});
-    m_findjob->start(QStringLiteral("git"), QStringList{QStringLiteral("cat-file"), QStringLiteral("--batch-check")});
-
+    QByteArray content;
     for ( int i = 0; i < document()->lines(); i++ ) {
-        m_hashjob->write(codec->fromUnicode(document()->line(i)));
+        content += codec->fromUnicode(document()->line(i));
         if ( i != document()->lines() - 1 ) {
-            m_hashjob->write("\n");
+            content += '\n';
         }
     }
-    m_hashjob->closeWriteChannel();
-
-}
 
-GitPluginCheckInRepositoryJob::~GitPluginCheckInRepositoryJob()
-{
-    if ( m_findjob && m_findjob->state() == QProcess::Running ) {
-        m_findjob->kill();
-    }
-    if ( m_hashjob && m_hashjob->state() == QProcess::Running ) {
-        m_hashjob->kill();
-    }
+    m_catFilePool->blobId(workingDirectory, content, this, [this, content](const QByteArray& id) {
+        if (id.isEmpty()) {
+            hashWithGit(content);
+        } else {
+            findBlob(id);
+        }
+    });
 }
 
-void GitPluginCheckInRepositoryJob::processFailed(QProcess::ProcessError err)
+void GitPluginCheckInRepositoryJob::hashWithGit(const QByteArray& content)
 {
-    qCDebug(PLUGIN_GIT) << "calling git failed with error:" << err;
-    emit finished(false);
+    // an object format we cannot hash ourselves, let git do it
+    auto* hashJob = new QProcess(this);
+    hashJob->setWorkingDirectory(m_rootDirectory);
+    connect(hashJob, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+            [this, hashJob](int exitCode, QProcess::ExitStatus exitStatus) {
+        if (exitStatus != QProcess::NormalExit || exitCode != 0) {
+            emit finished(false);
+            return;
+        }
+        findBlob(hashJob->readAllStandardOutput().trimmed());
+    });
+    connect(hashJob, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        // other errors are followed by finished()
+        if (error == QProcess::FailedToStart) {
+            qCDebug(PLUGIN_GIT) << "calling git failed with error:" << error;
+            emit finished(false);
+        }
+    });
+    hashJob->start(QStringLiteral("git"), {QStringLiteral("hash-object"), QStringLiteral("--stdin")});
+    hashJob->write(content);
+    hashJob->closeWriteChannel();
 }
 
-void GitPluginCheckInRepositoryJob::repositoryQueryFinished(int)
+void GitPluginCheckInRepositoryJob::findBlob(const QByteArray& id)
 {
-    const QByteArray output = m_findjob->readAllStandardOutput();
-    bool requestSucceeded = output.contains(" blob ");
-    emit finished(requestSucceeded);
+    m_catFilePool->query(QDir(m_rootDirectory), id, this, [this](const GitObjectInfo& info) {
+        emit finished(info.isValid() && info.type == "blob");
+    });
 }
 
+GitPluginCheckInRepositoryJob::~GitPluginCheckInRepositoryJob() = default;
@@ -22,23 +22,23 @@
 #define GITPLUGINCHECKINREPOSITORYJOB_H
 
 #include <vcs/interfaces/icontentawareversioncontrol.h>
-#include <QProcess>
+
+class GitCatFilePool;
 
 class GitPluginCheckInRepositoryJob : public KDevelop::CheckInRepositoryJob
 {
     Q_OBJECT
 public:
-    GitPluginCheckInRepositoryJob(KTextEditor::Document* document, const QString& rootDirectory);
+    GitPluginCheckInRepositoryJob(KTextEditor::Document* document, const QString& rootDirectory,
+                                  GitCatFilePool* catFilePool);
     ~GitPluginCheckInRepositoryJob() override;
     void start() override;
 
-private Q_SLOTS:
-    void repositoryQueryFinished(int);
-    void processFailed(QProcess::ProcessError);
-
 private:
-    QProcess* m_hashjob;
-    QProcess* m_findjob;
+    void hashWithGit(const QByteArray& content);
+    void findBlob(const QByteArray& id);
+
+    GitCatFilePool* m_catFilePool;
     QString m_rootDirectory;
 };
 
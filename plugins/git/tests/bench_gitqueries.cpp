@@ -0,0 +1,119 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "bench_gitqueries.h"
+
+#include "../gitcatfilepool.h"
+
+#include <tests/autotestshell.h>
+#include <tests/testcore.h>
+#include <vcs/dvcs/dvcsjob.h>
+
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QScopedPointer>
+#include <QTest>
+
+using namespace KDevelop;
+
+namespace {
+
+const int QUERY_COUNT = 50;
+
+bool runGit(const QString& directory, const QStringList& arguments)
+{
+    QProcess git;
+    git.setWorkingDirectory(directory);
+    git.start(QStringLiteral("git"), arguments);
+    return git.waitForFinished() && git.exitStatus() == QProcess::NormalExit && git.exitCode() == 0;
+}
+
+}
+
+void BenchGitQueries::initTestCase()
+{
+    AutoTestShell::init({QStringLiteral("kdevgit")});
+    TestCore::initialize(Core::NoUi);
+
+    QVERIFY(m_repository.isValid());
+    const QString path = m_repository.path();
+    QVERIFY(runGit(path, {QStringLiteral("init"), QStringLiteral("-q")}));
+
+    QFile file(path + QLatin1String("/file"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("content\n");
+    file.close();
+
+    QVERIFY(runGit(path, {QStringLiteral("add"), QStringLiteral("file")}));
+    QVERIFY(runGit(path, {QStringLiteral("-c"), QStringLiteral("user.name=bench"),
+                          QStringLiteral("-c"), QStringLiteral("user.email=bench@example.com"),
+                          QStringLiteral("commit"), QStringLiteral("-q"), QStringLiteral("-m"), QStringLiteral("bench")}));
+}
+
+void BenchGitQueries::cleanupTestCase()
+{
+    TestCore::shutdown();
+}
+
+void BenchGitQueries::benchDVcsJob()
+{
+    const QDir repository(m_repository.path());
+    QBENCHMARK {
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            QScopedPointer<DVcsJob> job(new DVcsJob(repository, nullptr, OutputJob::Silent));
+            job->setAutoDelete(false);
+            *job << "git" << "cat-file" << "-t" << "HEAD:file";
+            QVERIFY(job->exec());
+            QCOMPARE(job->rawOutput().trimmed(), QByteArrayLiteral("blob"));
+        }
+    }
+}
+
+void BenchGitQueries::benchCatFilePool()
+{
+    const QDir repository(m_repository.path());
+    GitCatFilePool pool;
+    QBENCHMARK {
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            const GitObjectInfo info = pool.queryNow(repository, QByteArrayLiteral("HEAD:file"));
+            QCOMPARE(info.type, QByteArrayLiteral("blob"));
+        }
+    }
+}
+
+void BenchGitQueries::benchCatFilePoolConcurrent()
+{
+    const QDir repository(m_repository.path());
+    GitCatFilePool pool;
+    QBENCHMARK {
+        // identical queries in flight at the same time are sent to git once
+        int answers = 0;
+        // destroyed before answers, so a timed out iteration drops the answers still in flight
+        QObject context;
+        for (int i = 0; i < QUERY_COUNT; ++i) {
+            pool.query(repository, QByteArrayLiteral("HEAD:file"), &context, [&answers](const GitObjectInfo&) {
+                ++answers;
+            });
+        }
+        QTRY_COMPARE(answers, QUERY_COUNT);
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchGitQueries)
@@ -0,0 +1,46 @@
+/*
+ * This file is part of KDevelop
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Library General Public License as
+ * published by the Free Software Foundation; either version 2 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef KDEVPLATFORM_PLUGIN_BENCH_GITQUERIES_H
+#define KDEVPLATFORM_PLUGIN_BENCH_GITQUERIES_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+/**
+ * Compares read-only queries answered by a git process per query (DVcsJob)
+ * with those answered by the GitCatFilePool. One iteration runs QUERY_COUNT queries.
+ */
+class BenchGitQueries : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchDVcsJob();
+    void benchCatFilePool();
+    void benchCatFilePoolConcurrent();
+
+private:
+    QTemporaryDir m_repository;
+};
+
+#endif // KDEVPLATFORM_PLUGIN_BENCH_GITQUERIES_H
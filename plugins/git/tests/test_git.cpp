@@ -29,10 +29,14 @@
 #include <tests/autotestshell.h>
 #include <QUrl>
 #include <QDebug>
+#include <QProcess>
+#include <QTemporaryDir>
 
 #include <vcs/dvcs/dvcsjob.h>
 #include <vcs/vcsannotation.h>
+#include <vcs/vcsevent.h>
 #include "../gitplugin.h"
+#include "../gitcatfilepool.h"
 
 #define VERIFYJOB(j) \
 do { QVERIFY(j); QVERIFY(j->exec()); QVERIFY((j)->status() == KDevelop::VcsJob::JobSucceeded); } while(0)
@@ -490,6 +494,151 @@ void GitInitTest::testAnnotation()
     QCOMPARE(annotation.commitMessage(), QStringLiteral("KDevelop's Test commit3"));
 }
 
+void GitInitTest::testAnnotationUncommitted()
+{
+    repoInit();
+    addFiles();
+    commitFiles();
+
+    QVERIFY(writeFile(gitTest_BaseDir() + gitTest_FileName(), QStringLiteral("An appended line"), QIODevice::Append));
+    QVERIFY(writeFile(gitTest_BaseDir() + gitTest_FileName2(), QStringLiteral("An appended line"), QIODevice::Append));
+
+    VcsJob* j = m_plugin->annotate(QUrl::fromLocalFile(gitTest_BaseDir() + gitTest_FileName()), VcsRevision::createSpecialRevision(VcsRevision::Head));
+    VERIFYJOB(j);
+    QList<QVariant> results = j->fetchResults().toList();
+    QCOMPARE(results.size(), 2);
+    VcsAnnotationLine annotation = results.at(1).value<VcsAnnotationLine>();
+    QVERIFY(annotation.commitMessage().contains(gitTest_FileName()));
+
+    // the uncommitted line of the second file must not reuse the cached info of the first one
+    j = m_plugin->annotate(QUrl::fromLocalFile(gitTest_BaseDir() + gitTest_FileName2()), VcsRevision::createSpecialRevision(VcsRevision::Head));
+    VERIFYJOB(j);
+    results = j->fetchResults().toList();
+    QVERIFY(!results.isEmpty());
+    annotation = results.last().value<VcsAnnotationLine>();
+    QVERIFY(annotation.commitMessage().contains(gitTest_FileName2()));
+    QVERIFY(!annotation.commitMessage().contains(gitTest_FileName()));
+}
+
+void GitInitTest::testLogPage()
+{
+    repoInit();
+    addFiles();
+    commitFiles();
+
+    const QUrl baseUrl = QUrl::fromLocalFile(gitTest_BaseDir());
+    const VcsRevision head = VcsRevision::createSpecialRevision(VcsRevision::Head);
+
+    VcsJob* j = m_plugin->logPage(baseUrl, head, 0, 1);
+    VERIFYJOB(j);
+    QList<QVariant> results = j->fetchResults().toList();
+    QCOMPARE(results.size(), 1);
+    QVERIFY(results.at(0).canConvert<VcsEvent>());
+    const VcsEvent event = results.at(0).value<VcsEvent>();
+    QCOMPARE(event.message(), QStringLiteral("KDevelop's Test commit2"));
+    // pages do not list the changed files
+    QVERIFY(event.items().isEmpty());
+
+    j = m_plugin->logItems(baseUrl, event.revision());
+    VERIFYJOB(j);
+    results = j->fetchResults().toList();
+    QCOMPARE(results.size(), 1);
+    QVERIFY(results.at(0).canConvert<VcsItemEvent>());
+    const VcsItemEvent item = results.at(0).value<VcsItemEvent>();
+    QCOMPARE(item.repositoryLocation(), gitTest_FileName());
+    QCOMPARE(item.actions(), VcsItemEvent::Actions(VcsItemEvent::Modified));
+
+    j = m_plugin->logPage(baseUrl, head, 1, 1);
+    VERIFYJOB(j);
+    results = j->fetchResults().toList();
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.at(0).value<VcsEvent>().message(), QStringLiteral("Test commit"));
+
+    j = m_plugin->logPage(baseUrl, head, 2, 1);
+    VERIFYJOB(j);
+    QVERIFY(j->fetchResults().toList().isEmpty());
+}
+
+void GitInitTest::testCatFilePool()
+{
+    repoInit();
+    addFiles();
+    commitFiles();
+
+    const QDir repository(gitTest_BaseDir());
+    GitCatFilePool pool;
+
+    GitObjectInfo info = pool.queryNow(repository, QByteArrayLiteral("HEAD"));
+    QVERIFY(info.isValid());
+    QCOMPARE(info.type, QByteArrayLiteral("commit"));
+    QCOMPARE(info.id.size(), 40);
+
+    QVERIFY(!pool.queryNow(repository, QByteArrayLiteral("refs/heads/no-such-branch")).isValid());
+
+    // declared after the variables the callbacks write to, so a failed
+    // check drops the answers still in flight with it
+    int stashes = -1;
+    int answers = 0;
+    QByteArray id;
+    QObject context;
+
+    m_plugin->hasStashes(repository, &context, [&stashes](bool hasStashes) {
+        stashes = hasStashes;
+    });
+    QTRY_COMPARE(stashes, 0);
+
+    // concurrent identical queries all get the answer
+    const QByteArray file = QByteArrayLiteral("HEAD:") + gitTest_FileName().toUtf8();
+    for (int i = 0; i < 3; ++i) {
+        pool.query(repository, file, &context, [&answers](const GitObjectInfo& info) {
+            QCOMPARE(info.type, QByteArrayLiteral("blob"));
+            ++answers;
+        });
+    }
+    QTRY_COMPARE(answers, 3);
+    QCOMPARE(pool.processCount(), 1);
+
+    // the in-process hash is the id of the committed content
+    const GitObjectInfo blob = pool.queryNow(repository, file);
+    pool.blobId(repository, QByteArrayLiteral("Just another HELLO WORLD\n"), &context, [&id](const QByteArray& blobId) {
+        id = blobId;
+    });
+    QTRY_COMPARE(id, blob.id);
+}
+
+void GitInitTest::testCatFilePoolSha256()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QProcess init;
+    init.setWorkingDirectory(dir.path());
+    init.start(QStringLiteral("git"), {QStringLiteral("init"), QStringLiteral("--object-format=sha256")});
+    QVERIFY(init.waitForFinished());
+    if (init.exitCode() != 0) {
+        QSKIP("git does not support SHA-256 repositories");
+    }
+
+    QVERIFY(writeFile(dir.filePath(gitTest_FileName()), QStringLiteral("HELLO WORLD\n")));
+    QProcess add;
+    add.setWorkingDirectory(dir.path());
+    add.start(QStringLiteral("git"), {QStringLiteral("add"), gitTest_FileName()});
+    QVERIFY(add.waitForFinished());
+    QCOMPARE(add.exitCode(), 0);
+
+    const QDir repository(dir.path());
+    GitCatFilePool pool;
+    const GitObjectInfo blob = pool.queryNow(repository, QByteArrayLiteral(":") + gitTest_FileName().toUtf8());
+    QVERIFY(blob.isValid());
+    QCOMPARE(blob.id.size(), 64);
+
+    QByteArray id;
+    QObject context;
+    pool.blobId(repository, QByteArrayLiteral("HELLO WORLD\n"), &context, [&id](const QByteArray& blobId) {
+        id = blobId;
+    });
+    QTRY_COMPARE(id, blob.id);
+}
+
 void GitInitTest::testRemoveEmptyFolder()
 {
     repoInit();
@@ -58,6 +58,10 @@ private Q_SLOTS:
     void testMerge();
     void revHistory();
     void testAnnotation();
+    void testAnnotationUncommitted();
+    void testLogPage();
+    void testCatFilePool();
+    void testCatFilePoolSha256();
     void testRemoveEmptyFolder();
     void testRemoveEmptyFolderInFolder();
     void testRemoveUnindexedFile();
@@ -87,13 +87,11 @@ void LldbFrameStackModel::handleThreadInfo(const ResultRecord& r)
         if (threadMI[QStringLiteral("state")].literal() == QLatin1String("stopped")) {
             // lldb-mi returns multiple frame entry for each thread
             // so can't directly use threadMI["frame"]
-            auto &th = static_cast<const TupleValue&>(threadMI);
-            Value *topFrame = nullptr;
-            for (auto res : th.results) {
-                if (res->variable == QLatin1String("frame")) {
-                    if (!topFrame || (*res->value)[QStringLiteral("level")].toInt() < (*topFrame)[QStringLiteral("level")].toInt()) {
-                        topFrame = res->value;
-                    }
+            const Value *topFrame = nullptr;
+            const auto frames = threadMI.allFields(QStringLiteral("frame"));
+            for (auto frame : frames) {
+                if (!topFrame || (*frame)[QStringLiteral("level")].toInt() < (*topFrame)[QStringLiteral("level")].toInt()) {
+                    topFrame = frame;
                 }
             }
             i.name = getFunctionOrAddress(*topFrame);
@@ -37,6 +37,7 @@
 #include <project/projectmodel.h>
 #include <project/interfaces/ibuildsystemmanager.h>
 #include <outputview/outputfilteringstrategies.h>
+#include <language/backgroundparser/rebuiltsourcesparser.h>
 
 #include "makebuilder.h"
 #include "makebuilderpreferences.h"
@@ -86,7 +87,7 @@ MakeJob::MakeJob(QObject* parent, KDevelop::ProjectBaseItem* item,
     Q_ASSERT(item && item->model() && m_idx.isValid() && this->item() == item);
     setCapabilities( Killable );
     setFilteringStrategy(new MakeJobCompilerFilterStrategy(buildDir.toUrl()));
-    setProperties( NeedWorkingDirectory | PortableMessages | DisplayStderr | IsBuilderHint );
+    setProperties( NeedWorkingDirectory | PortableMessages | DisplayStderr | IsBuilderHint | PostProcessOutput );
 
     QString title;
     if( !m_overrideTargets.isEmpty() )
@@ -95,6 +96,8 @@ MakeJob::MakeJob(QObject* parent, KDevelop::ProjectBaseItem* item,
         title = i18n("Make (%1)", item->text());
     setJobName( title );
     setToolTitle( i18n("Make") );
+
+    connect(this, &MakeJob::result, this, &MakeJob::parseRebuiltSources);
 }
 
 MakeJob::~MakeJob()
@@ -126,6 +129,37 @@ void MakeJob::start()
     OutputExecuteJob::start();
 }
 
+void MakeJob::postProcessStdout(const QStringList& lines)
+{
+    // example string: [ 50%] Building CXX object kdevplatform/util/CMakeFiles/KDevPlatformUtil.dir/path.cpp.o
+    static const QRegularExpression re(QStringLiteral("^\\[[\\d ]+%\\] Building \\S+ object (.+)$"));
+
+    for (const QString& line : lines) {
+        const QRegularExpressionMatch match = re.match(line);
+        if (match.hasMatch()) {
+            m_builtObjectFiles.append(match.captured(1));
+        }
+    }
+
+    OutputExecuteJob::postProcessStdout(lines);
+}
+
+void MakeJob::parseRebuiltSources()
+{
+    ProjectBaseItem* it = item();
+    if (m_builtObjectFiles.isEmpty() || !it) {
+        return;
+    }
+
+    // CMake reports the objects relative to the top build directory, where the compilation database is
+    const Path buildDir = it->project()->buildSystemManager()->buildDirectory(it->project()->projectItem());
+    RebuiltSourcesParser rebuiltSources(buildDir);
+    for (const QString& objectFile : qAsConst(m_builtObjectFiles)) {
+        rebuiltSources.addObjectFile(objectFile);
+    }
+    rebuiltSources.parse();
+}
+
 KDevelop::ProjectBaseItem * MakeJob::item() const
 {
     return ICore::self()->projectController()->projectModel()->itemFromIndex(m_idx);
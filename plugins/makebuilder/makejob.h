@@ -81,6 +81,12 @@ public:
     // This returns the configured global environment profile.
     QString environmentProfile() const override;
 
+protected Q_SLOTS:
+    void postProcessStdout(const QStringList& lines) override;
+
+private Q_SLOTS:
+    void parseRebuiltSources();
+
 private:
     static bool isNMake(const QString& makeBin);
     
@@ -88,6 +94,8 @@ private:
     CommandType m_command;
     QStringList m_overrideTargets;
     MakeVariables m_variables;
+    /// Object files the build reported, relative to the top build directory
+    QStringList m_builtObjectFiles;
 };
 
 #endif // MAKEJOB_H
@@ -20,18 +20,27 @@
 #include "ninjabuilder.h"
 
 #include "ninjajob.h"
+#include "ninjabuildlog.h"
 #include "ninjabuilderpreferences.h"
 #include <debug.h>
 
 #include <KPluginFactory>
 #include <KConfigGroup>
+#include <KMessageBox>
 #include <KShell>
 #include <project/projectmodel.h>
 #include <project/interfaces/ibuildsystemmanager.h>
 #include <project/builderjob.h>
+#include <interfaces/icore.h>
 #include <interfaces/iproject.h>
+#include <interfaces/iuicontroller.h>
+#include <interfaces/context.h>
+#include <interfaces/contextmenuextension.h>
 
+#include <QAction>
 #include <QFile>
+#include <QFileDialog>
+#include <QSaveFile>
 
 K_PLUGIN_FACTORY_WITH_JSON(NinjaBuilderFactory, "kdevninja.json", registerPlugin<NinjaBuilder>(); )
 
@@ -183,6 +192,62 @@ KDevelop::ConfigPage* NinjaBuilder::perProjectConfigPage(int number, const KDeve
     return nullptr;
 }
 
+KDevelop::ContextMenuExtension NinjaBuilder::contextMenuExtension(KDevelop::Context* context, QWidget* parent)
+{
+    KDevelop::ContextMenuExtension ext;
+
+    if (!context->hasType(KDevelop::Context::ProjectItemContext)) {
+        return ext;
+    }
+    auto* ctx = static_cast<KDevelop::ProjectItemContext*>(context);
+    const auto items = ctx->items();
+    if (items.size() != 1) {
+        return ext;
+    }
+
+    KDevelop::IProject* project = items.first()->project();
+    KDevelop::IBuildSystemManager* bsm = project->buildSystemManager();
+    if (!bsm) {
+        return ext;
+    }
+    const QString logPath = NinjaBuildLog::path(bsm->buildDirectory(project->projectItem()).toLocalFile());
+    if (!QFile::exists(logPath)) {
+        return ext;
+    }
+
+    auto* action = new QAction(QIcon::fromTheme(QStringLiteral("document-export")),
+                               i18nc("@action", "Export Ninja Build Trace..."), parent);
+    connect(action, &QAction::triggered, this, [this, logPath]() {
+        exportBuildTrace(logPath);
+    });
+    ext.addAction(KDevelop::ContextMenuExtension::BuildGroup, action);
+
+    return ext;
+}
+
+void NinjaBuilder::exportBuildTrace(const QString& logPath)
+{
+    QWidget* window = KDevelop::ICore::self()->uiController()->activeMainWindow();
+
+    const auto entries = NinjaBuildLog::lastBuild(NinjaBuildLog::read(logPath));
+    if (entries.isEmpty()) {
+        KMessageBox::error(window, i18n("The ninja log %1 records no build.", logPath));
+        return;
+    }
+
+    const QString path = QFileDialog::getSaveFileName(window, i18nc("@title:window", "Export Ninja Build Trace"), {},
+                                                      i18n("Chrome Trace (*.json)"));
+    if (path.isEmpty()) {
+        return;
+    }
+
+    QSaveFile file(path);
+    const QByteArray trace = NinjaBuildLog::chromeTrace(entries);
+    if (!file.open(QIODevice::WriteOnly) || file.write(trace) != trace.size() || !file.commit()) {
+        KMessageBox::error(window, i18n("Could not write the build trace to %1.", path));
+    }
+}
+
 class ErrorJob
     : public KJob
 {
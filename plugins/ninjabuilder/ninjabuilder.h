@@ -49,6 +49,8 @@ public:
     int perProjectConfigPages() const override;
     KDevelop::ConfigPage* perProjectConfigPage(int number, const KDevelop::ProjectConfigOptions& options, QWidget* parent) override;
 
+    KDevelop::ContextMenuExtension contextMenuExtension(KDevelop::Context* context, QWidget* parent) override;
+
 Q_SIGNALS:
     void built(KDevelop::ProjectBaseItem* item);
     void failed(KDevelop::ProjectBaseItem* item);
@@ -56,6 +58,9 @@ Q_SIGNALS:
     void cleaned(KDevelop::ProjectBaseItem* item);
 
 private:
+    /// Saves the last build recorded in the ninja log at @p logPath as a Chrome trace
+    void exportBuildTrace(const QString& logPath);
+
     KDevelop::ObjectList<NinjaJob> m_activeNinjaJobs;
 };
 
@@ -0,0 +1,166 @@
+/* This file is part of KDevelop
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License version 2 as published by the Free Software Foundation.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+   Boston, MA 02110-1301, USA.
+ */
+
+#include "ninjabuildlog.h"
+
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+
+/// How far the start of a build estimated from different entries may differ, in ms
+const qint64 BUILD_START_TOLERANCE = 2000;
+
+qint64 mtimeInMs(qint64 mtime)
+{
+    // ninja records nanoseconds, versions before 1.9 seconds
+    return mtime > 100000000000000 ? mtime / 1000000 : mtime * 1000;
+}
+
+/// The time the build running @p entry started at, as told by the mtime of its outputs
+qint64 buildStart(const NinjaLogEntry& entry)
+{
+    return entry.mtime - entry.end;
+}
+
+}
+
+namespace NinjaBuildLog
+{
+
+QString path(const QString& buildDirectory)
+{
+    return QDir(buildDirectory).filePath(QStringLiteral(".ninja_log"));
+}
+
+QVector<NinjaLogEntry> read(const QString& logPath, qint64 offset)
+{
+    QVector<NinjaLogEntry> entries;
+
+    QFile log(logPath);
+    if (!log.open(QIODevice::ReadOnly) || (offset > 0 && !log.seek(offset))) {
+        return entries;
+    }
+
+    while (!log.atEnd()) {
+        // "<start>\t<end>\t<mtime>\t<output>\t<command hash>", and the "# ninja log v5" header
+        const QByteArray line = log.readLine();
+        if (line.startsWith('#')) {
+            continue;
+        }
+        const QList<QByteArray> fields = line.split('\t');
+        if (fields.size() != 5) {
+            continue;
+        }
+
+        NinjaLogEntry entry;
+        entry.start = fields.at(0).toLongLong();
+        entry.end = fields.at(1).toLongLong();
+        entry.mtime = mtimeInMs(fields.at(2).toLongLong());
+        const QString output = QString::fromLocal8Bit(fields.at(3));
+
+        // ninja writes a line per output of an edge
+        if (!entries.isEmpty() && entries.last().start == entry.start && entries.last().end == entry.end) {
+            entries.last().outputs.append(output);
+        } else {
+            entry.outputs.append(output);
+            entries.append(entry);
+        }
+    }
+    return entries;
+}
+
+QVector<NinjaLogEntry> lastBuild(const QVector<NinjaLogEntry>& entries)
+{
+    // ninja appends the edges in the order they finish, with times starting over for each build
+    int first = 0;
+    for (int i = 1; i < entries.size(); ++i) {
+        if (entries.at(i).end < entries.at(i - 1).end) {
+            first = i;
+        }
+    }
+
+    // Entries of earlier builds rewritten by a recompaction may happen to continue the order.
+    // Their outputs were written before the last build started. Outputs left alone by a restat
+    // only make a build look older, so the latest estimate is the one of the last build.
+    qint64 lastStart = std::numeric_limits<qint64>::min();
+    for (int i = first; i < entries.size(); ++i) {
+        if (entries.at(i).mtime > 0) {
+            lastStart = std::max(lastStart, buildStart(entries.at(i)));
+        }
+    }
+    while (first < entries.size() - 1 && entries.at(first).mtime > 0
+           && buildStart(entries.at(first)) < lastStart - BUILD_START_TOLERANCE) {
+        ++first;
+    }
+    return entries.mid(first);
+}
+
+QVector<NinjaLogEntry> slowest(QVector<NinjaLogEntry> entries, int count)
+{
+    count = std::min(count, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + count, entries.end(),
+                      [](const NinjaLogEntry& a, const NinjaLogEntry& b) {
+        return a.duration() > b.duration();
+    });
+    entries.resize(count);
+    return entries;
+}
+
+QByteArray chromeTrace(const QVector<NinjaLogEntry>& entries)
+{
+    QVector<NinjaLogEntry> sorted = entries;
+    std::stable_sort(sorted.begin(), sorted.end(), [](const NinjaLogEntry& a, const NinjaLogEntry& b) {
+        return a.start < b.start;
+    });
+
+    // the end of the last entry of each thread, an entry goes to the first thread which is free then
+    QVector<qint64> threadEnds;
+    QJsonArray events;
+    for (const NinjaLogEntry& entry : qAsConst(sorted)) {
+        int thread = 0;
+        while (thread < threadEnds.size() && threadEnds.at(thread) > entry.start) {
+            ++thread;
+        }
+        if (thread == threadEnds.size()) {
+            threadEnds.append(entry.end);
+        } else {
+            threadEnds[thread] = entry.end;
+        }
+
+        // the trace counts in microseconds
+        events.append(QJsonObject{
+            {QStringLiteral("name"), entry.outputs.join(QLatin1Char(' '))},
+            {QStringLiteral("cat"), QStringLiteral("targets")},
+            {QStringLiteral("ph"), QStringLiteral("X")},
+            {QStringLiteral("ts"), static_cast<double>(entry.start * 1000)},
+            {QStringLiteral("dur"), static_cast<double>(entry.duration() * 1000)},
+            {QStringLiteral("pid"), 0},
+            {QStringLiteral("tid"), thread},
+        });
+    }
+    return QJsonDocument(events).toJson(QJsonDocument::Compact);
+}
+
+}
@@ -0,0 +1,75 @@
+/* This file is part of KDevelop
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License version 2 as published by the Free Software Foundation.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+   Boston, MA 02110-1301, USA.
+ */
+
+#ifndef NINJABUILDLOG_H
+#define NINJABUILDLOG_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * An edge ninja ran, as recorded in its .ninja_log.
+ *
+ * The times are in milliseconds since the start of the build which ran it.
+ */
+struct NinjaLogEntry
+{
+    qint64 start = 0;
+    qint64 end = 0;
+    /// When the outputs were last written, in ms since the epoch, 0 if unknown
+    qint64 mtime = 0;
+    /// The outputs of the edge, relative to the build directory
+    QStringList outputs;
+
+    qint64 duration() const { return end - start; }
+};
+Q_DECLARE_TYPEINFO(NinjaLogEntry, Q_MOVABLE_TYPE);
+
+namespace NinjaBuildLog
+{
+/// Path of the log of the build in @p buildDirectory
+QString path(const QString& buildDirectory);
+
+/**
+ * Reads the entries of the log at @p logPath, starting at byte @p offset.
+ *
+ * An edge with several outputs gets one entry.
+ */
+QVector<NinjaLogEntry> read(const QString& logPath, qint64 offset = 0);
+
+/**
+ * The entries of the last build in @p entries, in the order of the log.
+ *
+ * When ninja recompacts its log, it rewrites the entries of earlier builds in no particular order.
+ * The last build is appended after them, and is told apart by its end times and output mtimes.
+ */
+QVector<NinjaLogEntry> lastBuild(const QVector<NinjaLogEntry>& entries);
+
+/// The @p count longest running entries, the longest first
+QVector<NinjaLogEntry> slowest(QVector<NinjaLogEntry> entries, int count);
+
+/**
+ * The entries in the Chrome trace event format, as read by chrome://tracing or Perfetto.
+ *
+ * Entries running at the same time are put in different threads, so the trace shows the parallelism.
+ */
+QByteArray chromeTrace(const QVector<NinjaLogEntry>& entries);
+}
+
+#endif // NINJABUILDLOG_H
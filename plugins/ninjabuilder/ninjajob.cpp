@@ -20,24 +20,34 @@
 #include "ninjajob.h"
 
 #include "ninjabuilder.h"
+#include "ninjabuildlog.h"
 
 #include <outputview/outputfilteringstrategies.h>
 #include <project/interfaces/ibuildsystemmanager.h>
 #include <project/projectmodel.h>
+#include <language/backgroundparser/rebuiltsourcesparser.h>
 #include <interfaces/iproject.h>
 #include <interfaces/icore.h>
 #include <interfaces/iprojectcontroller.h>
 
 #include <KLocalizedString>
 #include <KConfigGroup>
+#include <KFormat>
 
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QRegularExpression>
 #include <QStandardPaths>
 #include <QUrl>
 
+#include <algorithm>
+
 using namespace KDevelop;
 
+/// Number of build steps in the timing report
+static const int SlowestEdgesCount = 10;
+
 class NinjaJobCompilerFilterStrategy
     : public CompilerFilterStrategy
 {
@@ -58,7 +68,8 @@ IFilterStrategy::Progress NinjaJobCompilerFilterStrategy::progressInLine(const Q
         const int total = match.capturedRef(2).toInt();
         if (current && total) {
             // this is output from ninja
-            const QString action = match.captured(3);
+            const QString action = i18nc("%1 finished build steps, %2 all build steps, %3 current one", "[%1/%2] %3",
+                                         current, total, match.captured(3));
             const int percent = qRound(( float )current / total * 100);
             return {
                        action, percent
@@ -89,7 +100,8 @@ NinjaJob::NinjaJob(KDevelop::ProjectBaseItem* item, CommandType commandType,
     setProperties(NeedWorkingDirectory | PortableMessages | DisplayStderr | IsBuilderHint | PostProcessOutput);
 
     // hardcode the ninja output format so we can parse it reliably
-    addEnvironmentOverride(QStringLiteral("NINJA_STATUS"), QStringLiteral("[%s/%t] "));
+    // with the finished instead of the started edges, so the progress is real
+    addEnvironmentOverride(QStringLiteral("NINJA_STATUS"), QStringLiteral("[%f/%t] "));
 
     *this << ninjaExecutable();
     *this << arguments;
@@ -110,6 +122,7 @@ NinjaJob::NinjaJob(KDevelop::ProjectBaseItem* item, CommandType commandType,
     setJobName(title);
 
     connect(this, &NinjaJob::finished, this, &NinjaJob::emitProjectBuilderSignal);
+    connect(this, &NinjaJob::result, this, &NinjaJob::parseRebuiltSources);
 }
 
 NinjaJob::~NinjaJob()
@@ -119,6 +132,15 @@ NinjaJob::~NinjaJob()
     disconnect(this, &NinjaJob::finished, this, &NinjaJob::emitProjectBuilderSignal);
 }
 
+void NinjaJob::start()
+{
+    // ninja appends the outputs it writes to its log
+    m_logOffset = QFileInfo(NinjaBuildLog::path(buildDirectory())).size();
+    m_startTime = QDateTime::currentDateTime();
+
+    OutputExecuteJob::start();
+}
+
 void NinjaJob::setIsInstalling(bool isInstalling)
 {
     m_isInstalling = isInstalling;
@@ -197,6 +219,86 @@ void NinjaJob::emitProjectBuilderSignal(KJob* job)
     }
 }
 
+QString NinjaJob::buildDirectory() const
+{
+    const QUrl dir = workingDirectory();
+    return dir.isEmpty() ? QString() : dir.toLocalFile();
+}
+
+QVector<NinjaLogEntry> NinjaJob::buildLogEntries() const
+{
+    const QString dir = buildDirectory();
+    if (dir.isEmpty()) {
+        return {};
+    }
+
+    // ninja shrinks the log when too many entries are outdated, then all entries are read
+    // and only outputs written since the start count
+    const QString logPath = NinjaBuildLog::path(dir);
+    if (QFileInfo(logPath).size() >= m_logOffset) {
+        return NinjaBuildLog::read(logPath, m_logOffset);
+    }
+
+    QVector<NinjaLogEntry> entries = NinjaBuildLog::read(logPath);
+    const QDir buildDir(dir);
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const NinjaLogEntry& entry) {
+        return QFileInfo(buildDir, entry.outputs.first()).lastModified() < m_startTime;
+    }), entries.end());
+    return entries;
+}
+
+void NinjaJob::childProcessExited(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    // the report goes before the result of the job
+    appendTimingReport(buildLogEntries());
+
+    OutputExecuteJob::childProcessExited(exitCode, exitStatus);
+}
+
+void NinjaJob::appendTimingReport(const QVector<NinjaLogEntry>& entries)
+{
+    if (entries.isEmpty()) {
+        return;
+    }
+
+    qint64 start = entries.first().start;
+    qint64 end = entries.first().end;
+    for (const NinjaLogEntry& entry : entries) {
+        start = std::min(start, entry.start);
+        end = std::max(end, entry.end);
+    }
+
+    QStringList lines;
+    lines << i18np("Ran %1 build step in %2, the slowest were:", "Ran %1 build steps in %2, the slowest were:",
+                   entries.size(), KFormat().formatDuration(end - start));
+    const auto slowest = NinjaBuildLog::slowest(entries, SlowestEdgesCount);
+    for (const NinjaLogEntry& entry : slowest) {
+        lines << i18nc("%1 duration in seconds, %2 outputs of a build step", "%1 s  %2",
+                       QString::number(entry.duration() / 1000.0, 'f', 1), entry.outputs.join(QLatin1Char(' ')));
+    }
+    model()->appendLines(lines);
+}
+
+void NinjaJob::parseRebuiltSources()
+{
+    const QString dir = buildDirectory();
+    if (dir.isEmpty()) {
+        return;
+    }
+
+    RebuiltSourcesParser rebuiltSources(Path(dir));
+    const auto entries = buildLogEntries();
+    for (const NinjaLogEntry& entry : entries) {
+        for (const QString& output : entry.outputs) {
+            rebuiltSources.addObjectFile(output);
+        }
+    }
+
+    if (!rebuiltSources.isEmpty()) {
+        rebuiltSources.parse();
+    }
+}
+
 void NinjaJob::postProcessStderr(const QStringList& lines)
 {
     appendLines(lines);
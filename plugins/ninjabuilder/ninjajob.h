@@ -20,8 +20,11 @@
 #ifndef NINJAJOB_H
 #define NINJAJOB_H
 
+#include "ninjabuildlog.h"
+
 #include <outputview/outputexecutejob.h>
 
+#include <QDateTime>
 #include <QPointer>
 
 namespace KDevelop {
@@ -55,6 +58,8 @@ public:
              const QByteArray& signal, NinjaBuilder* parent);
     ~NinjaJob() override;
 
+    void start() override;
+
     void setIsInstalling(bool isInstalling);
     static QString ninjaExecutable();
 
@@ -66,9 +71,11 @@ public:
 protected Q_SLOTS:
     void postProcessStdout(const QStringList& lines) override;
     void postProcessStderr(const QStringList& lines) override;
+    void childProcessExited(int exitCode, QProcess::ExitStatus exitStatus) override;
 
 private Q_SLOTS:
     void emitProjectBuilderSignal(KJob* job);
+    void parseRebuiltSources();
 
 private:
     bool m_isInstalling;
@@ -76,8 +83,15 @@ private:
     CommandType m_commandType;
     QByteArray m_signal;
     QPointer<NinjaBuilder> m_plugin;
+    /// Size of the ninja log and time when the build started
+    qint64 m_logOffset = 0;
+    QDateTime m_startTime;
 
     void appendLines(const QStringList& lines);
+    QString buildDirectory() const;
+    /// The entries ninja added to its log since the job started
+    QVector<NinjaLogEntry> buildLogEntries() const;
+    void appendTimingReport(const QVector<NinjaLogEntry>& entries);
 };
 
 #endif  // NINJAJOB_H
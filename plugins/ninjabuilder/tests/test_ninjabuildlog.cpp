@@ -0,0 +1,120 @@
+/* This file is part of KDevelop
+
+   This library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License version 2 as published by the Free Software Foundation.
+
+   This library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Library General Public License
+   along with this library; see the file COPYING.LIB.  If not, write to
+   the Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+   Boston, MA 02110-1301, USA.
+ */
+
+#include "test_ninjabuildlog.h"
+
+#include "../ninjabuildlog.h"
+
+#include <QFile>
+#include <QTest>
+
+QTEST_GUILESS_MAIN(TestNinjaBuildLog)
+
+namespace
+{
+
+/// The wall clock start of the builds in the logs, in ms since the epoch
+const qint64 BUILD1 = 1600000000000;
+const qint64 BUILD2 = BUILD1 + 60000;
+const qint64 BUILD3 = BUILD2 + 60000;
+
+/// A line of the log for an edge of the build started at @p build, with the mtime in ns
+QByteArray line(qint64 build, qint64 start, qint64 end, const QByteArray& output)
+{
+    return QByteArray::number(start) + '\t' + QByteArray::number(end) + '\t'
+        + QByteArray::number((build + end) * 1000000) + '\t' + output + "\t1234abcd\n";
+}
+
+QStringList outputs(const QVector<NinjaLogEntry>& entries)
+{
+    QStringList result;
+    for (const NinjaLogEntry& entry : entries) {
+        result += entry.outputs;
+    }
+    return result;
+}
+
+}
+
+QString TestNinjaBuildLog::writeLog(const QByteArray& contents)
+{
+    const QString path = NinjaBuildLog::path(m_dir.path());
+    QFile log(path);
+    if (!log.open(QIODevice::WriteOnly) || log.write("# ninja log v5\n" + contents) < 0) {
+        return QString();
+    }
+    return path;
+}
+
+void TestNinjaBuildLog::testRead()
+{
+    QVERIFY(m_dir.isValid());
+    const QString path = writeLog(line(BUILD1, 0, 100, "a.o")
+                                  + line(BUILD1, 10, 250, "gen.h") + line(BUILD1, 10, 250, "gen.cpp")
+                                  + "not\ta\tlog line\n");
+    QVERIFY(!path.isEmpty());
+
+    const auto entries = NinjaBuildLog::read(path);
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries.at(0).outputs, QStringList{QStringLiteral("a.o")});
+    QCOMPARE(entries.at(0).mtime, BUILD1 + 100);
+    // the outputs of an edge are merged
+    QCOMPARE(entries.at(1).outputs, QStringList({QStringLiteral("gen.h"), QStringLiteral("gen.cpp")}));
+    QCOMPARE(entries.at(1).duration(), qint64(240));
+}
+
+void TestNinjaBuildLog::testLastBuild()
+{
+    const QString path = writeLog(line(BUILD1, 0, 100, "a.o") + line(BUILD1, 0, 200, "b.o")
+                                  + line(BUILD1, 200, 300, "app")
+                                  + line(BUILD2, 0, 150, "b.o") + line(BUILD2, 150, 220, "app"));
+    QVERIFY(!path.isEmpty());
+
+    const auto entries = NinjaBuildLog::lastBuild(NinjaBuildLog::read(path));
+    QCOMPARE(outputs(entries), QStringList({QStringLiteral("b.o"), QStringLiteral("app")}));
+}
+
+void TestNinjaBuildLog::testLastBuildRecompacted()
+{
+    // ninja rewrote the entries of the first two builds in hash order, the last two happen
+    // to end before the first edge of the third build
+    const QString path = writeLog(line(BUILD2, 0, 400, "app") + line(BUILD1, 0, 300, "c.o")
+                                  + line(BUILD2, 0, 5, "a.o") + line(BUILD1, 0, 10, "b.o")
+                                  + line(BUILD3, 0, 20, "c.o") + line(BUILD3, 0, 30, "d.o")
+                                  + line(BUILD3, 20, 90, "app"));
+    QVERIFY(!path.isEmpty());
+
+    const auto entries = NinjaBuildLog::lastBuild(NinjaBuildLog::read(path));
+    QCOMPARE(outputs(entries), QStringList({QStringLiteral("c.o"), QStringLiteral("d.o"), QStringLiteral("app")}));
+
+    // without any build since the recompaction the entries are still of a single build
+    const QString compacted = writeLog(line(BUILD2, 0, 400, "app") + line(BUILD1, 0, 300, "c.o")
+                                       + line(BUILD2, 0, 5, "a.o") + line(BUILD2, 5, 10, "b.o"));
+    QVERIFY(!compacted.isEmpty());
+    QCOMPARE(outputs(NinjaBuildLog::lastBuild(NinjaBuildLog::read(compacted))),
+             QStringList({QStringLiteral("a.o"), QStringLiteral("b.o")}));
+}
+
+void TestNinjaBuildLog::testSlowest()
+{
+    const QString path = writeLog(line(BUILD1, 0, 100, "a.o") + line(BUILD1, 0, 300, "b.o")
+                                  + line(BUILD1, 100, 150, "c.o"));
+    QVERIFY(!path.isEmpty());
+
+    const auto entries = NinjaBuildLog::slowest(NinjaBuildLog::read(path), 2);
+    QCOMPARE(outputs(entries), QStringList({QStringLiteral("b.o"), QStringLiteral("a.o")}));
+}
@@ -122,18 +122,23 @@ void ProblemReporterModel::timerExpired()
 {
     m_minTimer->stop();
     m_maxTimer->stop();
-    rebuildProblemList();
+
+    // only the documents parsed meanwhile changed
+    const auto documents = m_updatedDocuments;
+    m_updatedDocuments.clear();
+    for (const IndexedString& document : documents) {
+        if (m_documents.contains(document)) {
+            setProblems(document, problems({document}));
+        }
+    }
 }
 
 void ProblemReporterModel::setCurrentDocument(KDevelop::IDocument* doc)
 {
     Q_ASSERT(thread() == QThread::currentThread());
 
-    beginResetModel();
-
     /// Will trigger signal changed() if problems change
     store()->setCurrentDocument(IndexedString(doc->url()));
-    endResetModel();
 }
 
 void ProblemReporterModel::problemsUpdated(const KDevelop::IndexedString& url)
@@ -145,6 +150,8 @@ void ProblemReporterModel::problemsUpdated(const KDevelop::IndexedString& url)
         !(showImports() && store()->documents()->imports().contains(url)))
         return;
 
+    m_updatedDocuments.insert(url);
+
     /// m_minTimer will expire in MinTimeout unless some other parsing job finishes in this period.
     m_minTimer->start();
     /// m_maxTimer will expire unconditionally in MaxTimeout
@@ -156,14 +163,22 @@ void ProblemReporterModel::problemsUpdated(const KDevelop::IndexedString& url)
 void ProblemReporterModel::rebuildProblemList()
 {
     /// No locking here, because it may be called from an already locked context
-    beginResetModel();
-
-    QVector<IProblem::Ptr> allProblems = problems(store()->documents()->get());
-
+    QSet<IndexedString> documents = store()->documents()->get();
     if (showImports())
-        allProblems += problems(store()->documents()->imports());
+        documents += store()->documents()->imports();
 
-    store()->setProblems(allProblems);
+    // the problems are set per document, so the view only sees the problems which changed
+    for (const IndexedString& document : qAsConst(m_documents)) {
+        if (!documents.contains(document)) {
+            setProblems(document, {});
+        }
+    }
+    for (const IndexedString& document : qAsConst(documents)) {
+        if (!document.isEmpty()) {
+            setProblems(document, problems({document}));
+        }
+    }
 
-    endResetModel();
+    m_documents = documents;
+    m_updatedDocuments.clear();
 }
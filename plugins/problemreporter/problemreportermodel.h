@@ -23,9 +23,12 @@
 
 #include <shell/problemmodel.h>
 
+#include <serialization/indexedstring.h>
+
+#include <QSet>
+
 namespace KDevelop
 {
-class IndexedString;
 class TopDUContext;
 }
 
@@ -68,6 +71,11 @@ private Q_SLOTS:
 private:
     void rebuildProblemList();
 
+    /// Documents whose problems are shown
+    QSet<KDevelop::IndexedString> m_documents;
+    /// Documents parsed since the last update
+    QSet<KDevelop::IndexedString> m_updatedDocuments;
+
     QTimer* m_minTimer;
     QTimer* m_maxTimer;
     const static int MinTimeout;
@@ -184,6 +184,13 @@ void ProblemTreeView::reset()
     resizeColumns();
 }
 
+void ProblemTreeView::rowsInserted(const QModelIndex& parent, int start, int end)
+{
+    // problems are inserted instead of resetting the model, so the widths are adjusted here too
+    QTreeView::rowsInserted(parent, start, end);
+    resizeColumns();
+}
+
 int ProblemTreeView::setFilter(const QString& filterText)
 {
     m_proxy->setFilterFixedString(filterText);
@@ -49,6 +49,7 @@ public:
     void dataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight,
                              const QVector<int>& roles = QVector<int>()) override;
     void reset() override;
+    void rowsInserted(const QModelIndex& parent, int start, int end) override;
 
     int setFilter(const QString& filterText);
 
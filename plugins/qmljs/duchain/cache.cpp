@@ -27,9 +27,35 @@
 #include <QString>
 #include <QProcess>
 #include <QDir>
+#include <QFileInfo>
 #include <QStandardPaths>
 #include <QCryptographicHash>
 #include <QCoreApplication>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QVector>
+
+#include <algorithm>
+
+namespace {
+
+/// Removes the dumps of the plugin of @p dumpPath made before the plugin was updated
+void removeOutdatedDumps(const QString& dumpPath)
+{
+    // "<hash of the plugin path>-<modification time of the plugin>.qml"
+    const QFileInfo dumpInfo(dumpPath);
+    const QString prefix = dumpInfo.fileName().section(QLatin1Char('-'), 0, 0) + QLatin1Char('-');
+    const QDir dumpDir = dumpInfo.dir();
+    const QStringList dumps = dumpDir.entryList({prefix + QLatin1String("*.qml")}, QDir::Files);
+
+    for (const QString& dump : dumps) {
+        if (dump != dumpInfo.fileName()) {
+            dumpDir.remove(dump);
+        }
+    }
+}
+
+}
 
 QmlJS::Cache::Cache()
 {
@@ -44,27 +70,44 @@ QmlJS::Cache::Cache()
 
 QmlJS::Cache& QmlJS::Cache::instance()
 {
-    static Cache *c = nullptr;
-
-    if (!c) {
-        c = new Cache();
-    }
+    // Never destroyed, the IndexedStrings it contains must not outlive the repositories
+    static Cache *c = new Cache();
 
     return *c;
 }
 
+QmlJS::Cache::Shard& QmlJS::Cache::shard(const KDevelop::IndexedString& file)
+{
+    return m_shards[file.index() % ShardCount];
+}
+
 QString QmlJS::Cache::modulePath(const KDevelop::IndexedString& baseFile,
                                  const QString& uri,
                                  const QString& version)
 {
-    QMutexLocker lock(&m_mutex);
     QString cacheKey = uri + version;
-    QString path = m_modulePaths.value(cacheKey, QString());
 
-    if (!path.isEmpty()) {
-        return path;
+    {
+        QReadLocker lock(&m_modulePathsLock);
+        const QString path = m_modulePaths.value(cacheKey);
+
+        if (!path.isEmpty()) {
+            return path;
+        }
     }
 
+    // Look for the module without holding the lock, this touches the file system
+    const QString path = findModulePath(baseFile, uri, version);
+
+    QWriteLocker lock(&m_modulePathsLock);
+    m_modulePaths.insert(cacheKey, path);
+    return path;
+}
+
+QString QmlJS::Cache::findModulePath(const KDevelop::IndexedString& baseFile,
+                                     const QString& uri,
+                                     const QString& version)
+{
     // List of the paths in which the modules will be looked for
     KDevelop::Path::List paths;
 
@@ -77,7 +120,11 @@ QString QmlJS::Cache::modulePath(const KDevelop::IndexedString& baseFile,
         paths << p.cd(QStringLiteral("../imports"));
     }
 
-    paths << m_includeDirs[baseFile];
+    {
+        Shard& s = shard(baseFile);
+        QReadLocker lock(&s.lock);
+        paths << s.files.value(baseFile).includeDirs;
+    }
 
     // Find the path for which <path>/u/r/i exists
     QString fragment = QString(uri).replace(QLatin1Char('.'), QDir::separator());
@@ -104,17 +151,14 @@ QString QmlJS::Cache::modulePath(const KDevelop::IndexedString& baseFile,
         //       identifier appears nowhere.
         if (isQtQuick && isVersion1) {
             if (QFile::exists(p.cd(QStringLiteral("builtins.qmltypes")).path())) {
-                path = p.path();
-                break;
+                return p.path();
             }
         } else if (QFile::exists(pathString + QLatin1String("/plugins.qmltypes"))) {
-            path = pathString;
-            break;
+            return pathString;
         }
     }
 
-    m_modulePaths.insert(cacheKey, path);
-    return path;
+    return QString();
 }
 
 QStringList QmlJS::Cache::getFileNames(const QFileInfoList& fileInfos)
@@ -140,7 +184,7 @@ QStringList QmlJS::Cache::getFileNames(const QFileInfoList& fileInfos)
 
         // Use the cache to speed-up reparses
         {
-            QMutexLocker lock(&m_mutex);
+            QReadLocker lock(&m_modulePathsLock);
 
             const auto modulePathIt = m_modulePaths.constFind(filePath);
             if (modulePathIt != m_modulePaths.constEnd()) {
@@ -154,113 +198,235 @@ QStringList QmlJS::Cache::getFileNames(const QFileInfoList& fileInfos)
             }
         }
 
-        // Locate an existing dump of the file
-        QString dumpFile = QStringLiteral("kdevqmljssupport/%1.qml").arg(
-            QString::fromLatin1(QCryptographicHash::hash(filePath.toUtf8(), QCryptographicHash::Md5).toHex())
+        // Locate an existing dump of the file, made by a previous session. The
+        // modification time of the plugin is part of the name, so that updated
+        // plugins are dumped again.
+        const QString dumpFile = QStringLiteral("kdevqmljssupport/%1-%2.qml").arg(
+            QString::fromLatin1(QCryptographicHash::hash(filePath.toUtf8(), QCryptographicHash::Md5).toHex()),
+            QString::number(fileInfo.lastModified().toMSecsSinceEpoch())
         );
         QString dumpPath = QStandardPaths::locate(QStandardPaths::GenericDataLocation,
             dumpFile
         );
 
-        if (!dumpPath.isEmpty()) {
-            QMutexLocker lock(&m_mutex);
+        if (dumpPath.isEmpty()) {
+            dumpPath = dumpPlugin(filePath, dumpFile);
+        }
 
+        if (!dumpPath.isEmpty()) {
             result.append(dumpPath);
+
+            QWriteLocker lock(&m_modulePathsLock);
             m_modulePaths.insert(filePath, dumpPath);
-            continue;
         }
+    }
 
-        // Create a dump of the file
-        const QStringList args = {QStringLiteral("-noinstantiate"), QStringLiteral("-path"), filePath};
-
-        for (const PluginDumpExecutable& executable : qAsConst(m_pluginDumpExecutables)) {
-            QProcess qmlplugindump;
-            qmlplugindump.setProcessChannelMode(QProcess::SeparateChannels);
-            qmlplugindump.start(executable.executable, args, QIODevice::ReadOnly);
-
-            qCDebug(KDEV_QMLJS_DUCHAIN) << "starting qmlplugindump with args:" << executable.executable << args << qmlplugindump.state() << fileInfo.absolutePath();
+    return result;
+}
 
-            if (!qmlplugindump.waitForFinished(3000)) {
-                if (qmlplugindump.state() == QProcess::Running) {
-                    qCWarning(KDEV_QMLJS_DUCHAIN) << "qmlplugindump didn't finish in time -- killing";
-                    qmlplugindump.kill();
-                    qmlplugindump.waitForFinished(100);
-                } else {
-                    qCDebug(KDEV_QMLJS_DUCHAIN) << "qmlplugindump attempt failed" << qmlplugindump.program() << qmlplugindump.arguments() << qmlplugindump.readAllStandardError();
-                }
-                continue;
+QString QmlJS::Cache::dumpPlugin(const QString& filePath, const QString& dumpFile)
+{
+    const QStringList args = {QStringLiteral("-noinstantiate"), QStringLiteral("-path"), filePath};
+
+    for (const PluginDumpExecutable& executable : qAsConst(m_pluginDumpExecutables)) {
+        QProcess qmlplugindump;
+        qmlplugindump.setProcessChannelMode(QProcess::SeparateChannels);
+        qmlplugindump.start(executable.executable, args, QIODevice::ReadOnly);
+
+        qCDebug(KDEV_QMLJS_DUCHAIN) << "starting qmlplugindump with args:" << executable.executable << args << qmlplugindump.state() << filePath;
+
+        if (!qmlplugindump.waitForFinished(3000)) {
+            if (qmlplugindump.state() == QProcess::Running) {
+                qCWarning(KDEV_QMLJS_DUCHAIN) << "qmlplugindump didn't finish in time -- killing";
+                qmlplugindump.kill();
+                qmlplugindump.waitForFinished(100);
+            } else {
+                qCDebug(KDEV_QMLJS_DUCHAIN) << "qmlplugindump attempt failed" << qmlplugindump.program() << qmlplugindump.arguments() << qmlplugindump.readAllStandardError();
             }
+            continue;
+        }
 
-            if (qmlplugindump.exitCode() != 0) {
-                qCWarning(KDEV_QMLJS_DUCHAIN) << "qmlplugindump finished with exit code:" << qmlplugindump.exitCode();
-                continue;
-            }
+        if (qmlplugindump.exitCode() != 0) {
+            qCWarning(KDEV_QMLJS_DUCHAIN) << "qmlplugindump finished with exit code:" << qmlplugindump.exitCode();
+            continue;
+        }
 
-            // Open a file in which the dump can be written
-            QFile dumpFile(
-                QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation)
-                + dumpPath
-            );
+        // Write the dump next to the ones of the previous sessions. Other parse
+        // jobs may look for it meanwhile, so it only appears once complete.
+        const QDir dataDir(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation));
+        const QString dumpPath = dataDir.filePath(dumpFile);
+        dataDir.mkpath(QFileInfo(dumpPath).path());
 
-            if (dumpFile.open(QIODevice::WriteOnly)) {
-                qmlplugindump.readLine();   // Skip "import QtQuick.tooling 1.1"
+        QSaveFile dump(dumpPath);
 
-                dumpFile.write("// " + filePath.toUtf8() + '\n');
-                dumpFile.write("import QtQuick " + executable.quickVersion.toUtf8() + '\n');
-                dumpFile.write(qmlplugindump.readAllStandardOutput());
-                dumpFile.close();
+        if (dump.open(QIODevice::WriteOnly)) {
+            qmlplugindump.readLine();   // Skip "import QtQuick.tooling 1.1"
 
-                result.append(dumpFile.fileName());
+            dump.write("// " + filePath.toUtf8() + '\n');
+            dump.write("import QtQuick " + executable.quickVersion.toUtf8() + '\n');
+            dump.write(qmlplugindump.readAllStandardOutput());
 
-                QMutexLocker lock(&m_mutex);
-                m_modulePaths.insert(filePath, dumpFile.fileName());
-                break;
+            if (dump.commit()) {
+                removeOutdatedDumps(dumpPath);
+                return dumpPath;
             }
         }
+
+        qCWarning(KDEV_QMLJS_DUCHAIN) << "failed to write the dump of" << filePath << "to" << dumpPath << dump.errorString();
+        break;
     }
 
-    return result;
+    return QString();
 }
 
 void QmlJS::Cache::setFileCustomIncludes(const KDevelop::IndexedString& file, const KDevelop::Path::List& dirs)
 {
-    QMutexLocker lock(&m_mutex);
+    Shard& s = shard(file);
+    QWriteLocker lock(&s.lock);
 
-    m_includeDirs[file] = dirs;
+    s.files[file].includeDirs = dirs;
 }
 
 void QmlJS::Cache::addDependency(const KDevelop::IndexedString& file, const KDevelop::IndexedString& dependency)
 {
-    QMutexLocker lock(&m_mutex);
+    {
+        Shard& s = shard(dependency);
+        QWriteLocker lock(&s.lock);
 
-    m_dependees[dependency].insert(file);
-    m_dependencies[file].insert(dependency);
+        s.files[dependency].dependees.insert(file);
+    }
+
+    Shard& s = shard(file);
+    QWriteLocker lock(&s.lock);
+
+    s.files[file].dependencies.insert(dependency);
 }
 
 QList<KDevelop::IndexedString> QmlJS::Cache::filesThatDependOn(const KDevelop::IndexedString& file)
 {
-    QMutexLocker lock(&m_mutex);
+    Shard& s = shard(file);
+    QReadLocker lock(&s.lock);
 
-    return m_dependees[file].values();
+    const auto it = s.files.constFind(file);
+    return it == s.files.constEnd() ? QList<KDevelop::IndexedString>() : it->dependees.values();
 }
 
 QList<KDevelop::IndexedString> QmlJS::Cache::dependencies(const KDevelop::IndexedString& file)
 {
-    QMutexLocker lock(&m_mutex);
+    Shard& s = shard(file);
+    QReadLocker lock(&s.lock);
 
-    return m_dependencies[file].values();
+    const auto it = s.files.constFind(file);
+    return it == s.files.constEnd() ? QList<KDevelop::IndexedString>() : it->dependencies.values();
 }
 
 bool QmlJS::Cache::isUpToDate(const KDevelop::IndexedString& file)
 {
-    QMutexLocker lock(&m_mutex);
+    Shard& s = shard(file);
+    QReadLocker lock(&s.lock);
 
-    return m_isUpToDate.value(file, false);
+    const auto it = s.files.constFind(file);
+    return it != s.files.constEnd() && it->isUpToDate;
 }
 
 void QmlJS::Cache::setUpToDate(const KDevelop::IndexedString& file, bool upToDate)
 {
-    QMutexLocker lock(&m_mutex);
+    Shard& s = shard(file);
+    QWriteLocker lock(&s.lock);
+
+    FileData& data = s.files[file];
+    data.isUpToDate = upToDate;
+    data.isInvalidated = false;
+}
+
+void QmlJS::Cache::revalidate(const KDevelop::IndexedString& file)
+{
+    Shard& s = shard(file);
+    QWriteLocker lock(&s.lock);
+
+    const auto it = s.files.find(file);
+    if (it != s.files.end() && it->isInvalidated) {
+        it->isUpToDate = true;
+        it->isInvalidated = false;
+    }
+}
+
+bool QmlJS::Cache::areDependenciesUpToDate(const KDevelop::IndexedString& file)
+{
+    // Group the dependencies by shard, so that each shard is locked once
+    const auto fileDependencies = dependencies(file);
+    QVector<KDevelop::IndexedString> dependenciesOfShard[ShardCount];
+    QVector<KDevelop::IndexedString> outdated;
+
+    for (const KDevelop::IndexedString& dependency : fileDependencies) {
+        dependenciesOfShard[dependency.index() % ShardCount].append(dependency);
+    }
+
+    for (int i = 0; i < ShardCount; ++i) {
+        if (dependenciesOfShard[i].isEmpty()) {
+            continue;
+        }
+
+        QReadLocker lock(&m_shards[i].lock);
+
+        for (const KDevelop::IndexedString& dependency : qAsConst(dependenciesOfShard[i])) {
+            const auto it = m_shards[i].files.constFind(dependency);
+
+            if (it == m_shards[i].files.constEnd() || !it->isUpToDate) {
+                outdated.append(dependency);
+            }
+        }
+    }
 
-    m_isUpToDate[file] = upToDate;
+    // Files importing each other would wait for each other forever, so the
+    // dependencies which are waiting for this file do not count
+    return std::all_of(outdated.constBegin(), outdated.constEnd(),
+                       [this, &file](const KDevelop::IndexedString& dependency) {
+        return dependsOn(dependency, file);
+    });
+}
+
+bool QmlJS::Cache::dependsOn(const KDevelop::IndexedString& file, const KDevelop::IndexedString& dependency)
+{
+    QSet<KDevelop::IndexedString> visited{file};
+    QVector<KDevelop::IndexedString> toVisit{file};
+
+    while (!toVisit.isEmpty()) {
+        const auto fileDependencies = dependencies(toVisit.takeLast());
+
+        for (const KDevelop::IndexedString& next : fileDependencies) {
+            if (next == dependency) {
+                return true;
+            }
+            if (!visited.contains(next)) {
+                visited.insert(next);
+                toVisit.append(next);
+            }
+        }
+    }
+
+    return false;
+}
+
+void QmlJS::Cache::invalidate(const QList<KDevelop::IndexedString>& files)
+{
+    QVector<KDevelop::IndexedString> filesOfShard[ShardCount];
+
+    for (const KDevelop::IndexedString& file : files) {
+        filesOfShard[file.index() % ShardCount].append(file);
+    }
+
+    for (int i = 0; i < ShardCount; ++i) {
+        if (filesOfShard[i].isEmpty()) {
+            continue;
+        }
+
+        QWriteLocker lock(&m_shards[i].lock);
+
+        for (const KDevelop::IndexedString& file : qAsConst(filesOfShard[i])) {
+            FileData& data = m_shards[i].files[file];
+            data.isInvalidated = data.isInvalidated || data.isUpToDate;
+            data.isUpToDate = false;
+        }
+    }
 }
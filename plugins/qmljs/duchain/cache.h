@@ -32,7 +32,7 @@
 #include <QFileInfoList>
 #include <QList>
 #include <QSet>
-#include <QMutex>
+#include <QReadWriteLock>
 
 class QStringList;
 
@@ -102,6 +102,33 @@ public:
     bool isUpToDate(const KDevelop::IndexedString& file);
     void setUpToDate(const KDevelop::IndexedString& file, bool upToDate);
 
+    /**
+     * Return whether all the dependencies of a file are up to date
+     *
+     * This is the same as calling isUpToDate() for each of dependencies(),
+     * but takes the lock of each shard only once. Dependencies which depend
+     * on @p file themselves, e.g. files importing each other, are not waited for.
+     */
+    bool areDependenciesUpToDate(const KDevelop::IndexedString& file);
+
+    /**
+     * Return whether @p file depends on @p dependency, directly or through
+     * other files
+     */
+    bool dependsOn(const KDevelop::IndexedString& file, const KDevelop::IndexedString& dependency);
+
+    /**
+     * Mark the given files as not being up to date, e.g. all the files that
+     * depend on a file which changed
+     */
+    void invalidate(const QList<KDevelop::IndexedString>& files);
+
+    /**
+     * Undo invalidate() for @p file, e.g. when its parse job returned without
+     * parsing it again. Files importing it would wait for it forever otherwise.
+     */
+    void revalidate(const KDevelop::IndexedString& file);
+
 private:
     struct PluginDumpExecutable {
         QString executable;
@@ -112,13 +139,37 @@ private:
         {}
     };
 
-    QMutex m_mutex;
+    struct FileData {
+        QSet<KDevelop::IndexedString> dependees;
+        QSet<KDevelop::IndexedString> dependencies;
+        KDevelop::Path::List includeDirs;
+        bool isUpToDate = false;
+        /// Whether isUpToDate was only reset by invalidate()
+        bool isInvalidated = false;
+    };
+
+    /**
+     * The data of the files is spread over several shards, each one with its
+     * own lock, so that parse jobs running in parallel rarely wait for each other
+     */
+    struct Shard {
+        QReadWriteLock lock;
+        QHash<KDevelop::IndexedString, FileData> files;
+    };
+    enum { ShardCount = 16 };
+
+    Shard& shard(const KDevelop::IndexedString& file);
+
+    QString findModulePath(const KDevelop::IndexedString& baseFile,
+                           const QString& uri,
+                           const QString& version);
+    QString dumpPlugin(const QString& filePath, const QString& dumpFile);
+
+    /// Module paths and dumps of plugins, written once and read by every parse job
+    QReadWriteLock m_modulePathsLock;
     QHash<QString, QString> m_modulePaths;
     QList<PluginDumpExecutable> m_pluginDumpExecutables;
-    QHash<KDevelop::IndexedString, QSet<KDevelop::IndexedString>> m_dependees;
-    QHash<KDevelop::IndexedString, QSet<KDevelop::IndexedString>> m_dependencies;
-    QHash<KDevelop::IndexedString, bool> m_isUpToDate;
-    QHash<KDevelop::IndexedString, KDevelop::Path::List> m_includeDirs;
+    Shard m_shards[ShardCount];
 };
 
 }
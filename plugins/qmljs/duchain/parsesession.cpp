@@ -262,6 +262,11 @@ ReferencedTopDUContext ParseSession::contextOfFile(const QString& fileName,
 void ParseSession::reparseImporters()
 {
     const auto& files = QmlJS::Cache::instance().filesThatDependOn(m_url);
+
+    // The importers are outdated until they are parsed again, files importing
+    // them must wait for that
+    QmlJS::Cache::instance().invalidate(files);
+
     for (const KDevelop::IndexedString& file : files) {
         scheduleForParsing(file, m_ownPriority);
     }
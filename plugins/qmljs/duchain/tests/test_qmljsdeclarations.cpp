@@ -287,3 +287,81 @@ void TestDeclarations::testQMLtypesImportPaths()
     path = QmlJS::Cache::instance().modulePath(stubPath, QStringLiteral("QtMultimedia"), QStringLiteral("5.6"));
     QVERIFY(QFileInfo::exists(path + "/plugins.qmltypes"));
 }
+
+void TestDeclarations::testCacheDependencies()
+{
+    auto& cache = QmlJS::Cache::instance();
+    const IndexedString importer(QUrl(QStringLiteral("file:///internal/importer.qml")));
+    const IndexedString importerOfImporter(QUrl(QStringLiteral("file:///internal/importerofimporter.qml")));
+    QVector<IndexedString> modules;
+    for (int i = 0; i < 40; ++i) {
+        modules << IndexedString(QUrl(QStringLiteral("file:///internal/module%1.qml").arg(i)));
+        cache.addDependency(importer, modules.last());
+    }
+    cache.addDependency(importerOfImporter, importer);
+
+    QCOMPARE(cache.dependencies(importer).size(), modules.size());
+    QCOMPARE(cache.filesThatDependOn(modules.first()), QList<IndexedString>{importer});
+    QVERIFY(!cache.areDependenciesUpToDate(importer));
+
+    for (const auto& module : qAsConst(modules)) {
+        cache.setUpToDate(module, true);
+    }
+    QVERIFY(cache.areDependenciesUpToDate(importer));
+
+    cache.setUpToDate(modules.last(), false);
+    QVERIFY(!cache.areDependenciesUpToDate(importer));
+    cache.setUpToDate(modules.last(), true);
+
+    cache.setUpToDate(importer, true);
+    QVERIFY(cache.areDependenciesUpToDate(importerOfImporter));
+    cache.invalidate(cache.filesThatDependOn(modules.first()));
+    QVERIFY(!cache.isUpToDate(importer));
+    QVERIFY(!cache.areDependenciesUpToDate(importerOfImporter));
+    QVERIFY(cache.areDependenciesUpToDate(importer));
+
+    // A job returning without parsing the importer doesn't leave it outdated
+    cache.revalidate(importer);
+    QVERIFY(cache.isUpToDate(importer));
+    QVERIFY(cache.areDependenciesUpToDate(importerOfImporter));
+
+    // Only the invalidation is undone
+    cache.setUpToDate(importer, false);
+    cache.revalidate(importer);
+    QVERIFY(!cache.isUpToDate(importer));
+}
+
+void TestDeclarations::testCacheDependencyCycle()
+{
+    auto& cache = QmlJS::Cache::instance();
+    const IndexedString builtin(QUrl(QStringLiteral("file:///internal/cycle/__builtin_qml.qml")));
+    const IndexedString first(QUrl(QStringLiteral("file:///internal/cycle/First.qml")));
+    const IndexedString second(QUrl(QStringLiteral("file:///internal/cycle/Second.qml")));
+    const IndexedString importer(QUrl(QStringLiteral("file:///internal/cycle/Importer.qml")));
+
+    // both files import "." and the builtins
+    cache.addDependency(first, builtin);
+    cache.addDependency(second, builtin);
+    cache.addDependency(first, second);
+    cache.addDependency(second, first);
+    cache.addDependency(importer, first);
+    for (const auto& file : {builtin, first, second, importer}) {
+        cache.setUpToDate(file, true);
+    }
+    QVERIFY(cache.dependsOn(first, second));
+    QVERIFY(cache.dependsOn(importer, second));
+    QVERIFY(!cache.dependsOn(first, importer));
+
+    // the builtins changed, its importers must not wait for each other
+    cache.invalidate(cache.filesThatDependOn(builtin));
+    QVERIFY(!cache.isUpToDate(first));
+    QVERIFY(!cache.isUpToDate(second));
+    QVERIFY(cache.areDependenciesUpToDate(first));
+    QVERIFY(cache.areDependenciesUpToDate(second));
+    // files outside of the cycle still wait
+    QVERIFY(!cache.areDependenciesUpToDate(importer));
+
+    cache.setUpToDate(first, true);
+    QVERIFY(cache.areDependenciesUpToDate(second));
+    QVERIFY(cache.areDependenciesUpToDate(importer));
+}
@@ -38,6 +38,9 @@ private Q_SLOTS:
     void testProperty();
 
     void testQMLtypesImportPaths();
+
+    void testCacheDependencies();
+    void testCacheDependencyCycle();
 };
 
 #endif // TESTCONTEXTS_H
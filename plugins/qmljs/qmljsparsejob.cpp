@@ -43,6 +43,38 @@
 
 using namespace KDevelop;
 
+namespace {
+
+/// Undoes the invalidation of a document whose job returns without parsing it,
+/// files importing the document would wait for it forever otherwise
+class RevalidateOnReturn
+{
+public:
+    explicit RevalidateOnReturn(const IndexedString& document)
+        : m_document(document)
+    {
+    }
+
+    ~RevalidateOnReturn()
+    {
+        if (!m_dismissed) {
+            QmlJS::Cache::instance().revalidate(m_document);
+        }
+    }
+
+    /// The job decided whether the document is up to date
+    void dismiss()
+    {
+        m_dismissed = true;
+    }
+
+private:
+    const IndexedString m_document;
+    bool m_dismissed = false;
+};
+
+}
+
 /*
  * This function has been copied from kdev-clang
  *
@@ -103,17 +135,16 @@ void QmlJsParseJob::run(ThreadWeaver::JobPointer pointer, ThreadWeaver::Thread*
     Q_UNUSED(thread)
 
     UrlParseLock urlLock(document());
+    RevalidateOnReturn revalidate(document());
     if (abortRequested() || !isUpdateRequired(ParseSession::languageString())) {
         return;
     }
 
     // Don't parse this file if one of its dependencies is not up to date
-    const auto& dependencies = QmlJS::Cache::instance().dependencies(document());
-    for (auto& dependency : dependencies) {
-        if (!QmlJS::Cache::instance().isUpToDate(dependency)) {
-            QmlJS::Cache::instance().setUpToDate(document(), false);
-            return;
-        }
+    if (!QmlJS::Cache::instance().areDependenciesUpToDate(document())) {
+        revalidate.dismiss();
+        QmlJS::Cache::instance().setUpToDate(document(), false);
+        return;
     }
 
     qCDebug(KDEV_QMLJS) << "parsing" << document().str();
@@ -180,6 +211,7 @@ void QmlJsParseJob::run(ThreadWeaver::JobPointer pointer, ThreadWeaver::Thread*
     // If the file has become up to date, reparse its importers
     bool dependenciesOk = session.allDependenciesSatisfied();
 
+    revalidate.dismiss();
     QmlJS::Cache::instance().setUpToDate(document(), dependenciesOk);
 
     if (dependenciesOk) {
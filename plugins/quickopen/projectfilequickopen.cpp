@@ -234,10 +234,9 @@ ProjectFileDataProvider::ProjectFileDataProvider()
 
 void ProjectFileDataProvider::projectClosing(IProject* project)
 {
-    const auto files = KDevelop::allFiles(project->projectItem());
-    for (ProjectFileItem* file : files) {
+    KDevelop::forEachFile(project->projectItem(), [this](ProjectFileItem* file) {
         fileRemovedFromSet(file);
-    }
+    });
 }
 
 void ProjectFileDataProvider::projectOpened(IProject* project)